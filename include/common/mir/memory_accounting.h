@@ -0,0 +1,170 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIR_MEMORY_ACCOUNTING_H_
+#define MIR_MEMORY_ACCOUNTING_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <sys/types.h>
+
+namespace mir
+{
+namespace memory
+{
+/// What the server is spending memory on
+enum class Category
+{
+    shm_pool,           ///< Client wl_shm pools mapped into the server
+    shm_texture,        ///< GL textures uploaded from shm buffers
+    software_buffer,    ///< CPU buffers the server draws into (decorations, screenshots, ...)
+    cursor_image,       ///< Cursor images scaled for display
+};
+
+std::size_t constexpr category_count{4};
+
+auto name_of(Category category) -> char const*;
+
+/**
+ * The process memory is attributed to; no_client for memory the server spends on itself
+ *
+ * Clients are identified by pid, so every client of a proxy process shares one account: all
+ * X11 apps are charged to Xwayland. Refusing Xwayland would disconnect every X11 app with it,
+ * so the server exempts it from refusal; see Ledger::exempt_from_refusal().
+ */
+using ClientId = pid_t;
+ClientId constexpr no_client{0};
+
+/// Bytes currently allocated, by category
+struct Usage
+{
+    std::array<std::size_t, category_count> bytes{};
+
+    auto operator[](Category category) const -> std::size_t
+    {
+        return bytes[static_cast<std::size_t>(category)];
+    }
+
+    auto total() const -> std::size_t;
+};
+
+/// What happens when a client tries to allocate beyond its budget
+enum class BudgetAction
+{
+    warn,       ///< Allow the allocation, but notify the over-budget handler
+    refuse,     ///< Notify the over-budget handler and refuse the allocation
+};
+
+/**
+ * Counts the bytes allocated by the server, per Category and per client.
+ *
+ * Allocation sites record what they allocate and release; most do so through an Allocation.
+ * Recording memory the server spends on itself is lock-free; per-client records take a lock,
+ * so should be kept to coarse allocations (pools, not individual buffers).
+ */
+class Ledger
+{
+public:
+    using OverBudgetHandler =
+        std::function<void(ClientId client, std::size_t usage, std::size_t budget, bool refused)>;
+
+    Ledger() = default;
+
+    void allocated(Category category, ClientId client, std::size_t bytes);
+    void released(Category category, ClientId client, std::size_t bytes);
+
+    /**
+     * Limit the bytes attributed to any one client.
+     *
+     * The budget applies per ClientId, that is per process; see ClientId.
+     *
+     * \param budget        The limit, in bytes; 0 for no limit
+     * \param action        Whether admit() refuses allocations beyond \p budget
+     * \param over_budget   Called (on the thread calling admit()) for each allocation beyond \p budget,
+     *                      with whether it was refused
+     */
+    void set_client_budget(std::size_t budget, BudgetAction action, OverBudgetHandler over_budget);
+
+    /**
+     * Admit \p client's allocations beyond its budget even if the BudgetAction is refuse.
+     *
+     * They are still reported to the over-budget handler. For proxies such as Xwayland, where
+     * refusing one client would disconnect all those behind it.
+     */
+    void exempt_from_refusal(ClientId client);
+    void end_exemption_from_refusal(ClientId client);
+
+    /**
+     * Check whether \p client may allocate another \p bytes.
+     *
+     * \return  false if this would take \p client over its budget, the BudgetAction is refuse
+     *          and \p client is not exempt from refusal
+     */
+    auto admit(ClientId client, std::size_t bytes) -> bool;
+
+    auto usage() const -> Usage;
+    auto usage_of(ClientId client) const -> Usage;
+    auto usage_by_client() const -> std::map<ClientId, Usage>;
+
+private:
+    Ledger(Ledger const&) = delete;
+    Ledger& operator=(Ledger const&) = delete;
+
+    std::array<std::atomic<std::size_t>, category_count> totals{};
+
+    std::mutex mutable mutex;
+    std::unordered_map<ClientId, Usage> clients;
+    std::unordered_set<ClientId> exempt_clients;
+    std::size_t budget{0};
+    BudgetAction action{BudgetAction::warn};
+    OverBudgetHandler over_budget;
+};
+
+/// The process's Ledger
+auto ledger() -> Ledger&;
+
+/// Records bytes in the process's Ledger for as long as it lives
+class Allocation
+{
+public:
+    Allocation(Category category, ClientId client, std::size_t bytes);
+    ~Allocation();
+
+    Allocation(Allocation&& from) noexcept;
+    auto operator=(Allocation&& from) noexcept -> Allocation&;
+
+    /// Change the bytes recorded to \p bytes
+    void reset(std::size_t bytes);
+
+    auto bytes() const -> std::size_t { return bytes_; }
+
+private:
+    Category category;
+    ClientId client;
+    std::size_t bytes_;
+};
+}
+}
+
+#endif // MIR_MEMORY_ACCOUNTING_H_
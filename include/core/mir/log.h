@@ -36,9 +36,15 @@ void log(logging::Severity sev, char const* component, char const* fmt, ...);
 void log(logging::Severity sev, char const* component, std::string const& message);
 void log(logging::Severity sev, char const* component, std::exception_ptr const& exception, std::string const& message);
 
+/// Formats the message only if it will be logged
 template<typename... Args>
 void log(logging::Severity severity, logging::Tags tags, std::format_string<Args...> fmt, Args&&... args)
-{ log(severity, tags, std::format(fmt, std::forward<Args>(args)...)); }
+{
+    if (logging::logging_enabled_for(tags, severity))
+    {
+        log(severity, tags, std::format(fmt, std::forward<Args>(args)...));
+    }
+}
 
 void log(logging::Severity sev, logging::Tags tags, std::string_view message);
 
@@ -64,35 +70,50 @@ namespace
 // defined in the same namespace as the conditionally-available ones below.
 
 inline void log_debug(logging::Tags tags, std::string_view message)
-{ mir::log(logging::Severity::debug, tags, message); }
+{
+    if (logging::logging_enabled_for(tags, logging::Severity::debug))
+        mir::log(logging::Severity::debug, tags, message);
+}
 
 template<typename... Args>
 void log_debug(logging::Tags tags, std::format_string<Args...> fmt, Args&&... args)
-{ log_debug(tags, std::format(fmt, std::forward<Args>(args)...)); }
+{ log(logging::Severity::debug, tags, fmt, std::forward<Args>(args)...); }
 
 inline void log_info(logging::Tags tags, std::string_view message)
-{ mir::log(logging::Severity::informational, tags, message); }
+{
+    if (logging::logging_enabled_for(tags, logging::Severity::informational))
+        mir::log(logging::Severity::informational, tags, message);
+}
 
 template<typename... Args>
 void log_info(logging::Tags tags, std::format_string<Args...> fmt, Args&&... args)
-{ log_info(tags, std::format(fmt, std::forward<Args>(args)...)); }
+{ log(logging::Severity::informational, tags, fmt, std::forward<Args>(args)...); }
 
 inline void log_warning(logging::Tags tags, std::string_view message)
-{ mir::log(logging::Severity::warning, tags, message); }
+{
+    if (logging::logging_enabled_for(tags, logging::Severity::warning))
+        mir::log(logging::Severity::warning, tags, message);
+}
 
 template<typename... Args>
 void log_warning(logging::Tags tags, std::format_string<Args...> fmt, Args&&... args)
 { log(logging::Severity::warning, tags, fmt, std::forward<Args>(args)...); }
 
 inline void log_error(logging::Tags tags, std::string_view message)
-{ mir::log(logging::Severity::error, tags, message); }
+{
+    if (logging::logging_enabled_for(tags, logging::Severity::error))
+        mir::log(logging::Severity::error, tags, message);
+}
 
 template<typename... Args>
 void log_error(logging::Tags tags, std::format_string<Args...> fmt, Args&&... args)
 { log(logging::Severity::error, tags, fmt, std::forward<Args>(args)...); }
 
 inline void log_critical(logging::Tags tags, std::string_view message)
-{ mir::log(logging::Severity::critical, tags, message); }
+{
+    if (logging::logging_enabled_for(tags, logging::Severity::critical))
+        mir::log(logging::Severity::critical, tags, message);
+}
 
 template<typename... Args>
 void log_critical(logging::Tags tags, std::format_string<Args...> fmt, Args&&... args)
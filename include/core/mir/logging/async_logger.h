@@ -0,0 +1,60 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_LOGGING_ASYNC_LOGGER_H_
+#define MIR_LOGGING_ASYNC_LOGGER_H_
+
+#include <mir/logging/logger.h>
+
+#include <chrono>
+#include <memory>
+
+namespace mir
+{
+namespace logging
+{
+/// Takes writing log messages off the threads that log them
+///
+/// Each logging thread queues its messages, without locking, on a ring buffer of its own. A background thread
+/// writes them to the target logger in timestamp order, flushing once per batch rather than once per message.
+/// Critical messages, and everything queued before them, have been written by the time log() returns.
+class AsyncLogger : public Logger
+{
+public:
+    explicit AsyncLogger(std::shared_ptr<Logger> const& target);
+    ~AsyncLogger() override;
+
+    /// Waits, for at most \p timeout, until every message queued so far has been written
+    ///
+    /// \return whether they have all been written
+    auto flush(std::chrono::milliseconds timeout = std::chrono::seconds{1}) -> bool;
+
+    /// Flushes every AsyncLogger, without blocking if another thread is part way through logging
+    ///
+    /// For use on the way to abort(); see mir::fatal_error()
+    static void flush_all();
+
+protected:
+    void log(Severity severity, std::string const& message, std::string const& component) override;
+
+private:
+    struct Self;
+    std::shared_ptr<Self> const self;
+};
+}
+}
+
+#endif // MIR_LOGGING_ASYNC_LOGGER_H_
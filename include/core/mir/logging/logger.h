@@ -56,7 +56,12 @@ public:
 
     template<typename... Args>
     void log(Severity severity, Tags tags, std::format_string<Args...> fmt, Args&&... args)
-    { log(severity, tags, std::format(fmt, std::forward<Args>(args)...)); }
+    {
+        if (logging_enabled_for(tags, severity))
+        {
+            log(severity, tags, std::format(fmt, std::forward<Args>(args)...));
+        }
+    }
 
 protected:
 
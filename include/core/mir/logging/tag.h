@@ -17,9 +17,12 @@
 #ifndef MIR_LOGGING_TAG_H_
 #define MIR_LOGGING_TAG_H_
 
+#include <atomic>
+#include <cstdint>
 #include <format>
 #include <functional>
 #include <initializer_list>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -61,10 +64,66 @@ enum class Severity
     debug = 4
 };
 
+/// A logging tag; these are only created by create_tag()
+struct Tag
+{
+    std::string const name;
+    std::atomic<Severity> logging_severity;
+    Tag const* parent;
+    /// This tag's bit in detail::enabled_tags
+    std::uint64_t const bit;
+};
+
+namespace detail
+{
+/// Bit n of `enabled_tags[severity]` is set while the nth tag created logs messages of that severity
+///
+/// Kept up to date by create_tag() and tag::set_severity(), so that checking whether to log costs a relaxed load
+/// rather than a walk over the tags. There are more tags than bits only in unusual cases (such as tests), so tags
+/// after the 63rd share `shared_bit`, and need checking individually when it is set.
+extern std::atomic<std::uint64_t> enabled_tags[5];
+std::uint64_t constexpr shared_bit = std::uint64_t{1} << 63;
+}
+
 auto parse_severity(std::string_view severity_name) -> Severity;
 
 auto logging_enabled_for(Tag const& tag, Severity sev) -> bool;
 
+/// Whether a message with \p tags and severity \p sev would be logged
+///
+/// Check this before formatting a message: if no tag is enabled at \p sev (the usual case for debug messages)
+/// this is a single relaxed load.
+inline auto logging_enabled_for(Tags tags, Severity sev) -> bool
+{
+    auto const enabled = detail::enabled_tags[static_cast<int>(sev)].load(std::memory_order_relaxed);
+    if (!enabled)
+    {
+        return false;
+    }
+
+    std::uint64_t requested{0};
+    for (Tag const& tag : tags)
+    {
+        requested |= tag.bit;
+    }
+
+    auto const matched = enabled & requested;
+    if (matched != detail::shared_bit)
+    {
+        return matched;
+    }
+
+    // Some tag sharing the last bit is enabled, but not necessarily one of ours
+    for (Tag const& tag : tags)
+    {
+        if (logging_enabled_for(tag, sev))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 auto list_known_tags() -> std::vector<std::string>;
 
 namespace tag
@@ -413,6 +413,17 @@ enum MirTiledEdge
     mir_tiled_edge_west = 1 << 3
 };
 
+/**
+ * Hints describing the kind of content a surface shows.
+ */
+enum MirContentType
+{
+    mir_content_type_none,  /**< No particular kind of content */
+    mir_content_type_photo, /**< Still images, which change rarely */
+    mir_content_type_video, /**< Video, which should be shown smoothly at its own frame rate */
+    mir_content_type_game,  /**< An interactive game, which should be shown with minimal latency */
+};
+
 /**
  * Filters that can be applied to output.
  **/
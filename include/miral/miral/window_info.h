@@ -381,6 +381,16 @@ struct WindowInfo
     /// \remark Since MirAL 5.7
     auto alpha() const -> float;
 
+    /// The kind of content the client says the window shows.
+    ///
+    /// Set by clients using wp_content_type_v1. Policies may use this, for
+    /// example, to place video windows on outputs that can show them smoothly.
+    ///
+    /// \returns the content type
+    /// \remark Since MirAL 6.0
+    /// \sa MirContentType - the content type options
+    auto content_type() const -> MirContentType;
+
 private:
     friend class BasicWindowManager;
     void name(std::string const& name);
@@ -133,6 +133,27 @@ public:
      */
     virtual void configure(DisplayConfiguration const& conf) = 0;
 
+    /**
+     * Sets a new output configuration, invalidating only the DisplaySyncGroups it has to.
+     *
+     * \p removing is called with each DisplaySyncGroup that is to be invalidated, before
+     * the change is made. References to DisplaySyncGroups that are not passed to \p removing
+     * (and to their DisplaySinks) remain valid; DisplaySyncGroups that are new afterwards can
+     * be found with for_each_display_sync_group().
+     *
+     * The default implementation invalidates every DisplaySyncGroup, as configure() may.
+     *
+     * \param conf     [in] Configuration to apply.
+     * \param removing [in] Called with each DisplaySyncGroup that is about to be invalidated.
+     */
+    virtual void configure_incrementally(
+        DisplayConfiguration const& conf,
+        std::function<void(DisplaySyncGroup&)> const& removing)
+    {
+        for_each_display_sync_group(removing);
+        configure(conf);
+    }
+
     /**
      * Registers a handler for display configuration changes.
      *
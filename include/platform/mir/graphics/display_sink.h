@@ -47,6 +47,10 @@ struct DisplayElement
      */
     geometry::RectangleF source_position;
     std::shared_ptr<Framebuffer> buffer;
+    /// The client prefers this element be shown as soon as possible, even if that tears
+    ///
+    /// A DisplaySink may then present it without waiting for vblank, if it can scan it out directly.
+    bool allow_tearing{false};
 };
 /**
  * Interface to an output sink.
@@ -43,6 +43,13 @@ private:
     EGLSurface draw_surf;
     EGLSurface read_surf;
 };
+
+/**
+ * Create a GLES2 context without an EGLConfig and make it current
+ *
+ * \throws std::runtime_error if EGL_KHR_no_config_context is unavailable
+ */
+auto create_current_context(EGLDisplay dpy, EGLContext share_ctx) -> EGLContext;
 }
 
 #endif // MIR_PLATFORMS_COMMON_EGL_HELPERS_H_
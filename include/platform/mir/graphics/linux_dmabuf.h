@@ -45,6 +45,18 @@ class DmaBufFormatDescriptors;
 class DMABufBuffer;
 class EGLBufferCopier;
 
+/**
+ * Import a DMA-BUF into EGL
+ *
+ * \return  An EGLImageKHR handle to the imported buffer; the caller is responsible
+ *          for destroying it.
+ * \throws  A std::system_error containing the EGL error on failure.
+ */
+auto import_egl_image(
+    EGLDisplay dpy,
+    EGLExtensions const& egl_extensions,
+    DMABufBuffer const& dma_buf) -> EGLImageKHR;
+
 class DMABufEGLProvider : public std::enable_shared_from_this<DMABufEGLProvider>
 {
 public:
@@ -462,6 +462,25 @@ public:
     virtual auto framebuffer_for(std::shared_ptr<DMABufBuffer> buffer) -> std::unique_ptr<Framebuffer> = 0;
 };
 
+/**
+ * Allocator for sinks that render directly into externally-supplied DMA-BUFs
+ *
+ * This is used for screen capture into client GPU buffers, where the rendered
+ * output never needs to pass through CPU-accessible memory.
+ */
+class DmaBufTargetDisplayAllocator : public DisplayAllocator
+{
+public:
+    class Tag : public DisplayAllocator::Tag
+    {
+    };
+
+    /// The buffer the next frame should be rendered into
+    virtual auto current_target() const -> std::shared_ptr<DMABufBuffer> = 0;
+
+    virtual auto output_size() const -> geometry::Size = 0;
+};
+
 class GenericEGLDisplayProvider : public DisplayProvider
 {
 public:
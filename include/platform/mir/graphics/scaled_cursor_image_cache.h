@@ -0,0 +1,68 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_SCALED_CURSOR_IMAGE_CACHE_H_
+#define MIR_GRAPHICS_SCALED_CURSOR_IMAGE_CACHE_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mir
+{
+namespace graphics
+{
+class CursorImage;
+namespace common
+{
+class MemoryBackedShmBuffer;
+}
+
+/// Keeps the scaled buffers of recently shown cursor images.
+///
+/// Themed cursors (from the cursor theme, or a wp_cursor_shape_v1 shape) are the same CursorImage each time they are
+/// shown, so moving the pointer between windows switches between a handful of images. Keeping their scaled buffers
+/// means switching back to one does not rescale it, and as the buffer is the same its texture need not be uploaded
+/// again either.
+///
+/// Entries are keyed on the identity of the CursorImage and do not keep it alive. Not thread safe.
+class ScaledCursorImageCache
+{
+public:
+    explicit ScaledCursorImageCache(size_t capacity = 16);
+
+    /// The buffer holding \a image scaled by \a scale, creating it if it is not cached
+    auto buffer_for(std::shared_ptr<CursorImage> const& image, float scale)
+        -> std::shared_ptr<common::MemoryBackedShmBuffer>;
+
+    /// Drop all entries, e.g. when the scale changes
+    void clear();
+
+private:
+    struct Entry
+    {
+        std::weak_ptr<CursorImage> image;
+        float scale;
+        std::shared_ptr<common::MemoryBackedShmBuffer> buffer;
+    };
+
+    size_t const capacity;
+    std::vector<Entry> entries; ///< Least recently used first
+};
+}
+}
+
+#endif // MIR_GRAPHICS_SCALED_CURSOR_IMAGE_CACHE_H_
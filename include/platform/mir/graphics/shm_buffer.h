@@ -17,6 +17,7 @@
 #ifndef MIR_GRAPHICS_GBM_SHM_BUFFER_H_
 #define MIR_GRAPHICS_GBM_SHM_BUFFER_H_
 
+#include <mir/memory_accounting.h>
 #include <mir/synchronised.h>
 #include <mir/graphics/buffer_basic.h>
 #include <mir/geometry/dimensions.h>
@@ -73,6 +74,8 @@ class MemoryBackedShmBuffer : public ShmBuffer, public renderer::software::RWMap
 {
 public:
     MemoryBackedShmBuffer(geometry::Size const& size, MirPixelFormat const& pixel_format);
+    /// \param category    What the buffer is accounted as in memory::ledger()
+    MemoryBackedShmBuffer(geometry::Size const& size, MirPixelFormat const& pixel_format, memory::Category category);
 
     auto map_readable() const -> std::unique_ptr<renderer::software::Mapping<std::byte const>> override;
 
@@ -99,6 +102,7 @@ private:
 
     geometry::Stride const stride_;
     std::unique_ptr<std::byte[]> const pixels;
+    memory::Allocation const accounted;
 };
 
 class MappableBackedShmBuffer : public ShmBuffer, public renderer::software::RWMappable
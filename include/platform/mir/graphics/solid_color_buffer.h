@@ -0,0 +1,68 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_SOLID_COLOR_BUFFER_H_
+#define MIR_GRAPHICS_SOLID_COLOR_BUFFER_H_
+
+#include <mir/graphics/buffer_basic.h>
+#include <mir/graphics/texture.h>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace mir
+{
+namespace graphics
+{
+/// A buffer of a single colour, with no backing storage.
+///
+/// The buffer is 1x1; submit it to a stream at whatever destination size the colour should fill. The GL renderer
+/// draws it as a flat-shaded quad: nothing is allocated or uploaded to the GPU, and as it is a gl::Texture any
+/// GLRenderingProvider::as_texture() accepts it without platform support.
+class SolidColorBuffer : public BufferBasic, public NativeBufferBase, public gl::Texture
+{
+public:
+    /// \param color    Premultiplied RGBA, each component in [0, 1]
+    explicit SolidColorBuffer(glm::vec4 color);
+
+    auto color() const -> glm::vec4;
+
+    /// Overrides from Buffer
+    /// @{
+    auto size() const -> geometry::Size override;
+    auto pixel_format() const -> MirPixelFormat override;
+    auto native_buffer_base() -> NativeBufferBase* override;
+    auto map_readable() const -> std::unique_ptr<renderer::software::Mapping<std::byte const>> override;
+    /// @}
+
+    /// Overrides from gl::Texture
+    /// @{
+    auto shader(gl::ProgramFactory& factory) const -> gl::Program const& override;
+    auto layout() const -> Layout override;
+    void bind() override;
+    auto tex_id() const -> GLuint override;
+    void add_syncpoint() override;
+    /// @}
+
+private:
+    glm::vec4 const color_;
+    uint32_t const pixel; ///< color_ as a single mir_pixel_format_argb_8888 pixel, for CPU access
+};
+}
+}
+
+#endif // MIR_GRAPHICS_SOLID_COLOR_BUFFER_H_
@@ -36,6 +36,10 @@ extern char const* const display_report_opt;
 extern char const* const scene_report_opt;
 extern char const* const input_report_opt;
 extern char const* const seat_report_opt;
+extern char const* const startup_report_opt;
+extern char const* const memory_report_opt;
+extern char const* const client_memory_budget_opt;
+extern char const* const client_memory_budget_action_opt;
 extern char const* const touchspots_opt;
 extern char const* const cursor_opt;
 extern char const* const debug_opt;
@@ -58,6 +62,7 @@ extern char const* const platform_display_libs;
 extern char const* const platform_rendering_libs;
 extern char const* const platform_input_lib;
 extern char const* const platform_path;
+extern char const* const platform_probe_cache_opt;
 
 extern char const* const console_provider;
 extern char const* const logind_console;
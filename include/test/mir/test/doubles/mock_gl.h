@@ -89,6 +89,7 @@ public:
     MOCK_METHOD(void, glTexParameteri, (GLenum, GLenum, GLenum));
     MOCK_METHOD(void, glUniform1f, (GLint, GLfloat));
     MOCK_METHOD(void, glUniform2f, (GLint, GLfloat, GLfloat));
+    MOCK_METHOD(void, glUniform4fv, (GLint, GLsizei, GLfloat const*));
     MOCK_METHOD(void, glUniform1i, (GLint, GLint));
     MOCK_METHOD(void, glUniformMatrix4fv, (GLuint, GLsizei, GLboolean, GLfloat const*));
     MOCK_METHOD(void, glUseProgram, (GLuint));
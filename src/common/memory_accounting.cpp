@@ -0,0 +1,214 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <mir/memory_accounting.h>
+
+#include <utility>
+
+namespace mm = mir::memory;
+
+auto mm::name_of(Category category) -> char const*
+{
+    switch (category)
+    {
+    case Category::shm_pool:
+        return "shm pools";
+    case Category::shm_texture:
+        return "shm textures";
+    case Category::software_buffer:
+        return "software buffers";
+    case Category::cursor_image:
+        return "cursor images";
+    }
+    return "unknown";
+}
+
+auto mm::Usage::total() const -> std::size_t
+{
+    std::size_t result{0};
+    for (auto const category_bytes : bytes)
+    {
+        result += category_bytes;
+    }
+    return result;
+}
+
+void mm::Ledger::allocated(Category category, ClientId client, std::size_t bytes)
+{
+    auto const index = static_cast<std::size_t>(category);
+    totals[index].fetch_add(bytes, std::memory_order_relaxed);
+
+    if (client != no_client)
+    {
+        std::lock_guard lock{mutex};
+        clients[client].bytes[index] += bytes;
+    }
+}
+
+void mm::Ledger::released(Category category, ClientId client, std::size_t bytes)
+{
+    auto const index = static_cast<std::size_t>(category);
+    totals[index].fetch_sub(bytes, std::memory_order_relaxed);
+
+    if (client != no_client)
+    {
+        std::lock_guard lock{mutex};
+        if (auto const found = clients.find(client); found != clients.end())
+        {
+            found->second.bytes[index] -= bytes;
+            if (found->second.total() == 0)
+            {
+                clients.erase(found);
+            }
+        }
+    }
+}
+
+void mm::Ledger::set_client_budget(std::size_t budget, BudgetAction action, OverBudgetHandler over_budget)
+{
+    std::lock_guard lock{mutex};
+    this->budget = budget;
+    this->action = action;
+    this->over_budget = std::move(over_budget);
+}
+
+void mm::Ledger::exempt_from_refusal(ClientId client)
+{
+    std::lock_guard lock{mutex};
+    exempt_clients.insert(client);
+}
+
+void mm::Ledger::end_exemption_from_refusal(ClientId client)
+{
+    std::lock_guard lock{mutex};
+    exempt_clients.erase(client);
+}
+
+auto mm::Ledger::admit(ClientId client, std::size_t bytes) -> bool
+{
+    OverBudgetHandler handler;
+    std::size_t usage, limit;
+    bool permitted;
+    {
+        std::lock_guard lock{mutex};
+        if (budget == 0 || client == no_client)
+        {
+            return true;
+        }
+
+        auto const found = clients.find(client);
+        usage = (found != clients.end() ? found->second.total() : 0) + bytes;
+        if (usage <= budget)
+        {
+            return true;
+        }
+
+        handler = over_budget;
+        limit = budget;
+        permitted = action == BudgetAction::warn || exempt_clients.contains(client);
+    }
+
+    // Not under the lock, so that the handler is free to inspect the ledger
+    if (handler)
+    {
+        handler(client, usage, limit, !permitted);
+    }
+    return permitted;
+}
+
+auto mm::Ledger::usage() const -> Usage
+{
+    Usage result;
+    for (std::size_t i = 0; i != category_count; ++i)
+    {
+        result.bytes[i] = totals[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+auto mm::Ledger::usage_of(ClientId client) const -> Usage
+{
+    std::lock_guard lock{mutex};
+    if (auto const found = clients.find(client); found != clients.end())
+    {
+        return found->second;
+    }
+    return {};
+}
+
+auto mm::Ledger::usage_by_client() const -> std::map<ClientId, Usage>
+{
+    std::lock_guard lock{mutex};
+    return {clients.begin(), clients.end()};
+}
+
+auto mm::ledger() -> Ledger&
+{
+    static Ledger the_ledger;
+    return the_ledger;
+}
+
+mm::Allocation::Allocation(Category category, ClientId client, std::size_t bytes)
+    : category{category},
+      client{client},
+      bytes_{bytes}
+{
+    ledger().allocated(category, client, bytes);
+}
+
+mm::Allocation::~Allocation()
+{
+    if (bytes_)
+    {
+        ledger().released(category, client, bytes_);
+    }
+}
+
+mm::Allocation::Allocation(Allocation&& from) noexcept
+    : category{from.category},
+      client{from.client},
+      bytes_{std::exchange(from.bytes_, 0)}
+{
+}
+
+auto mm::Allocation::operator=(Allocation&& from) noexcept -> Allocation&
+{
+    if (this != &from)
+    {
+        if (bytes_)
+        {
+            ledger().released(category, client, bytes_);
+        }
+        category = from.category;
+        client = from.client;
+        bytes_ = std::exchange(from.bytes_, 0);
+    }
+    return *this;
+}
+
+void mm::Allocation::reset(std::size_t bytes)
+{
+    if (bytes > bytes_)
+    {
+        ledger().allocated(category, client, bytes - bytes_);
+    }
+    else if (bytes < bytes_)
+    {
+        ledger().released(category, client, bytes_ - bytes);
+    }
+    bytes_ = bytes;
+}
@@ -15,6 +15,7 @@
  */
 
 #include <mir/fatal.h>
+#include <mir/logging/async_logger.h>
 
 #include <cstdlib>
 #include <cstdio>
@@ -34,6 +35,7 @@ void mir::fatal_error(char const* reason, ...) noexcept
     std::fprintf(stderr, "\n");
     va_end(args);
 
+    mir::logging::AsyncLogger::flush_all();
     std::abort();
 }
 
@@ -46,6 +48,8 @@ void mir::fatal_error(std::source_location const loc, std::string_view message)
         static_cast<int>(message.size()), message.data(),
         loc.file_name(), loc.line(), loc.function_name());
 
+    // Whatever was logged on the way here is likely to explain what went wrong
+    mir::logging::AsyncLogger::flush_all();
     std::abort();
 }
 
@@ -0,0 +1,384 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mir/logging/async_logger.h>
+#include "message_batch.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+namespace ml = mir::logging;
+
+namespace
+{
+struct Record
+{
+    ml::Severity severity;
+    std::string message;
+    std::string component;
+    /// When the message was logged, for ordering it among other threads' messages; unlike the wall clock, this
+    /// can't be stepped backwards between two messages
+    std::chrono::steady_clock::time_point order;
+    /// When the message was logged, for display
+    std::chrono::system_clock::time_point time;
+};
+
+/// A single-producer, single-consumer queue of the records logged by one thread
+class Ring
+{
+public:
+    auto push(Record&& record) -> bool
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == capacity)
+        {
+            return false;
+        }
+        records[tail % capacity] = std::move(record);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    void drain_into(std::vector<Record>& out)
+    {
+        auto head = head_.load(std::memory_order_relaxed);
+        auto const tail = tail_.load(std::memory_order_acquire);
+        for (; head != tail; ++head)
+        {
+            out.push_back(std::move(records[head % capacity]));
+        }
+        head_.store(head, std::memory_order_release);
+    }
+
+    auto empty() const -> bool
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    static size_t constexpr capacity = 256;
+
+    std::array<Record, capacity> records;
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+};
+
+std::atomic<uint64_t> next_logger_id{0};
+}
+
+struct ml::AsyncLogger::Self
+{
+    explicit Self(std::shared_ptr<Logger> const& target);
+
+    void log(Severity severity, std::string const& message, std::string const& component);
+    auto flush(std::chrono::milliseconds timeout) -> bool;
+    void stop();
+
+private:
+    auto ring_for_this_thread() -> Ring&;
+    void request_write();
+    auto anything_queued() -> bool;
+    auto write_queued() -> bool;
+    void run();
+
+    /// How long the writer gathers messages for, once it has been woken, before writing them
+    static constexpr std::chrono::milliseconds batch_interval{1};
+
+    std::shared_ptr<Logger> const target;
+    uint64_t const id{next_logger_id++};
+
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<Ring>> rings;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable written_changed;
+    /// Bumped whenever someone needs the writer to write what's queued
+    uint64_t requested{0};
+    /// The value of `requested` for which everything queued has been written
+    uint64_t written{0};
+    bool stopping{false};
+
+    /// Whether the writer is waiting, with nothing queued, to be told that there is
+    std::atomic<bool> writer_idle{false};
+    std::thread writer;
+};
+
+namespace
+{
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<ml::AsyncLogger*> loggers;
+};
+
+auto registry() -> Registry&
+{
+    // Deliberately leaked so that it is still usable from fatal_error() during static destruction
+    static auto const instance = new Registry;
+    return *instance;
+}
+}
+
+ml::AsyncLogger::Self::Self(std::shared_ptr<Logger> const& target)
+    : target{target}
+{
+    writer = std::thread{[this] { run(); }};
+}
+
+auto ml::AsyncLogger::Self::ring_for_this_thread() -> Ring&
+{
+    struct Entry
+    {
+        uint64_t logger_id;
+        std::shared_ptr<Ring> ring;
+    };
+    thread_local std::vector<Entry> entries;
+
+    for (auto const& entry : entries)
+    {
+        if (entry.logger_id == id)
+        {
+            return *entry.ring;
+        }
+    }
+
+    // First message from this thread: forget the rings of any loggers since destroyed, and register a new one
+    std::erase_if(entries, [](Entry const& entry) { return entry.ring.use_count() == 1; });
+
+    auto const ring = std::make_shared<Ring>();
+    {
+        std::lock_guard lock{rings_mutex};
+        rings.push_back(ring);
+    }
+    entries.push_back({id, ring});
+    return *ring;
+}
+
+void ml::AsyncLogger::Self::request_write()
+{
+    {
+        std::lock_guard lock{mutex};
+        ++requested;
+    }
+    wake.notify_one();
+}
+
+void ml::AsyncLogger::Self::log(Severity severity, std::string const& message, std::string const& component)
+{
+    if (std::this_thread::get_id() == writer.get_id())
+    {
+        // The target is logging about itself; queuing this would wait on ourselves
+        target->log(severity, message, component);
+        return;
+    }
+
+    Record record{
+        severity,
+        message,
+        component,
+        std::chrono::steady_clock::now(),
+        std::chrono::system_clock::now()};
+    auto& ring = ring_for_this_thread();
+    while (!ring.push(std::move(record)))
+    {
+        request_write();
+        std::this_thread::yield();
+    }
+
+    if (severity == Severity::critical)
+    {
+        flush(std::chrono::seconds{1});
+        return;
+    }
+
+    // Pairs with the fence in run(): either the writer sees this message, or we see that it's idle and wake it.
+    // While the writer is busy, or gathering a batch, logging costs no system calls.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writer_idle.load(std::memory_order_relaxed) && writer_idle.exchange(false))
+    {
+        request_write();
+    }
+}
+
+auto ml::AsyncLogger::Self::flush(std::chrono::milliseconds timeout) -> bool
+{
+    if (std::this_thread::get_id() == writer.get_id())
+    {
+        return false;
+    }
+
+    std::unique_lock lock{mutex};
+    auto const target_request = ++requested;
+    wake.notify_one();
+    return written_changed.wait_for(lock, timeout, [&] { return written >= target_request; });
+}
+
+auto ml::AsyncLogger::Self::anything_queued() -> bool
+{
+    std::lock_guard lock{rings_mutex};
+    return std::ranges::any_of(rings, [](auto const& ring) { return !ring->empty(); });
+}
+
+auto ml::AsyncLogger::Self::write_queued() -> bool
+{
+    std::vector<Record> records;
+    {
+        std::lock_guard lock{rings_mutex};
+        for (auto const& ring : rings)
+        {
+            ring->drain_into(records);
+        }
+
+        // Drop the rings of threads that have exited, once we've written everything they logged
+        std::erase_if(rings, [](std::shared_ptr<Ring> const& ring) { return ring.use_count() == 1 && ring->empty(); });
+    }
+
+    if (records.empty())
+    {
+        return false;
+    }
+
+    // Each ring is in order already, so a stable sort keeps each thread's messages in the order they were logged
+    std::ranges::stable_sort(records, {}, &Record::order);
+
+    MessageBatch batch;
+    for (auto const& record : records)
+    {
+        batch.logged_at(record.time);
+        try
+        {
+            target->log(record.severity, record.message, record.component);
+        }
+        catch (...)
+        {
+            // There's nowhere to report a failure to log
+        }
+    }
+    return true;
+}
+
+void ml::AsyncLogger::Self::run()
+{
+    pthread_setname_np(pthread_self(), "Mir/Logger");
+
+    for (;;)
+    {
+        uint64_t seen;
+        bool stop;
+        {
+            std::lock_guard lock{mutex};
+            seen = requested;
+            stop = stopping;
+        }
+
+        auto const wrote_something = write_queued();
+
+        {
+            std::lock_guard lock{mutex};
+            written = seen;
+        }
+        written_changed.notify_all();
+
+        if (stop)
+        {
+            return;
+        }
+
+        auto const woken = [&] { return requested != seen || stopping; };
+        if (wrote_something)
+        {
+            // More is likely on its way; gather it up rather than writing (and flushing) each message alone
+            std::unique_lock lock{mutex};
+            wake.wait_for(lock, batch_interval, woken);
+        }
+        else
+        {
+            writer_idle = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (anything_queued())
+            {
+                writer_idle = false;
+                continue;
+            }
+
+            std::unique_lock lock{mutex};
+            wake.wait(lock, woken);
+            writer_idle = false;
+        }
+    }
+}
+
+void ml::AsyncLogger::Self::stop()
+{
+    {
+        std::lock_guard lock{mutex};
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+ml::AsyncLogger::AsyncLogger(std::shared_ptr<Logger> const& target)
+    : self{std::make_shared<Self>(target)}
+{
+    auto& reg = registry();
+    std::lock_guard lock{reg.mutex};
+    reg.loggers.push_back(this);
+}
+
+ml::AsyncLogger::~AsyncLogger()
+{
+    {
+        auto& reg = registry();
+        std::lock_guard lock{reg.mutex};
+        std::erase(reg.loggers, this);
+    }
+    self->stop();
+}
+
+auto ml::AsyncLogger::flush(std::chrono::milliseconds timeout) -> bool
+{
+    return self->flush(timeout);
+}
+
+void ml::AsyncLogger::flush_all()
+{
+    auto& reg = registry();
+    std::unique_lock lock{reg.mutex, std::try_to_lock};
+    if (!lock.owns_lock())
+    {
+        return;
+    }
+
+    for (auto const logger : reg.loggers)
+    {
+        logger->flush(std::chrono::milliseconds{500});
+    }
+}
+
+void ml::AsyncLogger::log(Severity severity, std::string const& message, std::string const& component)
+{
+    self->log(severity, message, component);
+}
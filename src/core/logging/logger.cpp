@@ -26,11 +26,13 @@
 #include <mir/synchronised.h>
 #include <mir/logging/dumb_console_logger.h>
 #include <mir/fatal.h>
+#include "message_batch.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <chrono>
 #include <format>
-#include <mutex>
 #include <cerrno>
 #include <cstdarg>
 #include <cstdio>
@@ -61,36 +63,94 @@ void ml::Logger::log(Severity severity, Tags tags, std::string_view message)
     // TODO: Remove the log(Severity, std::string, std::string) interface and replace
     // with this one.
 
-    for (auto const& tag: tags)
+    if (!logging_enabled_for(tags, severity))
     {
-        if (logging_enabled_for(tag, severity))
-        {
-            std::string component;
-            std::ranges::copy(
-                tags | std::views::transform([](Tag const& tag) { return tag::name(tag); }) | std::views::join_with(':'),
-                std::back_inserter(component));
-            log(severity, std::string{message}, component);
-            return;
-        }
+        return;
     }
+
+    if (tags.size() == 1)
+    {
+        log(severity, std::string{message}, tags.begin()->get().name);
+        return;
+    }
+
+    std::string component;
+    std::ranges::copy(
+        tags | std::views::transform([](Tag const& tag) { return tag::name(tag); }) | std::views::join_with(':'),
+        std::back_inserter(component));
+    log(severity, std::string{message}, component);
 }
 
 namespace
 {
-std::mutex log_mutex;
-std::shared_ptr<ml::Logger> the_logger;
+std::atomic<std::shared_ptr<ml::Logger>> the_logger;
 
 std::shared_ptr<ml::Logger> get_logger()
 {
-    std::lock_guard lock{log_mutex};
+    if (auto logger = the_logger.load())
+        return logger;
+
+    std::shared_ptr<ml::Logger> none;
+    auto const fallback = std::make_shared<ml::DumbConsoleLogger>();
+    return the_logger.compare_exchange_strong(none, fallback) ? fallback : none;
+}
+
+thread_local ml::MessageBatch* current_batch{nullptr};
+
+/// The local time at \p now
+///
+/// Looking up the time zone, and formatting a zoned_time, is far more costly than the rest of formatting a
+/// message. The UTC offset only changes at the boundaries of the zone's current period (such as DST changes), so
+/// remember it until then.
+auto local_time_at(std::chrono::system_clock::time_point now) -> std::chrono::local_time<std::chrono::microseconds>
+{
+    using namespace std::chrono;
+    thread_local sys_info period{.begin = sys_seconds::max(), .end = sys_seconds::min()};
 
-    if (!the_logger)
-        the_logger = std::make_shared<ml::DumbConsoleLogger>();
+    auto const now_us = time_point_cast<microseconds>(now);
+    if (now_us < period.begin || now_us >= period.end)
+    {
+        period = current_zone()->get_info(now_us);
+    }
 
-    return the_logger;
+    return local_time<microseconds>{now_us.time_since_epoch() + period.offset};
 }
 }
 
+ml::MessageBatch::MessageBatch()
+    : previous{current_batch},
+      time_{std::chrono::system_clock::now()}
+{
+    current_batch = this;
+}
+
+ml::MessageBatch::~MessageBatch()
+{
+    current_batch = previous;
+    for (auto const stream : unflushed)
+    {
+        stream->flush();
+    }
+}
+
+void ml::MessageBatch::logged_at(std::chrono::system_clock::time_point time)
+{
+    time_ = time;
+}
+
+auto ml::MessageBatch::current() -> MessageBatch*
+{
+    return current_batch;
+}
+
+void ml::MessageBatch::written_to(std::ostream& stream)
+{
+    if (std::ranges::find(unflushed, &stream) == unflushed.end())
+    {
+        unflushed.push_back(&stream);
+    }
+}
+
 void ml::log(ml::Severity severity, const std::string& message, const std::string& component)
 {
     auto const logger = get_logger();
@@ -100,6 +160,11 @@ void ml::log(ml::Severity severity, const std::string& message, const std::strin
 
 void ml::log(Severity severity, Tags tags, std::string_view message)
 {
+    if (!logging_enabled_for(tags, severity))
+    {
+        return;
+    }
+
     auto const logger = get_logger();
 
     logger->log(severity, tags, message);
@@ -109,8 +174,7 @@ void ml::set_logger(std::shared_ptr<Logger> const& new_logger)
 {
     if (new_logger)
     {
-        std::lock_guard lock{log_mutex};
-        the_logger = new_logger;
+        the_logger.store(new_logger);
     }
 }
 
@@ -133,13 +197,19 @@ void ml::format_message(std::ostream& out, Severity severity, std::string const&
 
     try
     {
-        using namespace std::chrono;
-        auto now = system_clock::now();
-        auto now_us = time_point_cast<microseconds>(now);
-        auto local = zoned_time{current_zone(), now_us};
+        auto const batch = MessageBatch::current();
+        auto const local = local_time_at(batch ? batch->time() : std::chrono::system_clock::now());
         std::format_to(std::ostreambuf_iterator{out}, "[{:%F %T}] {}{}: {}\n",
             local, lut[static_cast<int>(severity)], component, message);
-        out.flush();
+
+        if (batch)
+        {
+            batch->written_to(out);
+        }
+        else
+        {
+            out.flush();
+        }
     }
     catch (std::runtime_error const& e)
     {
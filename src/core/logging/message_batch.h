@@ -0,0 +1,58 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_LOGGING_MESSAGE_BATCH_H_
+#define MIR_LOGGING_MESSAGE_BATCH_H_
+
+#include <chrono>
+#include <iosfwd>
+#include <vector>
+
+namespace mir
+{
+namespace logging
+{
+/// Lets a thread writing out queued messages control how format_message() writes them
+///
+/// While a MessageBatch is alive on a thread, format_message() stamps messages with the time given to
+/// logged_at() rather than the time they are written, and leaves flushing the streams it writes to until
+/// the batch is destroyed.
+class MessageBatch
+{
+public:
+    MessageBatch();
+    ~MessageBatch();
+
+    void logged_at(std::chrono::system_clock::time_point time);
+
+    /// The batch active on the calling thread, or null
+    static auto current() -> MessageBatch*;
+
+    auto time() const -> std::chrono::system_clock::time_point { return time_; }
+    void written_to(std::ostream& stream);
+
+private:
+    MessageBatch(MessageBatch const&) = delete;
+    MessageBatch& operator=(MessageBatch const&) = delete;
+
+    MessageBatch* const previous;
+    std::chrono::system_clock::time_point time_;
+    std::vector<std::ostream*> unflushed;
+};
+}
+}
+
+#endif // MIR_LOGGING_MESSAGE_BATCH_H_
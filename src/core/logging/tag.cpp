@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <atomic>
 #include <boost/throw_exception.hpp>
+#include <cstdint>
 #include <list>
 #include <iterator>
 #include <ranges>
@@ -32,24 +33,43 @@
 
 namespace ml = mir::logging;
 
-struct ml::Tag
-{
-    std::string const name;
-    std::atomic<Severity> logging_severity;
-    Tag const* parent;
-};
+// Only "base" exists, logging warnings and worse, until the first tag is created. This is constant-initialised so that
+// it is correct for anything logged during static initialisation.
+constinit std::atomic<std::uint64_t> ml::detail::enabled_tags[5]{1, 1, 1, 0, 0};
 
 namespace
 {
+auto bit_for_tag(size_t index) -> std::uint64_t
+{
+    return index < 63 ? std::uint64_t{1} << index : ml::detail::shared_bit;
+}
+
 auto construct_initial_tag_list() -> std::list<ml::Tag>
 {
     decltype(construct_initial_tag_list()) list;
-    list.emplace_back("base", ml::Severity::warning, nullptr);
+    list.emplace_back("base", ml::Severity::warning, nullptr, bit_for_tag(0));
     return list;
 }
 
 mir::Synchronised<std::list<ml::Tag>> known_tags{construct_initial_tag_list()}; //TICS !cppcoreguidelines-avoid-non-const-global-variables - This is the list of tags, shared within this module
 
+void update_enabled_tags(decltype(known_tags)::Locked const& tag_list)
+{
+    std::uint64_t enabled[std::size(ml::detail::enabled_tags)]{};
+    for (auto const& tag : *tag_list)
+    {
+        for (auto sev = 0; sev <= static_cast<int>(tag.logging_severity.load()); ++sev)
+        {
+            enabled[sev] |= tag.bit;
+        }
+    }
+
+    for (auto sev = 0u; sev != std::size(enabled); ++sev)
+    {
+        ml::detail::enabled_tags[sev].store(enabled[sev], std::memory_order_relaxed);
+    }
+}
+
 /**
  * Ensure the core tags are registered as soon as possible.
  *
@@ -83,7 +103,8 @@ auto ml::create_tag(Tag const& parent, std::string_view name) -> Tag const&
     }
 
     auto locked_tags = known_tags.lock();
-    locked_tags->emplace_back(std::string{name}, Severity::warning, &parent);
+    locked_tags->emplace_back(std::string{name}, Severity::warning, &parent, bit_for_tag(locked_tags->size()));
+    update_enabled_tags(locked_tags);
     return locked_tags->back();
 }
 
@@ -265,6 +286,7 @@ void ml::tag::set_severity(std::string_view name, Severity sev)
     auto& tag = lookup_tag(locked_tags, name);
     tag.logging_severity = sev;
     for_each_child(tag, locked_tags, [sev](ml::Tag& tag) { tag.logging_severity = sev; });
+    update_enabled_tags(locked_tags);
 }
 
 // GCC and Clang both ensure the switch is exhaustive.
@@ -17,8 +17,14 @@
 #ifndef MIR_COMPOSITOR_COMPOSITOR_H_
 #define MIR_COMPOSITOR_COMPOSITOR_H_
 
+#include <mir/graphics/display.h>
+
 namespace mir
 {
+namespace graphics
+{
+class DisplayConfiguration;
+}
 namespace compositor
 {
 
@@ -30,6 +36,27 @@ public:
     virtual void start() = 0;
     virtual void stop() = 0;
 
+    /**
+     * Applies a configuration to the display being composited.
+     *
+     * By default compositing stops for the duration of the change. Implementations
+     * may instead stop compositing only to the outputs the change affects.
+     */
+    virtual void configure_display(graphics::Display& display, graphics::DisplayConfiguration const& conf)
+    {
+        stop();
+        try
+        {
+            display.configure(conf);
+        }
+        catch (...)
+        {
+            start();
+            throw;
+        }
+        start();
+    }
+
 protected:
     Compositor() = default;
     Compositor(Compositor const&) = delete;
@@ -35,6 +35,10 @@ namespace software
 class WriteMappable;
 }
 }
+namespace graphics
+{
+class DMABufBuffer;
+}
 namespace compositor
 {
 
@@ -58,6 +62,33 @@ public:
         bool overlay_cursor,
         std::function<void(std::optional<time::Timestamp>)>&& callback) = 0;
 
+    /// Update only [buffer_region] of a [buffer] that already holds an earlier capture of
+    /// [area], leaving the rest of it untouched; this avoids rendering and copying
+    /// anything that hasn't changed.
+    ///
+    /// The [callback] is given the region of [buffer] that was actually updated along with
+    /// the timestamp. This may be larger than requested (for example, all of [buffer] if
+    /// [transform] rotates the capture).
+    virtual void capture(
+        std::shared_ptr<renderer::software::WriteMappable> const& buffer,
+        geometry::Rectangle const& area,
+        geometry::Rectangle const& buffer_region,
+        glm::mat2 const& transform,
+        bool overlay_cursor,
+        std::function<void(std::optional<time::Timestamp>, geometry::Rectangle const&)>&& callback) = 0;
+
+    /// As the first overload, but rendering directly into a GPU [buffer] with no copy through
+    /// CPU-accessible memory. This will fail unless supports_dma_buf_targets().
+    virtual void capture(
+        std::shared_ptr<graphics::DMABufBuffer> const& buffer,
+        geometry::Rectangle const& area,
+        glm::mat2 const& transform,
+        bool overlay_cursor,
+        std::function<void(std::optional<time::Timestamp>)>&& callback) = 0;
+
+    /// Whether DMA-BUF capture targets can be rendered into
+    virtual auto supports_dma_buf_targets() const -> bool = 0;
+
     virtual CompositorID id() const = 0;
 
 private:
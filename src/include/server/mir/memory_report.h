@@ -0,0 +1,46 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_MEMORY_REPORT_H_
+#define MIR_MEMORY_REPORT_H_
+
+#include <mir/memory_accounting.h>
+
+#include <map>
+
+namespace mir
+{
+/// What the server is spending memory on, as recorded in memory::ledger()
+class MemoryReport
+{
+public:
+    /// A snapshot of the ledger, as requested by the user
+    virtual void usage(
+        memory::Usage const& total,
+        std::map<memory::ClientId, memory::Usage> const& by_client) = 0;
+
+    /// \p client has tried to take its usage to \p usage bytes, beyond its \p budget
+    virtual void client_over_budget(memory::ClientId client, std::size_t usage, std::size_t budget) = 0;
+
+protected:
+    MemoryReport() = default;
+    virtual ~MemoryReport() = default;
+    MemoryReport(MemoryReport const&) = delete;
+    MemoryReport& operator=(MemoryReport const&) = delete;
+};
+}
+
+#endif /* MIR_MEMORY_REPORT_H_ */
@@ -18,13 +18,14 @@
 #define MIR_OBSERVER_MULTIPLEXER_H_
 
 #include <mir/observer_registrar.h>
-#include <mir/posix_rw_mutex.h>
 #include <mir/executor.h>
 #include <mir/raii.h>
 #include <mir/synchronised.h>
 
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <condition_variable>
@@ -45,6 +46,10 @@ namespace mir
  * When an observer is removed a WeakObserver is marked as reset and removed from the observers list.
  * ObserverMultiplexer::unregister_interest() does not return until the related WeakObserver has been reset. This
  * happens once all in-flight observations have either completed, or are on threads that have removed the observer.
+ *
+ * The observers list is copy-on-write: adding or removing an observer publishes a new list, and notifications work
+ * from whichever list was current when they started, without taking a lock. Observations for observers using the
+ * immediate_executor are made directly, without packaging them into a std::function.
  */
 template<class Observer>
 class ObserverMultiplexer : public ObserverRegistrar<Observer>, public Observer
@@ -107,6 +112,12 @@ private:
         {
         }
 
+        /// Whether observations can be made directly on the notifying thread
+        auto runs_immediately() const -> bool
+        {
+            return executor == &immediate_executor;
+        }
+
         void spawn(std::function<void()>&& work)
         {
             // Executor only guaranteed to be alive as long as observer
@@ -247,10 +258,14 @@ private:
         std::condition_variable reset_cv;
     };
 
-    PosixRWMutex observer_mutex;
+    using ObserverList = std::vector<std::shared_ptr<WeakObserver>>;
+
+    /// Serialises changes to the observers list; notifications do not take it
+    std::mutex observer_mutex;
     /// This is a two-partitioning of early observers and other observers.
     /// Early observers are always partitioned before other observers.
-    std::vector<std::shared_ptr<WeakObserver>> observers;
+    /// The list is never modified once published, only replaced (under observer_mutex).
+    std::atomic<std::shared_ptr<ObserverList const>> observers{std::make_shared<ObserverList const>()};
 };
 
 template<class Observer>
@@ -266,7 +281,9 @@ void ObserverMultiplexer<Observer>::register_interest(
 {
     std::lock_guard lock{observer_mutex};
 
-    observers.emplace_back(std::make_shared<WeakObserver>(observer, executor));
+    auto updated = std::make_shared<ObserverList>(*observers.load());
+    updated->emplace_back(std::make_shared<WeakObserver>(observer, executor));
+    observers.store(std::move(updated));
 }
 
 template<class Observer>
@@ -276,28 +293,32 @@ void ObserverMultiplexer<Observer>::register_early_observer(
 {
     std::lock_guard lock{observer_mutex};
 
-    observers.insert(observers.begin(), std::make_shared<WeakObserver>(observer, executor));
+    auto updated = std::make_shared<ObserverList>(*observers.load());
+    updated->insert(updated->begin(), std::make_shared<WeakObserver>(observer, executor));
+    observers.store(std::move(updated));
 }
 
 template<class Observer>
 void ObserverMultiplexer<Observer>::unregister_interest(Observer const& observer)
 {
     std::lock_guard lock{observer_mutex};
+
+    auto updated = std::make_shared<ObserverList>(*observers.load());
     std::erase_if(
-        observers,
+        *updated,
         [&observer](auto& candidate)
         {
             // This will wait for any (other) thread to finish with the candidate observer, then reset it
             // (preventing future notifications from being sent) if it is the same as the unregistered observer.
             return candidate->maybe_reset(&observer);
         });
+    observers.store(std::move(updated));
 }
 
 template<class Observer>
 auto ObserverMultiplexer<Observer>::empty() -> bool
 {
-    std::lock_guard lock{observer_mutex};
-    return observers.empty();
+    return observers.load()->empty();
 }
 
 template<class Observer>
@@ -307,18 +328,22 @@ void ObserverMultiplexer<Observer>::for_each_observer(MemberFn f, Args&&... args
     static_assert(
         std::is_member_function_pointer<MemberFn>::value,
         "f must be of type (Observer::*)(Args...), a pointer to an Observer member function.");
-    decltype(observers) local_observers;
+    auto const local_observers = observers.load();
+    for (auto const& weak_observer: *local_observers)
     {
-        std::lock_guard lock{observer_mutex};
-        local_observers = observers;
-    }
-    for (auto& weak_observer: local_observers)
-    {
-        weak_observer->spawn(
-            [f, weak_observer = std::move(weak_observer), args...]() mutable
-            {
-                weak_observer->invoke(f, std::forward<Args>(args)...);
-            });
+        if (weak_observer->runs_immediately())
+        {
+            // Each observer sees the same arguments, so they are passed as lvalues rather than forwarded
+            weak_observer->invoke(f, args...);
+        }
+        else
+        {
+            weak_observer->spawn(
+                [f, weak_observer, args...]() mutable
+                {
+                    weak_observer->invoke(f, std::forward<Args>(args)...);
+                });
+        }
     }
 }
 
@@ -329,15 +354,11 @@ void ObserverMultiplexer<Observer>::for_single_observer(Observer const& target_o
     static_assert(
         std::is_member_function_pointer<MemberFn>::value,
         "f must be of type (Observer::*)(Args...), a pointer to an Observer member function.");
-    decltype(observers) local_observers;
-    {
-        std::lock_guard lock{observer_mutex};
-        local_observers = observers;
-    }
-    for (auto& weak_observer: local_observers)
+    auto const local_observers = observers.load();
+    for (auto const& weak_observer: *local_observers)
     {
         weak_observer->spawn_if_eq(target_observer,
-            [f, weak_observer = std::move(weak_observer), args...]() mutable
+            [f, weak_observer, args...]() mutable
             {
                 weak_observer->invoke(f, std::forward<Args>(args)...);
             });
@@ -103,6 +103,12 @@ public:
 
     virtual void set_opaque_region(geometry::Rectangles const& region) override;
 
+    auto tearing_allowed() const -> bool override;
+    void set_tearing_allowed(bool allowed) override;
+
+    auto content_type() const -> MirContentType override;
+    void set_content_type(MirContentType content_type) override;
+
     void resize(geometry::Size const& size) override;
     geometry::Point top_left() const override;
     geometry::Rectangle input_bounds() const override;
@@ -197,6 +203,7 @@ private:
     MirOrientationMode set_preferred_orientation(MirOrientationMode mode);
     void clear_frame_posted_callbacks(State& state);
     void update_frame_posted_callbacks(State& state);
+    void update_frame_posted_callback(State const& state, StreamInfo const& layer);
     auto content_size(State const& state) const -> geometry::Size;
     auto content_top_left(State const& state) const -> geometry::Point;
     void track_outputs();
@@ -214,6 +221,8 @@ private:
         input::InputReceptionMode input_mode;
         std::vector<geometry::Rectangle> custom_input_rectangles{};
         geometry::Rectangles opaque_region{};
+        bool tearing_allowed{false};
+        MirContentType content_type{mir_content_type_none};
         std::shared_ptr<graphics::CursorImage> cursor_image;
 
         std::list<StreamInfo> layers;
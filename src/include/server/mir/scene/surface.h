@@ -93,6 +93,19 @@ public:
 
     virtual void set_opaque_region(geometry::Rectangles const& region) = 0;
 
+    /// Whether the client prefers its content presented with minimal latency, even if this causes tearing
+    /// Defaults to false. The compositor may ignore this, for example if the surface is not fullscreen.
+    ///@{
+    virtual auto tearing_allowed() const -> bool = 0;
+    virtual void set_tearing_allowed(bool allowed) = 0;
+    ///@}
+
+    /// The kind of content the client says the surface shows, used to decide how to schedule its presentation
+    ///@{
+    virtual auto content_type() const -> MirContentType = 0;
+    virtual void set_content_type(MirContentType content_type) = 0;
+    ///@}
+
     /// Given value is the frame size of the window
     virtual void resize(geometry::Size const& window_size) = 0;
     virtual void set_transformation(glm::mat4 const& t) = 0;
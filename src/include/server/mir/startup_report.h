@@ -0,0 +1,73 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_STARTUP_REPORT_H_
+#define MIR_STARTUP_REPORT_H_
+
+#include <memory>
+
+namespace mir
+{
+/// Where the time goes between the server being run and it showing a client's first frame
+class StartupReport
+{
+public:
+    /**
+     * A phase of startup has begun.
+     *
+     * Phases nest: a phase that begins before \p phase ends is a part of \p phase.
+     */
+    virtual void phase_begun(char const* phase) = 0;
+    virtual void phase_ended(char const* phase) = 0;
+
+    /// The first frame has been composited for display
+    virtual void first_frame() = 0;
+    /// The first frame showing a client's surface has been composited for display
+    virtual void first_client_frame() = 0;
+
+protected:
+    StartupReport() = default;
+    virtual ~StartupReport() = default;
+    StartupReport(StartupReport const&) = delete;
+    StartupReport& operator=(StartupReport const&) = delete;
+};
+
+/// Reports a phase of startup as lasting for the lifetime of this object
+class StartupPhase
+{
+public:
+    StartupPhase(std::shared_ptr<StartupReport> const& report, char const* phase)
+        : report{report},
+          phase{phase}
+    {
+        report->phase_begun(phase);
+    }
+
+    ~StartupPhase()
+    {
+        report->phase_ended(phase);
+    }
+
+private:
+    StartupPhase(StartupPhase const&) = delete;
+    StartupPhase& operator=(StartupPhase const&) = delete;
+
+    std::shared_ptr<StartupReport> const report;
+    char const* const phase;
+};
+}
+
+#endif /* MIR_STARTUP_REPORT_H_ */
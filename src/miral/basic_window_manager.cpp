@@ -90,6 +90,11 @@ miral::BasicWindowManager::Locker::Locker(BasicWindowManager* self) :
     policy{self->policy.get()}
 {
     policy->advise_begin();
+
+    // Workspaces rarely die, so don't take a second lock on every input event just to find that out
+    if (!self->dead_workspaces->any_died.exchange(false, std::memory_order_acquire))
+        return;
+
     std::vector<std::weak_ptr<Workspace>> workspaces;
     {
         std::lock_guard const lock{self->dead_workspaces->dead_workspaces_mutex};
@@ -97,7 +102,7 @@ miral::BasicWindowManager::Locker::Locker(BasicWindowManager* self) :
     }
 
     for (auto const& workspace : workspaces)
-        self->workspaces_to_windows.left.erase(workspace);
+        self->workspace_membership.forget(workspace);
 }
 
 miral::BasicWindowManager::BasicWindowManager(
@@ -128,14 +133,14 @@ miral::BasicWindowManager::~BasicWindowManager()
 void miral::BasicWindowManager::add_session(std::shared_ptr<scene::Session> const& session)
 {
     Locker lock{this};
-    policy->advise_new_app(app_info[session] = ApplicationInfo(session));
+    policy->advise_new_app(app_info.insert(session, ApplicationInfo(session)));
 }
 
 void miral::BasicWindowManager::remove_session(std::shared_ptr<scene::Session> const& session)
 {
     Locker lock{this};
-    auto info = app_info.find(session);
-    if (info == app_info.end())
+    auto const info = app_info.find(session);
+    if (!info)
     {
         log_debug(
             "BasicWindowManager::remove_session() called with unknown or already removed session %s (PID: %d)",
@@ -143,7 +148,7 @@ void miral::BasicWindowManager::remove_session(std::shared_ptr<scene::Session> c
             session->process_id());
         return;
     }
-    policy->advise_delete_app(info->second);
+    policy->advise_delete_app(*info);
     app_info.erase(session);
 }
 
@@ -155,20 +160,39 @@ auto miral::BasicWindowManager::add_surface(
         shell::SurfaceSpecification const& params)> const& build)
 -> std::shared_ptr<scene::Surface>
 {
-    Locker lock{this};
+    // New windows are placed against the windows created before them, so one creation mustn't overlap another
+    std::lock_guard const creation_lock{surface_creation_mutex};
 
-    auto& session_info = info_for(session);
-
-    WindowSpecification spec = policy->place_new_window(session_info, place_new_surface(params));
+    WindowSpecification spec;
+    {
+        Locker lock{this};
+        spec = policy->place_new_window(info_for(session), place_new_surface(params));
+    }
 
+    // Building the surface allocates it and adds it to the scene. None of that touches our state, so do it without
+    // holding the lock: input events and other shell requests need not wait for it. Until it is added to window_info
+    // below the surface is simply unknown to us (see window_at()).
     auto const surface = build(session, make_surface_spec(spec));
+
+    Locker lock{this};
+
+    // The session may have gone while the lock was released, and nothing would then destroy the surface
+    if (!app_info.find(session))
+    {
+        session->destroy_surface(surface);
+        BOOST_THROW_EXCEPTION(std::runtime_error("Session was removed while its surface was being built"));
+    }
+
+    auto& session_info = info_for(session);
     Window const window{session, surface};
-    auto& window_info = this->window_info.emplace(window, WindowInfo{window, spec}).first->second;
+    auto& window_info = this->window_info.insert(surface, WindowInfo{window, spec});
 
     session_info.add_window(window);
 
+    // The parent may have gone while the lock was released
     auto const parent_surface = [&po = spec.parent()](){ return po.has_value() ? po.value().lock() : nullptr; }();
-    auto const parent = parent_surface ? info_for(parent_surface).window() : Window{};
+    auto const parent_info = parent_surface ? this->window_info.find(parent_surface) : nullptr;
+    auto const parent = parent_info ? parent_info->window() : Window{};
     window_info.parent(parent);
     if (parent)
     {
@@ -240,7 +264,7 @@ void miral::BasicWindowManager::remove_surface(
     std::weak_ptr<scene::Surface> const& surface)
 {
     Locker lock{this};
-    if (app_info.find(session) == app_info.end())
+    if (!app_info.find(session))
     {
         log_debug(
             "BasicWindowManager::remove_surface() called with unknown or already removed session %s (PID: %d)",
@@ -268,7 +292,7 @@ void miral::BasicWindowManager::remove_window(Application const& application, mi
             policy->advise_removing_from_workspace(workspace, windows_removed);
         }
 
-        workspaces_to_windows.right.erase(info.window());
+        workspace_membership.remove(info.window());
     }
 
     policy->advise_delete_window(info);
@@ -313,15 +337,9 @@ void miral::BasicWindowManager::refocus(
                 // select_active_window() calls set_focus_to() which updates mru_active_windows and changes window
                 auto const w = window;
 
-                for (auto const& workspace : workspaces_containing(w))
+                if (workspace_membership.in_any_of(w, workspaces_containing_window))
                 {
-                    for (auto const& ww : workspaces_containing_window)
-                    {
-                        if (ww == workspace)
-                        {
-                            return !(new_focus = select_active_window(w));
-                        }
-                    }
+                    return !(new_focus = select_active_window(w));
                 }
 
                 return true;
@@ -444,36 +462,26 @@ auto miral::BasicWindowManager::count_applications() const
 
 void miral::BasicWindowManager::for_each_application(std::function<void(ApplicationInfo& info)> const& functor)
 {
-    for(auto& info : app_info)
-    {
-        functor(info.second);
-    }
+    app_info.for_each(functor);
 }
 
 auto miral::BasicWindowManager::find_application(std::function<bool(ApplicationInfo const& info)> const& predicate)
 -> Application
 {
-    for(auto& info : app_info)
-    {
-        if (predicate(info.second))
-        {
-            return Application{info.first};
-        }
-    }
-
-    return Application{};
+    auto const info = app_info.find_if(predicate);
+    return info ? info->application() : Application{};
 }
 
 auto miral::BasicWindowManager::info_for(std::weak_ptr<scene::Session> const& session) const
 -> ApplicationInfo&
 {
-    return const_cast<ApplicationInfo&>(app_info.at(session));
+    return app_info.at(session);
 }
 
 auto miral::BasicWindowManager::info_for(std::weak_ptr<scene::Surface> const& surface) const
 -> WindowInfo&
 {
-    return const_cast<WindowInfo&>(window_info.at(surface));
+    return window_info.at(surface);
 }
 
 auto miral::BasicWindowManager::info_for(Window const& window) const
@@ -596,18 +604,7 @@ void miral::BasicWindowManager::focus_prev_application()
 auto miral::BasicWindowManager::workspaces_containing(Window const& window) const
 -> std::vector<std::shared_ptr<Workspace>>
 {
-    auto const iter_pair = workspaces_to_windows.right.equal_range(window);
-
-    std::vector<std::shared_ptr<Workspace>> workspaces_containing_window;
-    for (auto kv = iter_pair.first; kv != iter_pair.second; ++kv)
-    {
-        if (auto const workspace = kv->second.lock())
-        {
-            workspaces_containing_window.push_back(workspace);
-        }
-    }
-
-    return workspaces_containing_window;
+    return workspace_membership.workspaces_containing(window);
 }
 
 auto miral::BasicWindowManager::active_display_area() const -> std::shared_ptr<DisplayArea>
@@ -731,32 +728,20 @@ void miral::BasicWindowManager::focus_next_within_application()
         {
             while (++current != end(siblings))
             {
-                for (auto const& workspace : workspaces_containing(*current))
+                if (workspace_membership.in_any_of(*current, workspaces_containing_window))
                 {
-                    for (auto const& ww : workspaces_containing_window)
-                    {
-                        if (ww == workspace)
-                        {
-                            if (prev != select_active_window(*current))
-                                return;
-                        }
-                    }
+                    if (prev != select_active_window(*current))
+                        return;
                 }
             }
         }
 
         for (current = begin(siblings); *current != prev; ++current)
         {
-            for (auto const& workspace : workspaces_containing(*current))
+            if (workspace_membership.in_any_of(*current, workspaces_containing_window))
             {
-                for (auto const& ww : workspaces_containing_window)
-                {
-                    if (ww == workspace)
-                    {
-                        if (prev != select_active_window(*current))
-                            return;
-                    }
-                }
+                if (prev != select_active_window(*current))
+                    return;
             }
         }
 
@@ -788,32 +773,20 @@ void miral::BasicWindowManager::focus_prev_within_application()
         {
             while (++current != rend(siblings))
             {
-                for (auto const& workspace : workspaces_containing(*current))
+                if (workspace_membership.in_any_of(*current, workspaces_containing_window))
                 {
-                    for (auto const& ww : workspaces_containing_window)
-                    {
-                        if (ww == workspace)
-                        {
-                            if (prev != select_active_window(*current))
-                                return;
-                        }
-                    }
+                    if (prev != select_active_window(*current))
+                        return;
                 }
             }
         }
 
         for (current = rbegin(siblings); *current != prev; ++current)
         {
-            for (auto const& workspace : workspaces_containing(*current))
+            if (workspace_membership.in_any_of(*current, workspaces_containing_window))
             {
-                for (auto const& ww : workspaces_containing_window)
-                {
-                    if (ww == workspace)
-                    {
-                        if (prev != select_active_window(*current))
-                            return;
-                    }
-                }
+                if (prev != select_active_window(*current))
+                    return;
             }
         }
 
@@ -880,8 +853,10 @@ auto miral::BasicWindowManager::can_select_window(miral::Window const& window) c
 auto miral::BasicWindowManager::window_at(geometry::Point cursor) const
 -> Window
 {
-    auto surface_at = focus_controller->surface_at(cursor);
-    return surface_at ? info_for(surface_at).window() : Window{};
+    // The scene can contain a surface that add_surface() has yet to register
+    auto const surface_at = focus_controller->surface_at(cursor);
+    auto const info = surface_at ? window_info.find(surface_at) : nullptr;
+    return info ? info->window() : Window{};
 }
 
 auto miral::BasicWindowManager::active_output() -> geometry::Rectangle const
@@ -1500,15 +1475,9 @@ void miral::BasicWindowManager::set_state(miral::WindowInfo& window_info, MirWin
                         if (candidate == window)
                             return true;
                         auto const w = candidate;
-                        for (auto const& workspace : workspaces_containing(w))
+                        if (workspace_membership.in_any_of(w, workspaces_containing_window))
                         {
-                            for (auto const& ww : workspaces_containing_window)
-                            {
-                                if (ww == workspace)
-                                {
-                                    return !(select_active_window(w));
-                                }
-                            }
+                            return !(select_active_window(w));
                         }
 
                         return true;
@@ -1749,7 +1718,7 @@ auto miral::BasicWindowManager::surface_known(
     std::weak_ptr<scene::Surface> const& surface,
     std::string const& action) -> bool
 {
-    if (window_info.find(surface) != window_info.end())
+    if (window_info.find(surface))
     {
         return true;
     }
@@ -1799,14 +1768,8 @@ auto miral::BasicWindowManager::can_activate_window_for_session_in_workspace(
             if (w.application() != session)
                 return true;
 
-            for (auto const& workspace : workspaces_containing(w))
-            {
-                for (auto const& ww : workspaces)
-                {
-                    if (ww == workspace)
-                        return !(new_focus = select_active_window(w));
-                }
-            }
+            if (workspace_membership.in_any_of(w, workspaces))
+                return !(new_focus = select_active_window(w));
 
             return true;
         });
@@ -2490,6 +2453,7 @@ public:
     {
         std::lock_guard lock {dead_workspaces->dead_workspaces_mutex};
         dead_workspaces->workspaces.push_back(self);
+        dead_workspaces->any_died.store(true, std::memory_order_release);
     }
 
 private:
@@ -2532,16 +2496,12 @@ void miral::BasicWindowManager::add_tree_to_workspace(
     windows.push_back(root);
     add_children(*info);
 
-    auto const iter_pair = workspaces_to_windows.left.equal_range(workspace);
-
     std::vector<Window> windows_added;
 
     for (auto& w : windows)
     {
-        if (!std::count_if(iter_pair.first, iter_pair.second,
-                           [&w](wwbimap_t::left_value_type const& kv) { return kv.second == w; }))
+        if (workspace_membership.add(workspace, w))
         {
-            workspaces_to_windows.left.insert(wwbimap_t::left_value_type{workspace, w});
             windows_added.push_back(w);
         }
     }
@@ -2581,14 +2541,12 @@ void miral::BasicWindowManager::remove_tree_from_workspace(
 
     std::vector<Window> windows_removed;
 
-    auto const iter_pair = workspaces_to_windows.left.equal_range(workspace);
-    for (auto kv = iter_pair.first; kv != iter_pair.second;)
+    for (auto const& w : workspace_membership.windows_in(workspace))
     {
-        auto const current = kv++;
-        if (std::count(begin(windows), end(windows), current->second))
+        if (std::count(begin(windows), end(windows), w))
         {
-            windows_removed.push_back(current->second);
-            workspaces_to_windows.left.erase(current);
+            workspace_membership.remove(workspace, w);
+            windows_removed.push_back(w);
         }
     }
 
@@ -2599,28 +2557,17 @@ void miral::BasicWindowManager::remove_tree_from_workspace(
 void miral::BasicWindowManager::move_workspace_content_to_workspace(
     std::shared_ptr<Workspace> const& to_workspace, std::shared_ptr<Workspace> const& from_workspace)
 {
-    std::vector<Window> windows_removed;
-
-    auto const iter_pair_from = workspaces_to_windows.left.equal_range(from_workspace);
-    for (auto kv = iter_pair_from.first; kv != iter_pair_from.second;)
-    {
-        auto const current = kv++;
-        windows_removed.push_back(current->second);
-        workspaces_to_windows.left.erase(current);
-    }
+    auto const windows_removed = workspace_membership.take_all(from_workspace);
 
     if (!windows_removed.empty())
         policy->advise_removing_from_workspace(from_workspace, windows_removed);
 
     std::vector<Window> windows_added;
 
-    auto const iter_pair_to = workspaces_to_windows.left.equal_range(to_workspace);
     for (auto& w : windows_removed)
     {
-        if (!std::count_if(iter_pair_to.first, iter_pair_to.second,
-                           [&w](wwbimap_t::left_value_type const& kv) { return kv.second == w; }))
+        if (workspace_membership.add(to_workspace, w))
         {
-            workspaces_to_windows.left.insert(wwbimap_t::left_value_type{to_workspace, w});
             windows_added.push_back(w);
         }
     }
@@ -2632,20 +2579,15 @@ void miral::BasicWindowManager::move_workspace_content_to_workspace(
 void miral::BasicWindowManager::for_each_workspace_containing(
     miral::Window const& window, std::function<void(std::shared_ptr<miral::Workspace> const&)> const& callback)
 {
-    auto const iter_pair = workspaces_to_windows.right.equal_range(window);
-    for (auto kv = iter_pair.first; kv != iter_pair.second; ++kv)
-    {
-        if (auto const workspace = kv->second.lock())
-            callback(workspace);
-    }
+    for (auto const& workspace : workspace_membership.workspaces_containing(window))
+        callback(workspace);
 }
 
 void miral::BasicWindowManager::for_each_window_in_workspace(
     std::shared_ptr<miral::Workspace> const& workspace, std::function<void(miral::Window const&)> const& callback)
 {
-    auto const iter_pair = workspaces_to_windows.left.equal_range(workspace);
-    for (auto kv = iter_pair.first; kv != iter_pair.second; ++kv)
-        callback(kv->second);
+    for (auto const& window : workspace_membership.windows_in(workspace))
+        callback(window);
 }
 
 auto miral::BasicWindowManager::apply_exclusive_rect_to_application_zone(
@@ -27,19 +27,20 @@
 #include <miral/zone.h>
 #include <miral/output.h>
 #include "mru_window_list.h"
+#include "object_registry.h"
+#include "workspace_membership.h"
 
 #include <mir/geometry/rectangles.h>
 #include <mir/observer_registrar.h>
 #include <mir/shell/abstract_shell.h>
 #include <mir/shell/window_manager.h>
 
-#include <boost/bimap.hpp>
-#include <boost/bimap/multiset_of.hpp>
 #include <optional>
 #include <functional>
 
-#include <map>
+#include <atomic>
 #include <mutex>
+#include <set>
 
 namespace mir
 {
@@ -221,8 +222,8 @@ private:
         std::set<Window> attached_windows; ///< Maximized/anchored/etc windows attached to this area
     };
 
-    using SurfaceInfoMap = std::map<std::weak_ptr<mir::scene::Surface>, WindowInfo, std::owner_less<std::weak_ptr<mir::scene::Surface>>>;
-    using SessionInfoMap = std::map<std::weak_ptr<mir::scene::Session>, ApplicationInfo, std::owner_less<std::weak_ptr<mir::scene::Session>>>;
+    using SurfaceInfoMap = ObjectRegistry<mir::scene::Surface, WindowInfo>;
+    using SessionInfoMap = ObjectRegistry<mir::scene::Session, ApplicationInfo>;
 
     mir::shell::FocusController* const focus_controller;
     std::shared_ptr<mir::shell::DisplayLayout> const display_layout;
@@ -233,6 +234,7 @@ private:
     {
         std::mutex mutable dead_workspaces_mutex;
         std::vector<std::weak_ptr<Workspace>> workspaces;
+        std::atomic<bool> any_died{false}; ///< Set when workspaces is non-empty, so Locker can skip the mutex
     };
 
     std::shared_ptr<DeadWorkspaces> const dead_workspaces{std::make_shared<DeadWorkspaces>()};
@@ -240,6 +242,8 @@ private:
     std::unique_ptr<WindowManagementPolicy> const policy;
 
     std::mutex mutex;
+    /// Serialises add_surface(), which releases mutex while building the surface
+    std::mutex surface_creation_mutex;
     SessionInfoMap app_info;
     SurfaceInfoMap window_info;
     mir::geometry::Rectangles outputs;
@@ -255,11 +259,7 @@ private:
     bool application_zones_need_update{false};
 
     friend class Workspace;
-    using wwbimap_t = boost::bimap<
-        boost::bimaps::multiset_of<std::weak_ptr<Workspace>, std::owner_less<std::weak_ptr<Workspace>>>,
-        boost::bimaps::multiset_of<Window>>;
-
-    wwbimap_t workspaces_to_windows;
+    WorkspaceMembership workspace_membership;
 
     std::shared_ptr<DisplayConfigurationListeners> const display_config_monitor;
     std::shared_ptr<mir::input::VirtualInputDevice> const pointer_device;
@@ -0,0 +1,184 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_OBJECT_REGISTRY_H
+#define MIRAL_OBJECT_REGISTRY_H
+
+#include <boost/throw_exception.hpp>
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace miral
+{
+/// Values associated with objects owned elsewhere (such as surfaces and sessions), without extending their lifetime
+///
+/// Values are held in slots, which are reused once erased, and are found by hashing the object's address. As a
+/// registered object may be destroyed, and its address reused, before its value is erased each slot also remembers
+/// the object's owner to tell the two apart. References to a value remain valid until it is erased.
+template<typename Object, typename Value>
+class ObjectRegistry
+{
+public:
+    /// Associate \p value with \p object, replacing any value it already has
+    auto insert(std::shared_ptr<Object> const& object, Value value) -> Value&
+    {
+        if (auto const existing = slot_for(object))
+        {
+            existing->value = std::move(value);
+            return *existing->value;
+        }
+
+        size_t index;
+        if (free_slots.empty())
+        {
+            index = slots.size();
+            slots.emplace_back();
+        }
+        else
+        {
+            index = free_slots.back();
+            free_slots.pop_back();
+        }
+
+        auto& slot = slots[index];
+        slot.index = index;
+        slot.object = object;
+        slot.address = object.get();
+        slot.value = std::move(value);
+        by_address[slot.address] = index;
+        ++count;
+        return *slot.value;
+    }
+
+    /// The value associated with \p object, or null if there is none
+    auto find(std::weak_ptr<Object> const& object) const -> Value*
+    {
+        auto const slot = slot_for(object);
+        return slot ? &*slot->value : nullptr;
+    }
+
+    /// The value associated with \p object
+    /// \throws std::out_of_range if there is none
+    auto at(std::weak_ptr<Object> const& object) const -> Value&
+    {
+        if (auto const value = find(object))
+        {
+            return *value;
+        }
+        BOOST_THROW_EXCEPTION(std::out_of_range{"Object not in registry"});
+    }
+
+    void erase(std::weak_ptr<Object> const& object)
+    {
+        if (auto const slot = slot_for(object))
+        {
+            if (auto const i = by_address.find(slot->address); i != by_address.end() && i->second == slot->index)
+            {
+                by_address.erase(i);
+            }
+            slot->object.reset();
+            slot->address = nullptr;
+            slot->value.reset();
+            free_slots.push_back(slot->index);
+            --count;
+        }
+    }
+
+    auto size() const -> size_t { return count; }
+
+    /// Calls \p f on each value, in slot order
+    template<typename F>
+    void for_each(F const& f) const
+    {
+        for (auto& slot : slots)
+        {
+            if (slot.value)
+            {
+                f(*slot.value);
+            }
+        }
+    }
+
+    /// The first value, in slot order, satisfying \p predicate, or null if there is none
+    template<typename Predicate>
+    auto find_if(Predicate const& predicate) const -> Value*
+    {
+        for (auto& slot : slots)
+        {
+            if (slot.value && predicate(*slot.value))
+            {
+                return &*slot.value;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    struct Slot
+    {
+        std::weak_ptr<Object> object;
+        Object const* address{nullptr};
+        size_t index{0};
+        std::optional<Value> value;
+    };
+
+    static auto same_owner(std::weak_ptr<Object> const& lhs, std::weak_ptr<Object> const& rhs) -> bool
+    {
+        return !lhs.owner_before(rhs) && !rhs.owner_before(lhs);
+    }
+
+    auto slot_for(std::weak_ptr<Object> const& object) const -> Slot*
+    {
+        if (auto const live = object.lock())
+        {
+            if (auto const i = by_address.find(live.get()); i != by_address.end())
+            {
+                // The address may have been reused since an expired object was registered
+                auto& slot = slots[i->second];
+                if (same_owner(slot.object, object))
+                {
+                    return &slot;
+                }
+            }
+            return nullptr;
+        }
+
+        // An expired object has no address to hash, but can still be told apart by its owner. This is rare: it only
+        // happens while tidying up after something has been destroyed.
+        for (auto& slot : slots)
+        {
+            if (slot.value && same_owner(slot.object, object))
+            {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    /// A deque, so that growing it doesn't move existing values
+    std::deque<Slot> mutable slots;
+    std::vector<size_t> free_slots;
+    std::unordered_map<Object const*, size_t> by_address;
+    size_t count{0};
+};
+}
+
+#endif //MIRAL_OBJECT_REGISTRY_H
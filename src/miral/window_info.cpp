@@ -510,3 +510,9 @@ auto miral::WindowInfo::alpha() const -> float
     std::shared_ptr<mir::scene::Surface> const surface = self->window;
     return surface ? surface->alpha() : 1.f;
 }
+
+auto miral::WindowInfo::content_type() const -> MirContentType
+{
+    std::shared_ptr<mir::scene::Surface> const surface = self->window;
+    return surface ? surface->content_type() : mir_content_type_none;
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "workspace_membership.h"
+
+#include <mir/scene/surface.h>
+
+#include <algorithm>
+
+namespace
+{
+template<typename T>
+auto same_owner(std::weak_ptr<T> const& lhs, std::weak_ptr<T> const& rhs) -> bool
+{
+    return !lhs.owner_before(rhs) && !rhs.owner_before(lhs);
+}
+
+void erase_window(std::vector<miral::Window>& windows, std::weak_ptr<mir::scene::Surface> const& surface)
+{
+    std::erase_if(windows, [&](auto const& w) { return same_owner(std::weak_ptr<mir::scene::Surface>(w), surface); });
+}
+}
+
+auto miral::WorkspaceMembership::add(std::shared_ptr<Workspace> const& workspace, Window const& window) -> bool
+{
+    auto const surface = std::shared_ptr<mir::scene::Surface>(window);
+    if (!surface)
+        return false;
+
+    auto* workspaces = workspaces_by_window.find(surface);
+    if (workspaces)
+    {
+        std::weak_ptr<Workspace> const weak_workspace{workspace};
+        for (auto const& w : *workspaces)
+        {
+            if (same_owner(w, weak_workspace))
+                return false;
+        }
+    }
+    else
+    {
+        workspaces = &workspaces_by_window.insert(surface, {});
+    }
+
+    workspaces->push_back(workspace);
+
+    auto* windows = windows_by_workspace.find(workspace);
+    if (!windows)
+        windows = &windows_by_workspace.insert(workspace, {});
+
+    windows->push_back(window);
+    return true;
+}
+
+auto miral::WorkspaceMembership::remove(std::shared_ptr<Workspace> const& workspace, Window const& window) -> bool
+{
+    std::weak_ptr<mir::scene::Surface> const surface{window};
+    auto const workspaces = workspaces_by_window.find(surface);
+    if (!workspaces)
+        return false;
+
+    std::weak_ptr<Workspace> const weak_workspace{workspace};
+    auto const erased = std::erase_if(*workspaces, [&](auto const& w) { return same_owner(w, weak_workspace); });
+    if (!erased)
+        return false;
+
+    if (workspaces->empty())
+        workspaces_by_window.erase(surface);
+
+    if (auto const windows = windows_by_workspace.find(workspace))
+    {
+        erase_window(*windows, surface);
+        if (windows->empty())
+            windows_by_workspace.erase(workspace);
+    }
+
+    return true;
+}
+
+void miral::WorkspaceMembership::remove(Window const& window)
+{
+    std::weak_ptr<mir::scene::Surface> const surface{window};
+    auto const workspaces = workspaces_by_window.find(surface);
+    if (!workspaces)
+        return;
+
+    for (auto const& workspace : *workspaces)
+    {
+        if (auto const windows = windows_by_workspace.find(workspace))
+        {
+            erase_window(*windows, surface);
+            if (windows->empty())
+                windows_by_workspace.erase(workspace);
+        }
+    }
+
+    workspaces_by_window.erase(surface);
+}
+
+auto miral::WorkspaceMembership::take_all(std::shared_ptr<Workspace> const& workspace) -> std::vector<Window>
+{
+    auto const windows = windows_by_workspace.find(workspace);
+    if (!windows)
+        return {};
+
+    auto result = std::move(*windows);
+    windows_by_workspace.erase(workspace);
+
+    std::weak_ptr<Workspace> const weak_workspace{workspace};
+    for (auto const& window : result)
+    {
+        std::weak_ptr<mir::scene::Surface> const surface{window};
+        if (auto const workspaces = workspaces_by_window.find(surface))
+        {
+            std::erase_if(*workspaces, [&](auto const& w) { return same_owner(w, weak_workspace); });
+            if (workspaces->empty())
+                workspaces_by_window.erase(surface);
+        }
+    }
+
+    return result;
+}
+
+void miral::WorkspaceMembership::forget(std::weak_ptr<Workspace> const& workspace)
+{
+    auto const windows = windows_by_workspace.find(workspace);
+    if (!windows)
+        return;
+
+    for (auto const& window : *windows)
+    {
+        std::weak_ptr<mir::scene::Surface> const surface{window};
+        if (auto const workspaces = workspaces_by_window.find(surface))
+        {
+            std::erase_if(*workspaces, [&](auto const& w) { return same_owner(w, workspace); });
+            if (workspaces->empty())
+                workspaces_by_window.erase(surface);
+        }
+    }
+
+    windows_by_workspace.erase(workspace);
+}
+
+auto miral::WorkspaceMembership::windows_in(std::shared_ptr<Workspace> const& workspace) const -> std::vector<Window>
+{
+    auto const windows = windows_by_workspace.find(workspace);
+    return windows ? *windows : std::vector<Window>{};
+}
+
+auto miral::WorkspaceMembership::workspaces_containing(Window const& window) const
+-> std::vector<std::shared_ptr<Workspace>>
+{
+    std::vector<std::shared_ptr<Workspace>> result;
+
+    if (auto const workspaces = workspaces_by_window.find(std::weak_ptr<mir::scene::Surface>(window)))
+    {
+        result.reserve(workspaces->size());
+        for (auto const& workspace : *workspaces)
+        {
+            if (auto const live = workspace.lock())
+                result.push_back(live);
+        }
+    }
+
+    return result;
+}
+
+auto miral::WorkspaceMembership::in_any_of(
+    Window const& window, std::vector<std::shared_ptr<Workspace>> const& workspaces) const -> bool
+{
+    if (auto const containing = workspaces_by_window.find(std::weak_ptr<mir::scene::Surface>(window)))
+    {
+        for (auto const& workspace : *containing)
+        {
+            for (auto const& w : workspaces)
+            {
+                if (same_owner(workspace, std::weak_ptr<Workspace>{w}))
+                    return true;
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_WORKSPACE_MEMBERSHIP_H
+#define MIRAL_WORKSPACE_MEMBERSHIP_H
+
+#include "object_registry.h"
+
+#include <miral/window.h>
+
+#include <memory>
+#include <vector>
+
+namespace mir { namespace scene { class Surface; } }
+
+namespace miral
+{
+class Workspace;
+
+/// Which windows are in which workspaces, indexed both ways
+///
+/// Both windows and workspaces are listed in the order they were added.
+class WorkspaceMembership
+{
+public:
+    /// Adds \p window to \p workspace, returning false if it was there already
+    auto add(std::shared_ptr<Workspace> const& workspace, Window const& window) -> bool;
+
+    /// Removes \p window from \p workspace, returning false if it was not there
+    auto remove(std::shared_ptr<Workspace> const& workspace, Window const& window) -> bool;
+
+    /// Removes \p window from every workspace
+    void remove(Window const& window);
+
+    /// Removes every window from \p workspace, returning them
+    auto take_all(std::shared_ptr<Workspace> const& workspace) -> std::vector<Window>;
+
+    /// Drops a \p workspace that has been destroyed
+    void forget(std::weak_ptr<Workspace> const& workspace);
+
+    auto windows_in(std::shared_ptr<Workspace> const& workspace) const -> std::vector<Window>;
+
+    auto workspaces_containing(Window const& window) const -> std::vector<std::shared_ptr<Workspace>>;
+
+    /// Whether \p window is in any of \p workspaces
+    auto in_any_of(Window const& window, std::vector<std::shared_ptr<Workspace>> const& workspaces) const -> bool;
+
+private:
+    ObjectRegistry<Workspace, std::vector<Window>> windows_by_workspace;
+    ObjectRegistry<mir::scene::Surface, std::vector<std::weak_ptr<Workspace>>> workspaces_by_window;
+};
+}
+
+#endif //MIRAL_WORKSPACE_MEMBERSHIP_H
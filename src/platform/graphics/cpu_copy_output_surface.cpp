@@ -29,7 +29,6 @@
 
 #include <mir/graphics/cpu_copy_output_surface.h>
 #include <mir/graphics/egl_helpers.h>
-#include <cstring>
 
 namespace mg = mir::graphics;
 namespace mgc = mg::common;
@@ -80,31 +79,6 @@ private:
 using RenderbufferHandle = GLHandle<&glGenRenderbuffers, &glDeleteRenderbuffers>;
 using FramebufferHandle = GLHandle<&glGenFramebuffers, &glDeleteFramebuffers>;
 
-auto create_current_context(EGLDisplay dpy, EGLContext share_ctx)
-    -> EGLContext
-{
-    static const EGLint context_attr[] = {
-        EGL_CONTEXT_CLIENT_VERSION, 2,
-        EGL_NONE
-    };
-
-    auto egl_extensions = eglQueryString(dpy, EGL_EXTENSIONS);
-    if (std::strstr(egl_extensions, "EGL_KHR_no_config_context") == nullptr)
-    {
-        // We do not *strictly* need this, but it means I don't need to thread a GLConfig all the way through to here.
-        BOOST_THROW_EXCEPTION((std::runtime_error{"EGL implementation missing necessary EGL_KHR_no_config_context extension"}));
-    }
-
-    eglBindAPI(EGL_OPENGL_ES_API);
-    auto ctx = eglCreateContext(dpy, EGL_NO_CONFIG_KHR, share_ctx, context_attr);
-
-    if (eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx) != EGL_TRUE)
-    {
-        BOOST_THROW_EXCEPTION(mg::egl_error("Failed to make context current"));
-    }
-    return ctx;
-}
-
 auto select_format_from(mg::CPUAddressableDisplayAllocator const& provider) -> mg::DRMFormat
 {
     std::optional<mg::DRMFormat> best_format;
@@ -221,7 +195,7 @@ mgc::CPUCopyOutputSurface::Impl::Impl(
     GLConfig const& config)
     : allocator{allocator},
       dpy{dpy},
-      ctx{create_current_context(dpy, share_ctx)},
+      ctx{mgc::create_current_context(dpy, share_ctx)},
       format{select_format_from(allocator)},
       depth_stencil_buffer{
           (config.depth_buffer_bits() || config.stencil_buffer_bits())
@@ -0,0 +1,245 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <mir/graphics/dmabuf_buffer.h>
+#include <mir/graphics/dmabuf_target_output_surface.h>
+#include <mir/graphics/egl_error.h>
+#include <mir/graphics/egl_extensions.h>
+#include <mir/graphics/egl_helpers.h>
+#include <mir/graphics/linux_dmabuf.h>
+#include <mir/log.h>
+
+#include <boost/throw_exception.hpp>
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace mg = mir::graphics;
+namespace mgc = mg::common;
+namespace geom = mir::geometry;
+
+namespace
+{
+/// The client's buffer, now filled with the rendered frame
+class DmaBufTargetFramebuffer : public mg::Framebuffer
+{
+public:
+    explicit DmaBufTargetFramebuffer(std::shared_ptr<mg::DMABufBuffer> target)
+        : target{std::move(target)}
+    {
+    }
+
+    auto size() const -> geom::Size override
+    {
+        return target->size();
+    }
+
+private:
+    std::shared_ptr<mg::DMABufBuffer> const target;
+};
+}
+
+class mgc::DmaBufTargetOutputSurface::Impl
+{
+public:
+    Impl(
+        EGLDisplay dpy,
+        EGLContext share_ctx,
+        DmaBufTargetDisplayAllocator& allocator);
+
+    ~Impl();
+
+    void bind();
+
+    void make_current();
+    void release_current();
+
+    auto commit() -> std::unique_ptr<mg::Framebuffer>;
+
+    auto size() const -> geom::Size;
+
+private:
+    /* The target changes whenever a capture is requested into a different
+     * client buffer, so import whatever the allocator currently offers if
+     * it isn't already what our framebuffer is attached to.
+     */
+    void ensure_attached_to_current_target();
+    void release_target();
+
+    DmaBufTargetDisplayAllocator& allocator;
+    EGLDisplay const dpy;
+    EGLExtensions const egl_extensions;
+    EGLContext const ctx;
+    GLuint colour_texture{0};
+    GLuint fbo{0};
+    std::shared_ptr<DMABufBuffer> attached_target;
+    EGLImageKHR attached_image{EGL_NO_IMAGE_KHR};
+};
+
+mgc::DmaBufTargetOutputSurface::DmaBufTargetOutputSurface(
+    EGLDisplay dpy,
+    EGLContext share_ctx,
+    DmaBufTargetDisplayAllocator& allocator)
+    : impl{std::make_unique<Impl>(dpy, share_ctx, allocator)}
+{
+}
+
+mgc::DmaBufTargetOutputSurface::~DmaBufTargetOutputSurface() = default;
+
+void mgc::DmaBufTargetOutputSurface::bind()
+{
+    impl->bind();
+}
+
+void mgc::DmaBufTargetOutputSurface::make_current()
+{
+    impl->make_current();
+}
+
+void mgc::DmaBufTargetOutputSurface::release_current()
+{
+    impl->release_current();
+}
+
+auto mgc::DmaBufTargetOutputSurface::commit() -> std::unique_ptr<mg::Framebuffer>
+{
+    return impl->commit();
+}
+
+auto mgc::DmaBufTargetOutputSurface::size() const -> geom::Size
+{
+    return impl->size();
+}
+
+auto mgc::DmaBufTargetOutputSurface::layout() const -> Layout
+{
+    // As for CPUCopyOutputSurface, GL's first row is the bottom row; flip so clients see the top first
+    return Layout::TopRowFirst;
+}
+
+mgc::DmaBufTargetOutputSurface::Impl::Impl(
+    EGLDisplay dpy,
+    EGLContext share_ctx,
+    DmaBufTargetDisplayAllocator& allocator)
+    : allocator{allocator},
+      dpy{dpy},
+      ctx{create_current_context(dpy, share_ctx)}
+{
+    glGenTextures(1, &colour_texture);
+    glGenFramebuffers(1, &fbo);
+}
+
+mgc::DmaBufTargetOutputSurface::Impl::~Impl()
+{
+    std::optional<CacheEglState> restore_egl_state;
+    if (ctx != eglGetCurrentContext())
+    {
+        restore_egl_state.emplace();
+        make_current();
+    }
+
+    release_target();
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &colour_texture);
+
+    release_current();
+    eglDestroyContext(dpy, ctx);
+}
+
+void mgc::DmaBufTargetOutputSurface::Impl::ensure_attached_to_current_target()
+{
+    auto target = allocator.current_target();
+    if (target == attached_target)
+    {
+        return;
+    }
+
+    release_target();
+
+    attached_image = mg::import_egl_image(dpy, egl_extensions, *target);
+    attached_target = std::move(target);
+
+    glBindTexture(GL_TEXTURE_2D, colour_texture);
+    egl_extensions.base(dpy).glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, attached_image);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colour_texture, 0);
+
+    if (auto const status = glCheckFramebufferStatus(GL_FRAMEBUFFER); status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        release_target();
+        BOOST_THROW_EXCEPTION((
+            std::runtime_error{
+                "Capture target DMA-BUF is not renderable (GL framebuffer status: " + std::to_string(status) + ")"}));
+    }
+}
+
+void mgc::DmaBufTargetOutputSurface::Impl::release_target()
+{
+    if (attached_image != EGL_NO_IMAGE_KHR)
+    {
+        egl_extensions.base(dpy).eglDestroyImageKHR(dpy, attached_image);
+        attached_image = EGL_NO_IMAGE_KHR;
+    }
+    attached_target.reset();
+}
+
+void mgc::DmaBufTargetOutputSurface::Impl::bind()
+{
+    ensure_attached_to_current_target();
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+}
+
+void mgc::DmaBufTargetOutputSurface::Impl::make_current()
+{
+    if (eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx) != EGL_TRUE)
+    {
+        mir::log_debug("Failed to make EGL context current");
+    }
+}
+
+void mgc::DmaBufTargetOutputSurface::Impl::release_current()
+{
+    if (eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) != EGL_TRUE)
+    {
+        mir::log_debug("Failed to release current EGL context");
+    }
+}
+
+auto mgc::DmaBufTargetOutputSurface::Impl::commit() -> std::unique_ptr<mg::Framebuffer>
+{
+    /* The client has no way to wait on our rendering, so it must be complete
+     * before we report the capture as done.
+     */
+    glFinish();
+    auto fb = std::make_unique<DmaBufTargetFramebuffer>(attached_target);
+    // Each capture supplies a fresh target; don't pin the client's buffer between them
+    release_target();
+    return fb;
+}
+
+auto mgc::DmaBufTargetOutputSurface::Impl::size() const -> geom::Size
+{
+    return allocator.output_size();
+}
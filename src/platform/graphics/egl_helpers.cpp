@@ -15,8 +15,16 @@
  */
 
 #include <mir/graphics/egl_helpers.h>
+#include <mir/graphics/egl_error.h>
+
+#include <EGL/eglext.h>
+#include <boost/throw_exception.hpp>
+
+#include <cstring>
+#include <stdexcept>
 #include <utility>
 
+namespace mg = mir::graphics;
 namespace mgc = mir::graphics::common;
 
 mgc::CacheEglState::CacheEglState()
@@ -51,3 +59,27 @@ mgc::CacheEglState::~CacheEglState()
         eglMakeCurrent(dpy, draw_surf, read_surf, ctx);
     }
 }
+
+auto mgc::create_current_context(EGLDisplay dpy, EGLContext share_ctx) -> EGLContext
+{
+    static const EGLint context_attr[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE
+    };
+
+    auto egl_extensions = eglQueryString(dpy, EGL_EXTENSIONS);
+    if (std::strstr(egl_extensions, "EGL_KHR_no_config_context") == nullptr)
+    {
+        // We do not *strictly* need this, but it means I don't need to thread a GLConfig all the way through to here.
+        BOOST_THROW_EXCEPTION((std::runtime_error{"EGL implementation missing necessary EGL_KHR_no_config_context extension"}));
+    }
+
+    eglBindAPI(EGL_OPENGL_ES_API);
+    auto ctx = eglCreateContext(dpy, EGL_NO_CONFIG_KHR, share_ctx, context_attr);
+
+    if (eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx) != EGL_TRUE)
+    {
+        BOOST_THROW_EXCEPTION(mg::egl_error("Failed to make context current"));
+    }
+    return ctx;
+}
@@ -1498,6 +1498,20 @@ auto mg::DMABufEGLProvider::devnum() const -> dev_t
     return devnum_;
 }
 
+auto mg::import_egl_image(
+    EGLDisplay dpy,
+    EGLExtensions const& egl_extensions,
+    DMABufBuffer const& dma_buf) -> EGLImageKHR
+{
+    return ::import_egl_image(
+        dma_buf.size().width.as_int(), dma_buf.size().height.as_int(),
+        dma_buf.format(),
+        dma_buf.modifier(),
+        dma_buf.planes(),
+        dpy,
+        egl_extensions);
+}
+
 auto mg::DMABufEGLProvider::supported_formats() const -> mg::DmaBufFormatDescriptors const&
 {
     return *formats;
@@ -0,0 +1,72 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mir/graphics/scaled_cursor_image_cache.h>
+#include <mir/graphics/pixman_image_scaling.h>
+#include <mir/graphics/shm_buffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace mg = mir::graphics;
+namespace mgc = mir::graphics::common;
+
+mg::ScaledCursorImageCache::ScaledCursorImageCache(size_t capacity)
+    : capacity{std::max<size_t>(capacity, 1)}
+{
+}
+
+auto mg::ScaledCursorImageCache::buffer_for(std::shared_ptr<CursorImage> const& image, float scale)
+    -> std::shared_ptr<mgc::MemoryBackedShmBuffer>
+{
+    // An expired weak_ptr still holds its control block, so no live image can be mistaken for it
+    auto const same_image = [&image](Entry const& entry)
+        {
+            return !entry.image.owner_before(image) && !image.owner_before(entry.image);
+        };
+
+    auto const hit = std::find_if(entries.begin(), entries.end(),
+        [&](Entry const& entry) { return entry.scale == scale && same_image(entry); });
+
+    if (hit != entries.end())
+    {
+        // Move to the back, as the most recently used
+        std::rotate(hit, hit + 1, entries.end());
+        return entries.back().buffer;
+    }
+
+    auto const scaled = scale_cursor_image(*image, scale);
+    auto const buffer = std::make_shared<mgc::MemoryBackedShmBuffer>(
+        scaled.size, mir_pixel_format_argb_8888, mir::memory::Category::cursor_image);
+    std::memcpy(
+        buffer->map_writeable()->data(),
+        scaled.data.get(),
+        scaled.size.width.as_value() * scaled.size.height.as_value() * 4);
+
+    std::erase_if(entries, [](Entry const& entry) { return entry.image.expired(); });
+    if (entries.size() >= capacity)
+    {
+        entries.erase(entries.begin());
+    }
+    entries.push_back(Entry{image, scale, buffer});
+
+    return buffer;
+}
+
+void mg::ScaledCursorImageCache::clear()
+{
+    entries.clear();
+}
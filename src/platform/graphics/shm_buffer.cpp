@@ -20,6 +20,7 @@
 #include <mir/graphics/shm_buffer.h>
 #include <mir/graphics/program_factory.h>
 #include <mir/graphics/egl_context_executor.h>
+#include <mir/memory_accounting.h>
 
 #define MIR_LOG_COMPONENT "gfx-common"
 #include <mir/log.h>
@@ -190,6 +191,8 @@ public:
             glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0);     // 0 is default, meaning “use width”
             glPixelStorei(GL_UNPACK_ALIGNMENT, 4);          // 4 is default; word alignment.
             glFinish();
+
+            texture_memory.reset(size.width.as_uint32_t() * size.height.as_uint32_t() * MIR_BYTES_PER_PIXEL(pixel_format));
         }
         else
         {
@@ -213,6 +216,7 @@ private:
     GLuint tex_id_;
     std::mutex uploaded_mutex;
     bool uploaded = false;
+    mir::memory::Allocation texture_memory{mir::memory::Category::shm_texture, mir::memory::no_client, 0};
 };
 
 
@@ -271,9 +275,18 @@ void mgc::ShmBuffer::on_texture_accessed(std::shared_ptr<ShmBufferTexture> const
 mgc::MemoryBackedShmBuffer::MemoryBackedShmBuffer(
     geom::Size const& size,
     MirPixelFormat const& pixel_format)
+    : MemoryBackedShmBuffer(size, pixel_format, memory::Category::software_buffer)
+{
+}
+
+mgc::MemoryBackedShmBuffer::MemoryBackedShmBuffer(
+    geom::Size const& size,
+    MirPixelFormat const& pixel_format,
+    memory::Category category)
     : ShmBuffer(size, pixel_format),
       stride_{MIR_BYTES_PER_PIXEL(pixel_format) * size.width.as_uint32_t()},
-      pixels{std::make_unique<std::byte[]>(stride_.as_int() * size.height.as_int())}
+      pixels{std::make_unique<std::byte[]>(stride_.as_int() * size.height.as_int())},
+      accounted{category, memory::no_client, static_cast<size_t>(stride_.as_int() * size.height.as_int())}
 {
 }
 
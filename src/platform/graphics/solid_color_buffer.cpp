@@ -0,0 +1,153 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mir/graphics/solid_color_buffer.h>
+#include <mir/graphics/program_factory.h>
+#include <mir/renderer/sw/pixel_source.h>
+
+#include <GLES2/gl2.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+namespace mrs = mir::renderer::software;
+
+namespace
+{
+auto to_argb_8888(glm::vec4 color) -> uint32_t
+{
+    auto const channel = [](float value, int shift)
+        {
+            return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f) << shift;
+        };
+
+    return channel(color.a, 24) | channel(color.r, 16) | channel(color.g, 8) | channel(color.b, 0);
+}
+
+class PixelMapping : public mrs::Mapping<std::byte const>
+{
+public:
+    explicit PixelMapping(uint32_t const* pixel)
+        : pixel{pixel}
+    {
+    }
+
+    auto data() const -> std::byte const* override { return reinterpret_cast<std::byte const*>(pixel); }
+    auto len() const -> size_t override { return sizeof(*pixel); }
+    auto format() const -> MirPixelFormat override { return mir_pixel_format_argb_8888; }
+    auto stride() const -> geom::Stride override { return geom::Stride{sizeof(*pixel)}; }
+    auto size() const -> geom::Size override { return {1, 1}; }
+
+private:
+    uint32_t const* const pixel;
+};
+
+/// The location of the colour uniform in the program the renderer has made current
+///
+/// The renderer links an opaque and an alpha variant of our shader per rendering thread, so each thread only
+/// ever looks up a couple of locations, once each.
+auto solid_color_location() -> GLint
+{
+    thread_local std::vector<std::pair<GLint, GLint>> locations;
+    thread_local std::pair<GLint, GLint> last{0, -1};
+
+    GLint program{0};
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+    if (program == last.first)
+    {
+        return last.second;
+    }
+
+    auto const cached = std::ranges::find(locations, program, &std::pair<GLint, GLint>::first);
+    if (cached != locations.end())
+    {
+        last = *cached;
+    }
+    else
+    {
+        last = locations.emplace_back(program, glGetUniformLocation(program, "solid_color"));
+    }
+    return last.second;
+}
+}
+
+mg::SolidColorBuffer::SolidColorBuffer(glm::vec4 color)
+    : color_{color},
+      pixel{to_argb_8888(color)}
+{
+}
+
+auto mg::SolidColorBuffer::color() const -> glm::vec4
+{
+    return color_;
+}
+
+auto mg::SolidColorBuffer::size() const -> geom::Size
+{
+    return {1, 1};
+}
+
+auto mg::SolidColorBuffer::pixel_format() const -> MirPixelFormat
+{
+    return color_.a < 1.0f ? mir_pixel_format_argb_8888 : mir_pixel_format_xrgb_8888;
+}
+
+auto mg::SolidColorBuffer::native_buffer_base() -> NativeBufferBase*
+{
+    return this;
+}
+
+auto mg::SolidColorBuffer::map_readable() const -> std::unique_ptr<mrs::Mapping<std::byte const>>
+{
+    return std::make_unique<PixelMapping>(&pixel);
+}
+
+auto mg::SolidColorBuffer::shader(gl::ProgramFactory& factory) const -> gl::Program const&
+{
+    static int solid_color_shader{0};
+    return factory.compile_fragment_shader(
+        &solid_color_shader,
+        "",
+        "uniform vec4 solid_color;\n"
+        "vec4 sample_to_rgba(in vec2 texcoord)\n"
+        "{\n"
+        "    return solid_color;\n"
+        "}\n");
+}
+
+auto mg::SolidColorBuffer::layout() const -> Layout
+{
+    return Layout::TopRowFirst;
+}
+
+void mg::SolidColorBuffer::bind()
+{
+    // The renderer has made our program current before binding; there is no texture to bind, only the colour
+    glUniform4fv(solid_color_location(), 1, glm::value_ptr(color_));
+}
+
+auto mg::SolidColorBuffer::tex_id() const -> GLuint
+{
+    return 0;
+}
+
+void mg::SolidColorBuffer::add_syncpoint()
+{
+}
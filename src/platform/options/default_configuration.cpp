@@ -43,6 +43,10 @@ char const* const mo::input_report_opt            = "input-report";
 char const* const mo::seat_report_opt            = "seat-report";
 char const* const mo::shared_library_prober_report_opt = "shared-library-prober-report";
 char const* const mo::shell_report_opt            = "shell-report";
+char const* const mo::startup_report_opt          = "startup-report";
+char const* const mo::memory_report_opt           = "memory-report";
+char const* const mo::client_memory_budget_opt    = "client-memory-budget";
+char const* const mo::client_memory_budget_action_opt = "client-memory-budget-action";
 char const* const mo::touchspots_opt              = "enable-touchspots";
 char const* const mo::cursor_opt                  = "cursor";
 char const* const mo::debug_opt                   = "debug";
@@ -64,6 +68,7 @@ char const* const mo::platform_display_libs = "platform-display-libs";
 char const* const mo::platform_rendering_libs = "platform-rendering-libs";
 char const* const mo::platform_input_lib = "platform-input-lib";
 char const* const mo::platform_path = "platform-path";
+char const* const mo::platform_probe_cache_opt = "platform-probe-cache";
 
 char const* const mo::console_provider = "console-provider";
 char const* const mo::logind_console = "logind";
@@ -202,6 +207,9 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "If not provided this is autodetected.")
         (platform_path, po::value<std::string>()->default_value(MIR_SERVER_PLATFORM_PATH),
             "Directory to look for platform libraries.")
+        (platform_probe_cache_opt, po::value<std::string>(),
+            "File in which to remember the display platforms selected, so that later starts on an unchanged "
+            "system need only probe those. If not provided every platform is probed at each start.")
         (enable_input_opt, po::value<bool>()->default_value(enable_input_default),
             "Enable input.")
         (compositor_report_opt, po::value<std::string>()->default_value(off_opt_value),
@@ -218,6 +226,17 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "Configure shared library prober reporting. [{log,off,lttng}]")
         (shell_report_opt, po::value<std::string>()->default_value(off_opt_value),
             "Configure shell reporting. [{off,log}]")
+        (startup_report_opt, po::value<std::string>()->default_value(off_opt_value),
+            "Configure reporting of the time taken by each phase of startup. [{off,log,lttng}]")
+        (memory_report_opt, po::value<std::string>()->default_value(off_opt_value),
+            "Configure reporting of memory usage, by category and by client. "
+            "Usage is reported on SIGUSR2. [{off,log,lttng}]")
+        (client_memory_budget_opt, po::value<int>()->default_value(0),
+            "The most memory, in MiB, that the server will map for a single client's shared memory pools "
+            "(0 for no limit). Clients are identified by process, so all X11 apps share Xwayland's budget.")
+        (client_memory_budget_action_opt, po::value<std::string>()->default_value("warn"),
+            "What to do when a client exceeds --client-memory-budget. [{warn,disconnect}] "
+            "Disconnecting Xwayland disconnects every X11 app.")
         (composite_delay_opt, po::value<int>()->default_value(0),
             "Number of milliseconds to wait for new frames from clients before compositing. "
             "Higher values result in higher latency but risk causing frame skipping.")
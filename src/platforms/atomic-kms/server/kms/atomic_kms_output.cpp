@@ -40,8 +40,19 @@ namespace mga = mg::atomic;
 namespace mgk = mg::kms;
 namespace geom = mir::geometry;
 
+#ifndef DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP
+// Added in Linux 6.8; older headers don't know about it
+#define DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP 0x15
+#endif
+
 namespace
 {
+auto supports_atomic_async_flip(mir::Fd const& drm_fd) -> bool
+{
+    uint64_t supported{0};
+    return drmGetCap(drm_fd, DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP, &supported) == 0 && supported;
+}
+
 bool kms_modes_are_equal(drmModeModeInfo const* info1, drmModeModeInfo const* info2)
 {
     return (info1 && info2) &&
@@ -189,6 +200,7 @@ mga::AtomicKMSOutput::AtomicKMSOutput(
     mir::Fd drm_master,
     kms::DRMModeConnectorUPtr connector)
     : drm_fd_{drm_master},
+      async_flip_supported{supports_atomic_async_flip(drm_fd_)},
       configuration{
           Configuration {
           .connector = std::move(connector),
@@ -478,6 +490,50 @@ bool mga::AtomicKMSOutput::page_flip(FBHandle const& fb)
     return true;
 }
 
+bool mga::AtomicKMSOutput::async_page_flip(FBHandle const& fb)
+{
+    if (!async_flip_supported)
+    {
+        return false;
+    }
+
+    auto conf = configuration.lock();
+    if (!conf->current_crtc || using_saved_crtc)
+    {
+        // Nothing of ours is on the plane yet; the first flip has to set up everything else
+        return false;
+    }
+
+    if ((conf->current_crtc->width != fb.size().width.as_uint32_t()) ||
+        (conf->current_crtc->height != fb.size().height.as_uint32_t()))
+    {
+        return false;
+    }
+
+    /* The kernel rejects asynchronous commits that change anything but the
+     * framebuffer, so this relies on page_flip() having set up the rest of
+     * the plane state.
+     */
+    AtomicUpdate update;
+    update.add_property(*conf->plane_props, "FB_ID", fb);
+
+    /* The driver may reject an asynchronous flip to a particular framebuffer (for example,
+     * if its modifier, pitch or format differs from the last) while accepting later ones, so
+     * a rejection only means this frame has to wait for vblank.
+     */
+    if (auto const ret = drmModeAtomicCommit(drm_fd_, update, DRM_MODE_PAGE_FLIP_ASYNC, nullptr))
+    {
+        mir::log_debug(
+            "Output %s rejected an asynchronous page flip (%s (%i)); flipping on vblank instead",
+            mgk::connector_name(conf->connector).c_str(),
+            mir::errno_to_cstr(-ret),
+            -ret);
+        return false;
+    }
+
+    return true;
+}
+
 void mga::AtomicKMSOutput::set_cursor_image(gbm_bo* buffer)
 {
     if (auto conf = configuration.lock(); conf->current_crtc)
@@ -53,6 +53,7 @@ public:
     bool has_crtc_mismatch() override;
     void clear_crtc() override;
     bool page_flip(FBHandle const& fb) override;
+    bool async_page_flip(FBHandle const& fb) override;
 
     void set_cursor_image(gbm_bo* buffer) override;
     void move_cursor(geometry::Point destination) override;
@@ -87,6 +88,8 @@ private:
     void restore_saved_crtc();
 
     mir::Fd const drm_fd_;
+    /// Whether the driver reports DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP; if not, we don't try
+    bool const async_flip_supported;
 
     std::future<void> pending_page_flip;
 
@@ -22,7 +22,6 @@
 #include <mir/graphics/shm_buffer.h>
 #include <mir/geometry/rectangle.h>
 #include <mir/graphics/cursor_image.h>
-#include <mir/graphics/pixman_image_scaling.h>
 
 #include <xf86drm.h>
 
@@ -264,14 +263,8 @@ void mga::Cursor::show(std::shared_ptr<CursorImage> const& cursor_image)
 
     current_cursor_image = cursor_image;
 
-    auto const scaled_cursor_buf = mg::scale_cursor_image(*current_cursor_image, current_scale);
-    auto const buf_size_bytes = scaled_cursor_buf.size.width.as_value() * scaled_cursor_buf.size.height.as_value() * 4;
-    size = scaled_cursor_buf.size;
-
-    buffer = std::make_shared<mgc::MemoryBackedShmBuffer>(
-        size,
-        mir_pixel_format_argb_8888);
-    std::memcpy(buffer->map_writeable()->data(), scaled_cursor_buf.data.get(), buf_size_bytes);
+    buffer = scaled_images.buffer_for(current_cursor_image, current_scale);
+    size = buffer->size();
 
     hotspot = current_cursor_image->hotspot() * current_scale;
     {
@@ -454,6 +447,10 @@ void mir::graphics::atomic::Cursor::scale(float new_scale)
 {
     {
         std::lock_guard lg(guard);
+        if (new_scale != current_scale)
+        {
+            scaled_images.clear();
+        }
         current_scale = new_scale;
     }
 
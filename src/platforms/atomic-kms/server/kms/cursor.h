@@ -19,6 +19,7 @@
 #define MIR_GRAPHICS_ATOMIC_CURSOR_H_
 
 #include <mir/graphics/cursor.h>
+#include <mir/graphics/scaled_cursor_image_cache.h>
 
 #include <mir_toolkit/common.h>
 #include <mir/synchronised.h>
@@ -145,6 +146,7 @@ private:
 
     std::shared_ptr<CursorImage> current_cursor_image;
     float current_scale{1.0};
+    ScaledCursorImageCache scaled_images;
 };
 }
 }
@@ -47,13 +47,40 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 
+#include <algorithm>
+#include <iterator>
+#include <optional>
 #include <stdexcept>
+#include <tuple>
 
 namespace mga = mir::graphics::atomic;
 namespace mg = mir::graphics;
 
 namespace
 {
+/// Whether out is to be shown, and so needs a DisplaySink
+auto needs_sink(mg::DisplayConfigurationOutput const& out) -> bool
+{
+    return out.connected && out.used &&
+        (out.power_mode == mir_power_mode_on) &&
+        (out.current_mode_index < out.modes.size());
+}
+
+/// Whether out has different gamma curves to those of the same output in conf
+auto gamma_changed(mg::DisplayConfigurationOutput const& out, mg::DisplayConfiguration const& conf) -> bool
+{
+    bool changed{true};
+    conf.for_each_output([&](mg::DisplayConfigurationOutput const& current)
+        {
+            if (current.id == out.id)
+            {
+                changed = std::tie(current.gamma.red, current.gamma.green, current.gamma.blue) !=
+                    std::tie(out.gamma.red, out.gamma.green, out.gamma.blue);
+            }
+        });
+    return changed;
+}
+
 double calculate_vrefresh_hz(drmModeModeInfo const& mode)
 {
     if (mode.htotal == 0 || mode.vtotal == 0)
@@ -172,8 +199,8 @@ void mga::Display::for_each_display_sync_group(
 {
     std::lock_guard lg{configuration_mutex};
 
-    for (auto& db_ptr : display_sinks)
-        f(*db_ptr);
+    for (auto& [_, sink] : display_sinks)
+        f(*sink);
 }
 
 std::unique_ptr<mg::DisplayConfiguration> mga::Display::configuration() const
@@ -239,8 +266,8 @@ void mga::Display::resume()
          * we need to reset the CRTCs. For active displays we schedule a CRTC reset
          * on the next swap. For connected but unused outputs we clear the CRTC.
          */
-        for (auto& db_ptr : display_sinks)
-            db_ptr->schedule_set_crtc();
+        for (auto& [_, sink] : display_sinks)
+            sink->schedule_set_crtc();
 
         clear_connected_unused_outputs();
     }
@@ -333,7 +360,7 @@ void mga::Display::configure_locked(
     bool const comp{
         (&kms_conf != &current_display_configuration) &&
         compatible(kms_conf, current_display_configuration)};
-    std::vector<std::unique_ptr<DisplaySink>> display_buffers_new;
+    std::vector<OutputSink> display_buffers_new;
 
     if (!comp)
     {
@@ -347,13 +374,10 @@ void mga::Display::configure_locked(
             });
     }
 
-    size_t output_idx{0};
     kms_conf.for_each_output(
         [&](DisplayConfigurationOutput const& out)
         {
-            if (!out.connected || !out.used ||
-                (out.power_mode != mir_power_mode_on) ||
-                (out.current_mode_index >= out.modes.size()))
+            if (!needs_sink(out))
             {
                 // We don't need to do anything for unconfigured outputs
                 return;
@@ -376,14 +400,10 @@ void mga::Display::configure_locked(
             {
                 /* If we don't need a modeset we can just
                  * update our existing `DisplaySink`s.
-                 *
-                 * Note: this assumes that RealKMSDisplayConfiguration.for_each_output
-                 * iterates over outputs in the same order each time.
                  */
-                display_sinks[output_idx]->set_transformation(
+                std::ranges::find(display_sinks, out.id, &OutputSink::output)->sink->set_transformation(
                     transform,
                     out.extents());
-                ++output_idx;
             }
             else
             {
@@ -400,7 +420,7 @@ void mga::Display::configure_locked(
                     transform,
                     gbm_quirks);
 
-                display_buffers_new.push_back(std::move(db));
+                display_buffers_new.push_back({out.id, std::move(db)});
             }
         });
 
@@ -415,6 +435,119 @@ void mga::Display::configure_locked(
         clear_connected_unused_outputs();
 }
 
+void mga::Display::configure_incrementally(
+    mg::DisplayConfiguration const& conf,
+    std::function<void(graphics::DisplaySyncGroup&)> const& removing)
+{
+    if (!conf.valid())
+    {
+        BOOST_THROW_EXCEPTION(
+            std::logic_error("Invalid or inconsistent display configuration"));
+    }
+
+    auto const& kms_conf = dynamic_cast<RealKMSDisplayConfiguration const&>(conf);
+
+    std::vector<DisplaySink*> doomed;
+    {
+        std::lock_guard lock{configuration_mutex};
+        for (auto const& [output, sink] : display_sinks)
+        {
+            if (!can_keep_sink(output, kms_conf, lock))
+                doomed.push_back(sink.get());
+        }
+    }
+
+    /* Whoever is using the sinks we're replacing must be done with them before we touch their outputs.
+     * This is called without the lock held, as they may need it to finish up.
+     */
+    for (auto const sink : doomed)
+        removing(*sink);
+
+    std::lock_guard lock{configuration_mutex};
+    std::erase_if(display_sinks, [&doomed](OutputSink const& s) { return std::ranges::contains(doomed, s.sink.get()); });
+
+    std::vector<OutputSink> display_sinks_new;
+    kms_conf.for_each_output(
+        [&](DisplayConfigurationOutput const& out)
+        {
+            auto const kept = std::ranges::find(display_sinks, out.id, &OutputSink::output);
+            auto kms_output = kms_conf.get_output_for(out.id);
+
+            if (kept != display_sinks.end())
+            {
+                /* The output's mode and power are unchanged: just update the existing sink.
+                 * compatible() ignores gamma, so that may have changed.
+                 */
+                kms_output->configure({0, 0}, kms_conf.get_kms_mode_index(out.id, out.current_mode_index));
+                if (gamma_changed(out, current_display_configuration))
+                    kms_output->set_gamma(out.gamma);
+                kept->sink->set_transformation(out.transformation(), out.extents());
+                return;
+            }
+
+            /* Only the outputs that are changing are reset, the others keep displaying */
+            kms_output->clear_cursor();
+            kms_output->reset();
+
+            if (!needs_sink(out))
+                return;
+
+            kms_output->configure({0, 0}, kms_conf.get_kms_mode_index(out.id, out.current_mode_index));
+            kms_output->set_power_mode(out.power_mode);
+            kms_output->set_gamma(out.gamma);
+
+            auto const transform = out.transformation();
+            display_sinks_new.push_back(
+                {
+                    out.id,
+                    std::make_unique<DisplaySink>(
+                        drm_fd,
+                        gbm,
+                        bypass_option,
+                        listener,
+                        std::move(kms_output),
+                        out.extents(),
+                        transform,
+                        gbm_quirks)
+                });
+        });
+
+    std::ranges::move(display_sinks_new, std::back_inserter(display_sinks));
+
+    /* Store applied configuration */
+    current_display_configuration = kms_conf;
+
+    /* Clear connected but unused outputs */
+    clear_connected_unused_outputs();
+}
+
+auto mga::Display::can_keep_sink(
+    DisplayConfigurationOutputId output,
+    RealKMSDisplayConfiguration const& conf,
+    std::lock_guard<std::mutex> const&) const -> bool
+{
+    std::optional<DisplayConfigurationOutput> current;
+    current_display_configuration.for_each_output([&](DisplayConfigurationOutput const& out)
+        {
+            if (out.id == output)
+                current = out;
+        });
+
+    std::optional<DisplayConfigurationOutput> next;
+    conf.for_each_output([&](DisplayConfigurationOutput const& out)
+        {
+            if (out.id == output)
+                next = out;
+        });
+
+    if (!current || !next || !needs_sink(*next))
+        return false;
+
+    // The sink can follow its output to a new position in the layout
+    current->top_left = next->top_left;
+    return compatible(*current, *next);
+}
+
 namespace
 {
 auto gbm_create_device_checked(mir::Fd fd) -> std::shared_ptr<struct gbm_device>
@@ -72,6 +72,9 @@ public:
     std::unique_ptr<DisplayConfiguration> configuration() const override;
     bool apply_if_configuration_preserves_display_buffers(DisplayConfiguration const& conf) override;
     void configure(DisplayConfiguration const& conf) override;
+    void configure_incrementally(
+        DisplayConfiguration const& conf,
+        std::function<void(graphics::DisplaySyncGroup&)> const& removing) override;
 
     void register_configuration_change_handler(
         EventHandlerRegister& handlers,
@@ -91,7 +94,12 @@ private:
     std::shared_ptr<DisplayReport> const listener;
     mir::udev::Monitor monitor;
     std::shared_ptr<KMSOutputContainer> const output_container;
-    std::vector<std::unique_ptr<DisplaySink>> display_sinks;
+    struct OutputSink
+    {
+        DisplayConfigurationOutputId output;
+        std::unique_ptr<DisplaySink> sink;
+    };
+    std::vector<OutputSink> display_sinks;
     mutable RealKMSDisplayConfiguration current_display_configuration;
     mutable std::atomic<bool> dirty_configuration;
 
@@ -99,6 +107,12 @@ private:
         RealKMSDisplayConfiguration const& conf,
         std::lock_guard<decltype(configuration_mutex)> const&);
 
+    /// Whether the sink driving output can be kept, unchanged but for its transformation, to apply conf
+    auto can_keep_sink(
+        DisplayConfigurationOutputId output,
+        RealKMSDisplayConfiguration const& conf,
+        std::lock_guard<decltype(configuration_mutex)> const&) const -> bool;
+
     BypassOption bypass_option;
     std::weak_ptr<Cursor> cursor;
     std::shared_ptr<GbmQuirks> const gbm_quirks;
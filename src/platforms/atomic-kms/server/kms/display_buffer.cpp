@@ -130,6 +130,7 @@ bool mga::DisplaySink::overlay(std::vector<DisplayElement> const& renderable_lis
     if (auto fb = std::dynamic_pointer_cast<graphics::FBHandle>(renderable_list[0].buffer))
     {
         next_swap = std::move(fb);
+        next_swap_allows_tearing = renderable_list[0].allow_tearing;
         return true;
     }
     return false;
@@ -170,10 +171,18 @@ void mga::DisplaySink::post()
     next_swap = nullptr;
 
     /*
-     * Try to schedule a page flip as first preference to avoid tearing.
+     * A fullscreen client that has asked for the lowest latency gets its
+     * buffer flipped to immediately, tearing if necessary.
+     */
+    bool const flipped_async =
+        !needs_set_crtc && next_swap_allows_tearing && output->async_page_flip(*scheduled_fb);
+    next_swap_allows_tearing = false;
+
+    /*
+     * Otherwise try to schedule a page flip as first preference to avoid tearing.
      * We wait synchronously for this to complete.
      */
-    if (!needs_set_crtc && !output->page_flip(*scheduled_fb))
+    if (!needs_set_crtc && !flipped_async && !output->page_flip(*scheduled_fb))
         needs_set_crtc = true;
 
     /*
@@ -202,7 +211,8 @@ void mga::DisplaySink::post()
 
     recommend_sleep = 0ms;
     auto const min_frame_interval = 1000ms / output->max_refresh_rate();
-    if (predicted_render_time < min_frame_interval)
+    // Nothing waited for vblank, so there is no frame interval to pace ourselves against
+    if (!flipped_async && predicted_render_time < min_frame_interval)
         recommend_sleep = min_frame_interval - predicted_render_time;
 }
 
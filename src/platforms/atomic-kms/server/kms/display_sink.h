@@ -130,6 +130,7 @@ private:
     std::shared_ptr<FBHandle const> next_swap{nullptr};    //< Next frame to submit to the hardware
     std::shared_ptr<FBHandle const> scheduled_fb{nullptr}; //< Frame currently submitted to the hardware, not yet on-screen
     std::shared_ptr<FBHandle const> visible_fb{nullptr};   //< Frame currently onscreen
+    bool next_swap_allows_tearing{false};                  //< next_swap may be flipped to without waiting for vblank
 
     geometry::Rectangle area;
     glm::mat2 transform;
@@ -72,6 +72,15 @@ public:
 
     virtual bool page_flip(FBHandle const& fb) = 0;
 
+    /**
+     * Flip to fb without waiting for vblank, accepting that this may tear.
+     *
+     * Only the framebuffer may change from the previous flip.
+     * @returns false if the driver cannot flip asynchronously, or rejects this flip; the caller should then
+     *          page_flip() instead.
+     */
+    virtual bool async_page_flip(FBHandle const& fb) = 0;
+
     virtual void set_cursor_image(gbm_bo* buffer) = 0;
     virtual void move_cursor(geometry::Point destination) = 0;
     virtual bool clear_cursor() = 0;
@@ -33,6 +33,8 @@ class KMSOutputContainer;
 class RealKMSDisplayConfiguration : public KMSDisplayConfiguration
 {
 friend bool compatible(RealKMSDisplayConfiguration const& conf1, RealKMSDisplayConfiguration const& conf2);
+/// Whether output1 can be attained from output2 (and vice versa) without recreating its DisplaySink
+bool compatible(DisplayConfigurationOutput const& output1, DisplayConfigurationOutput const& output2);
 
 public:
     RealKMSDisplayConfiguration(std::shared_ptr<KMSOutputContainer> const& displays);
@@ -57,6 +59,8 @@ private:
 };
 
 bool compatible(RealKMSDisplayConfiguration const& conf1, RealKMSDisplayConfiguration const& conf2);
+/// Whether output1 can be attained from output2 (and vice versa) without recreating its DisplaySink
+bool compatible(DisplayConfigurationOutput const& output1, DisplayConfigurationOutput const& output2);
 
 }
 }
@@ -37,6 +37,7 @@
 #include <mir/graphics/drm_formats.h>
 #include <mir/graphics/egl_error.h>
 #include <mir/graphics/cpu_copy_output_surface.h>
+#include <mir/graphics/dmabuf_target_output_surface.h>
 #include "surfaceless_egl_context.h"
 #include <mir/graphics/drm_syncobj.h>
 
@@ -498,6 +499,13 @@ auto mgg::GLRenderingProvider::suitability_for_display(
         }
     }
 
+    // Without EGL_EXT_image_dma_buf_import (and so a dmabuf_provider) we fall back to copying via the CPU
+    if (dmabuf_provider && sink.acquire_compatible_allocator<DmaBufTargetDisplayAllocator>())
+    {
+        // We can render straight into any DMA-BUF we can import
+        return probe::supported;
+    }
+
     if (sink.acquire_compatible_allocator<CPUAddressableDisplayAllocator>())
     {
         // We *can* render to CPU buffers, but if anyone can do better, let them.
@@ -528,6 +536,13 @@ auto mgg::GLRenderingProvider::surface_for_sink(
             }
         }
     }
+    if (dmabuf_provider)
+    {
+        if (auto dmabuf_allocator = sink.acquire_compatible_allocator<DmaBufTargetDisplayAllocator>())
+        {
+            return std::make_unique<mgc::DmaBufTargetOutputSurface>(dpy, ctx, *dmabuf_allocator);
+        }
+    }
     auto cpu_allocator = sink.acquire_compatible_allocator<CPUAddressableDisplayAllocator>();
 
     return std::make_unique<mgc::CPUCopyOutputSurface>(
@@ -19,6 +19,7 @@
 #define MIR_GRAPHICS_GBM_CURSOR_H_
 
 #include <mir/graphics/cursor.h>
+#include <mir/graphics/scaled_cursor_image_cache.h>
 #include <mir/geometry/point.h>
 #include <mir/geometry/displacement.h>
 
@@ -146,6 +147,7 @@ private:
 
     std::shared_ptr<CursorImage> current_cursor_image;
     float current_scale{1.0};
+    ScaledCursorImageCache scaled_images;
 };
 }
 }
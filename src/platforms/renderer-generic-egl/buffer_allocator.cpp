@@ -33,6 +33,7 @@
 #include <mir/graphics/drm_formats.h>
 #include <mir/graphics/egl_error.h>
 #include <mir/graphics/cpu_copy_output_surface.h>
+#include <mir/graphics/dmabuf_target_output_surface.h>
 
 #include <boost/throw_exception.hpp>
 #include <boost/exception/errinfo_errno.hpp>
@@ -374,6 +375,12 @@ auto mge::GLRenderingProvider::suitability_for_display(
         return probe::nested;
     }
 
+    if (dmabuf_provider && sink.acquire_compatible_allocator<DmaBufTargetDisplayAllocator>())
+    {
+        // We can render straight into any DMA-BUF we can import
+        return probe::supported;
+    }
+
     if (sink.acquire_compatible_allocator<CPUAddressableDisplayAllocator>())
     {
         /* We can *work* on a CPU-backed surface, but if anything's better
@@ -394,6 +401,13 @@ auto mge::GLRenderingProvider::surface_for_sink(
     {
         return std::make_unique<EGLOutputSurface>(egl_display->alloc_framebuffer(config, ctx));
     }
+    if (dmabuf_provider)
+    {
+        if (auto dmabuf_allocator = sink.acquire_compatible_allocator<DmaBufTargetDisplayAllocator>())
+        {
+            return std::make_unique<mgc::DmaBufTargetOutputSurface>(dpy, ctx, *dmabuf_allocator);
+        }
+    }
     auto cpu_provider = sink.acquire_compatible_allocator<CPUAddressableDisplayAllocator>();
 
     return std::make_unique<mgc::CPUCopyOutputSurface>(
@@ -16,6 +16,7 @@
 
 #include "basic_screen_shooter.h"
 #include <mir/graphics/cursor.h>
+#include <mir/graphics/dmabuf_buffer.h>
 #include <mir/graphics/drm_formats.h>
 #include <mir/graphics/gl_config.h>
 #include <mir/renderer/renderer.h>
@@ -26,11 +27,16 @@
 #include <mir/executor.h>
 #include <mir/graphics/platform.h>
 #include <mir/raii.h>
+#include <mir/time/alarm.h>
+#include <mir/time/alarm_factory.h>
 #include <mir/renderer/renderer_factory.h>
 #include <mir/renderer/sw/pixel_source.h>
 #include <mir/graphics/display_sink.h>
 #include <mir/graphics/output_filter.h>
 
+#include <cstring>
+#include <numeric>
+
 namespace mc = mir::compositor;
 namespace mr = mir::renderer;
 namespace mg = mir::graphics;
@@ -128,11 +134,136 @@ private:
     MirPixelFormat current_format{mir_pixel_format_invalid};
 };
 
+/* Presents a sub-rectangle of a buffer as a tightly-packed buffer in its own right.
+ *
+ * The output surface reads back into a staging copy, which is written into place
+ * in the underlying buffer when the mapping is released.
+ */
+class mc::BasicScreenShooter::Self::BufferRegion : public mrs::WriteMappable
+{
+public:
+    BufferRegion(std::shared_ptr<mrs::WriteMappable> buffer, geom::Rectangle region)
+        : buffer{std::move(buffer)},
+          region{region},
+          bytes_per_pixel{static_cast<size_t>(MIR_BYTES_PER_PIXEL(this->buffer->format()))}
+    {
+    }
+
+    auto map_writeable() -> std::unique_ptr<mrs::Mapping<std::byte>> override
+    {
+        return std::make_unique<StagingMapping>(*this);
+    }
+
+    auto format() const -> MirPixelFormat override
+    {
+        return buffer->format();
+    }
+
+    auto stride() const -> geom::Stride override
+    {
+        return geom::Stride{region.size.width.as_uint32_t() * bytes_per_pixel};
+    }
+
+    auto size() const -> geom::Size override
+    {
+        return region.size;
+    }
+
+private:
+    class StagingMapping : public mrs::Mapping<std::byte>
+    {
+    public:
+        explicit StagingMapping(BufferRegion const& target)
+            : target{target},
+              staging(target.stride().as_uint32_t() * target.region.size.height.as_uint32_t())
+        {
+        }
+
+        ~StagingMapping() override
+        {
+            auto const mapping = target.buffer->map_writeable();
+            auto const row_bytes = target.stride().as_uint32_t();
+            auto const x_offset = target.region.left().as_uint32_t() * target.bytes_per_pixel;
+            for (auto row = 0u; row < target.region.size.height.as_uint32_t(); ++row)
+            {
+                auto const y = target.region.top().as_uint32_t() + row;
+                std::memcpy(
+                    mapping->data() + y * mapping->stride().as_uint32_t() + x_offset,
+                    staging.data() + row * row_bytes,
+                    row_bytes);
+            }
+        }
+
+        auto data() const -> std::byte* override
+        {
+            return const_cast<std::byte*>(staging.data());
+        }
+
+        auto len() const -> size_t override
+        {
+            return staging.size();
+        }
+
+        auto format() const -> MirPixelFormat override
+        {
+            return target.format();
+        }
+
+        auto stride() const -> geom::Stride override
+        {
+            return target.stride();
+        }
+
+        auto size() const -> geom::Size override
+        {
+            return target.size();
+        }
+
+    private:
+        BufferRegion const& target;
+        std::vector<std::byte> staging;
+    };
+
+    std::shared_ptr<mrs::WriteMappable> const buffer;
+    geom::Rectangle const region;
+    size_t const bytes_per_pixel;
+};
+
+class mc::BasicScreenShooter::Self::DmaBufTargetProvider : public mg::DmaBufTargetDisplayAllocator
+{
+public:
+    auto current_target() const -> std::shared_ptr<mg::DMABufBuffer> override
+    {
+        if (!target)
+        {
+            BOOST_THROW_EXCEPTION((std::logic_error{"Attempted to render before assigning a target buffer"}));
+        }
+        return target;
+    }
+
+    auto output_size() const -> geom::Size override
+    {
+        if (!target)
+        {
+            BOOST_THROW_EXCEPTION((std::logic_error{"Attempted to query buffer size before assigning a buffer"}));
+        }
+        return target->size();
+    }
+
+    void set_target(std::shared_ptr<mg::DMABufBuffer> buffer)
+    {
+        target = std::move(buffer);
+    }
+
+private:
+    std::shared_ptr<mg::DMABufBuffer> target;
+};
+
 class mc::BasicScreenShooter::Self::OffscreenDisplaySink : public mg::DisplaySink
 {
 public:
     OffscreenDisplaySink(
-        std::shared_ptr<mg::CPUAddressableDisplayAllocator> provider,
+        std::shared_ptr<mg::DisplayAllocator> provider,
         geom::Size size)
         : provider {std::move(provider)},
           size{size}
@@ -169,64 +300,139 @@ protected:
     {
         if (dynamic_cast<mg::CPUAddressableDisplayAllocator::Tag const*>(&type_tag))
         {
-            return provider.get();
+            return dynamic_cast<mg::CPUAddressableDisplayAllocator*>(provider.get());
+        }
+        if (dynamic_cast<mg::DmaBufTargetDisplayAllocator::Tag const*>(&type_tag))
+        {
+            return dynamic_cast<mg::DmaBufTargetDisplayAllocator*>(provider.get());
         }
         return nullptr;
     }
 private:
-    std::shared_ptr<mg::CPUAddressableDisplayAllocator> const provider;
+    std::shared_ptr<mg::DisplayAllocator> const provider;
     geom::Size size;
 };
 
 mc::BasicScreenShooter::Self::Self(
     std::shared_ptr<Scene> const& scene,
     std::shared_ptr<time::Clock> const& clock,
+    Executor& executor,
+    time::AlarmFactory& alarm_factory,
     std::shared_ptr<mg::GLRenderingProvider> render_provider,
     std::shared_ptr<mr::RendererFactory> renderer_factory,
     std::shared_ptr<mir::graphics::GLConfig> const& config,
     std::shared_ptr<graphics::OutputFilter> const& output_filter,
     std::shared_ptr<graphics::Cursor> const& cursor)
-    : scene{scene},
+    : executor{executor},
+      scene{scene},
       clock{clock},
       render_provider{std::move(render_provider)},
       renderer_factory{std::move(renderer_factory)},
       last_rendered_format{mir_pixel_format_invalid},
       output{std::make_shared<OneShotBufferDisplayProvider>()},
+      dma_buf_output{std::make_shared<DmaBufTargetProvider>()},
+      dma_buf_targets_supported{
+          [&]()
+          {
+              OffscreenDisplaySink probe_sink{dma_buf_output, geom::Size{640, 480}};
+              return this->render_provider->suitability_for_display(probe_sink) > mg::probe::unsupported;
+          }()},
       config{config},
       output_filter{output_filter},
-      cursor{cursor}
+      cursor{cursor},
+      idle_alarm{alarm_factory.create_alarm([this]() { release_idle_renderers(); })}
 {
 }
 
-auto mc::BasicScreenShooter::Self::render(
-    std::shared_ptr<mrs::WriteMappable> const& buffer,
-    geom::Rectangle const& area,
-    glm::mat2 const& transform,
-    bool overlay_cursor) -> time::Timestamp
+mc::BasicScreenShooter::Self::~Self()
 {
-    std::lock_guard lock{mutex};
+    // Nothing is left to render these, but the clients are still waiting to hear about them
+    for (auto& job : pending_captures)
+    {
+        job(nullptr)();
+    }
+}
 
-    auto scene_elements = scene->scene_elements_for(this);
-    auto const captured_time = clock->now();
-    mg::RenderableList renderable_list;
-    renderable_list.reserve(scene_elements.size());
-    for (auto const& element : scene_elements)
+void mc::BasicScreenShooter::Self::drain()
+{
+    while (true)
     {
-        renderable_list.push_back(element->renderable());
+        CaptureJob job;
+        {
+            std::lock_guard lock{queue_mutex};
+            if (pending_captures.empty())
+            {
+                // Because the next drain might run on a different thread we need to
+                // ensure the renderer doesn't keep the EGL context current
+                {
+                    std::lock_guard render_lock{mutex};
+                    if (active_renderer)
+                    {
+                        std::exchange(active_renderer, nullptr)->suspend();
+                    }
+                }
+                draining = false;
+            }
+            else
+            {
+                job = std::move(pending_captures.front());
+                pending_captures.pop_front();
+            }
+        }
+
+        if (!job)
+        {
+            // Not under queue_mutex: the alarm's callback takes it, and may be waiting on the alarm's own lock
+            idle_alarm->reschedule_in(idle_timeout);
+            return;
+        }
+
+        executor.spawn(job(this));
     }
+}
 
-    if (overlay_cursor)
+void mc::BasicScreenShooter::Self::release_idle_renderers()
+{
+    std::lock_guard lock{queue_mutex};
+    if (draining)
     {
-        if (auto const cursor_renderable = cursor->renderable())
-            renderable_list.push_back(cursor_renderable);
+        // The drain() in progress will reschedule us when it finishes
+        return;
+    }
+
+    std::lock_guard render_lock{mutex};
+    active_renderer = nullptr;
+    current_renderer.reset();
+    offscreen_sink.reset();
+    last_rendered_format = mir_pixel_format_invalid;
+    dma_buf_renderer.reset();
+    dma_buf_sink.reset();
+}
+
+void mc::BasicScreenShooter::Self::make_active(mr::Renderer& renderer)
+{
+    if (active_renderer && active_renderer != &renderer)
+    {
+        active_renderer->suspend();
     }
+    active_renderer = &renderer;
+}
+
+auto mc::BasicScreenShooter::Self::render(
+    std::shared_ptr<mrs::WriteMappable> const& buffer,
+    geom::Rectangle const& area,
+    glm::mat2 const& transform,
+    bool overlay_cursor) -> time::Timestamp
+{
+    std::lock_guard lock{mutex};
 
-    scene_elements.clear();
+    auto const [renderable_list, captured_time] = collect_renderables(overlay_cursor);
 
     auto& renderer = renderer_for(buffer->size(), buffer->format());
     renderer.set_output_transform(transform);
     renderer.set_viewport(area);
     renderer.set_output_filter(output_filter->filter());
+    make_active(renderer);
 
     /* Hand the buffer over only once we have a renderer to consume it, and make
      * sure it can't outlive this capture: a buffer left pending would fail every
@@ -244,13 +450,148 @@ auto mc::BasicScreenShooter::Self::render(
      * going into the buffer we just set
      */
     renderer.render(renderable_list);
+    return captured_time;
+}
+
+namespace
+{
+/// A span of the buffer and the span of the captured area that it shows
+struct Span
+{
+    int buffer_start, buffer_end;
+    int area_start, area_end;
+};
 
-    // Because we might be called on a different thread next time we need to
-    // ensure the renderer doesn't keep the EGL context current
-    renderer.suspend();
+/**
+ * Widen [start, end) of a buffer dimension until both of its edges fall on whole pixels of the
+ * captured area, so the part of the area rendered lines up exactly with the part of the buffer.
+ *
+ * The buffer and area edges coincide every buffer_length/gcd buffer pixels, which is every
+ * pixel when one length is a multiple of the other.
+ */
+auto snap_to_common_pixels(int start, int end, int buffer_length, int area_length) -> Span
+{
+    auto const common = std::gcd(buffer_length, area_length);
+    auto const buffer_step = buffer_length / common;
+    auto const area_step = area_length / common;
+
+    auto const first = start / buffer_step;
+    auto const last = (end + buffer_step - 1) / buffer_step;
+    return {first * buffer_step, last * buffer_step, first * area_step, last * area_step};
+}
+}
+
+auto mc::BasicScreenShooter::Self::render_region(
+    std::shared_ptr<mrs::WriteMappable> const& buffer,
+    geom::Rectangle const& area,
+    geom::Rectangle const& buffer_region,
+    glm::mat2 const& transform,
+    bool overlay_cursor) -> std::pair<time::Timestamp, geom::Rectangle>
+{
+    geom::Rectangle const whole_buffer{{}, buffer->size()};
+    auto const region = intersection_of(buffer_region, whole_buffer);
+
+    /* Mapping a region of the buffer back onto the captured area is only
+     * straightforward if the capture isn't rotated or flipped.
+     */
+    if (region.size == geom::Size{} || region == whole_buffer || transform != glm::mat2{1})
+    {
+        return {render(buffer, area, transform, overlay_cursor), whole_buffer};
+    }
+
+    auto const x = snap_to_common_pixels(
+        region.left().as_int(), region.right().as_int(),
+        whole_buffer.size.width.as_int(), area.size.width.as_int());
+    auto const y = snap_to_common_pixels(
+        region.top().as_int(), region.bottom().as_int(),
+        whole_buffer.size.height.as_int(), area.size.height.as_int());
+
+    geom::Rectangle const snapped_region{
+        {x.buffer_start, y.buffer_start},
+        geom::Size{x.buffer_end - x.buffer_start, y.buffer_end - y.buffer_start}};
+    if (snapped_region == whole_buffer)
+    {
+        return {render(buffer, area, transform, overlay_cursor), whole_buffer};
+    }
+
+    geom::Rectangle const sub_area{
+        area.top_left + geom::Displacement{x.area_start, y.area_start},
+        geom::Size{x.area_end - x.area_start, y.area_end - y.area_start}};
+
+    auto const captured_time =
+        render(std::make_shared<BufferRegion>(buffer, snapped_region), sub_area, transform, overlay_cursor);
+    return {captured_time, snapped_region};
+}
+
+auto mc::BasicScreenShooter::Self::render(
+    std::shared_ptr<mg::DMABufBuffer> const& buffer,
+    geom::Rectangle const& area,
+    glm::mat2 const& transform,
+    bool overlay_cursor) -> time::Timestamp
+{
+    std::lock_guard lock{mutex};
+
+    if (!dma_buf_targets_supported)
+    {
+        BOOST_THROW_EXCEPTION((std::runtime_error{"Rendering provider cannot render into DMA-BUF targets"}));
+    }
+    if (buffer->size().height == geom::Height{0} || buffer->size().width == geom::Width{0})
+    {
+        BOOST_THROW_EXCEPTION((std::runtime_error{"Attempt to capture to a zero-sized buffer"}));
+    }
+
+    auto const [renderable_list, captured_time] = collect_renderables(overlay_cursor);
+
+    dma_buf_output->set_target(buffer);
+    // Don't keep the client's buffer alive beyond this capture
+    auto const drop_target = mir::raii::paired_calls(
+        [](){},
+        [this]()
+        {
+            dma_buf_output->set_target(nullptr);
+        });
+
+    if (!dma_buf_renderer)
+    {
+        auto sink = std::make_unique<OffscreenDisplaySink>(dma_buf_output, buffer->size());
+        auto gl_surface = render_provider->surface_for_sink(*sink, *config);
+        dma_buf_renderer = renderer_factory->create_renderer_for(std::move(gl_surface), render_provider);
+        dma_buf_sink = std::move(sink);
+    }
+    else
+    {
+        dma_buf_sink->set_size(buffer->size());
+    }
+
+    dma_buf_renderer->set_output_transform(transform);
+    dma_buf_renderer->set_viewport(area);
+    dma_buf_renderer->set_output_filter(output_filter->filter());
+    make_active(*dma_buf_renderer);
+    dma_buf_renderer->render(renderable_list);
     return captured_time;
 }
 
+auto mc::BasicScreenShooter::Self::collect_renderables(bool overlay_cursor)
+    -> std::pair<mg::RenderableList, time::Timestamp>
+{
+    auto scene_elements = scene->scene_elements_for(this);
+    auto const captured_time = clock->now();
+    mg::RenderableList renderable_list;
+    renderable_list.reserve(scene_elements.size() + 1);
+    for (auto const& element : scene_elements)
+    {
+        renderable_list.push_back(element->renderable());
+    }
+
+    if (overlay_cursor)
+    {
+        if (auto const cursor_renderable = cursor->renderable())
+            renderable_list.push_back(cursor_renderable);
+    }
+
+    return {std::move(renderable_list), captured_time};
+}
+
 auto mc::BasicScreenShooter::Self::renderer_for(geom::Size buffer_size, MirPixelFormat buffer_format)
     -> mr::Renderer&
 {
@@ -275,6 +616,11 @@ auto mc::BasicScreenShooter::Self::renderer_for(geom::Size buffer_size, MirPixel
         auto gl_surface = render_provider->surface_for_sink(*sink, *config);
         auto renderer = renderer_factory->create_renderer_for(std::move(gl_surface), render_provider);
 
+        if (active_renderer == current_renderer.get())
+        {
+            // Its context goes with it
+            active_renderer = nullptr;
+        }
         offscreen_sink = std::move(sink);
         current_renderer = std::move(renderer);
         last_rendered_format = buffer_format;
@@ -325,17 +671,62 @@ mc::BasicScreenShooter::BasicScreenShooter(
     std::shared_ptr<Scene> const& scene,
     std::shared_ptr<time::Clock> const& clock,
     Executor& executor,
+    time::AlarmFactory& alarm_factory,
     std::span<std::shared_ptr<mg::GLRenderingProvider>> const& providers,
     std::shared_ptr<mr::RendererFactory> render_factory,
     std::shared_ptr<graphics::GraphicBufferAllocator> const& buffer_allocator,
     std::shared_ptr<mir::graphics::GLConfig> const& config,
     std::shared_ptr<graphics::OutputFilter> const& output_filter,
     std::shared_ptr<graphics::Cursor> const& cursor)
-    : self{std::make_shared<Self>(scene, clock, select_provider(providers, buffer_allocator), std::move(render_factory), config, output_filter, cursor)},
+    : self{std::make_shared<Self>(scene, clock, executor, alarm_factory, select_provider(providers, buffer_allocator), std::move(render_factory), config, output_filter, cursor)},
       executor{executor}
 {
 }
 
+void mc::BasicScreenShooter::schedule(Self::CaptureJob&& job)
+{
+    {
+        std::lock_guard lock{self->queue_mutex};
+        if (self->pending_captures.size() >= max_pending_captures)
+        {
+            mir::log(
+                ::mir::logging::Severity::warning,
+                "BasicScreenShooter",
+                "too many captures in flight; failing capture");
+            executor.spawn([job=std::move(job)]() { job(nullptr)(); });
+            return;
+        }
+
+        self->pending_captures.push_back(std::move(job));
+        if (std::exchange(self->draining, true))
+        {
+            // The running drain() will get to this capture
+            return;
+        }
+    }
+
+    executor.spawn([weak_self=std::weak_ptr{self}]()
+        {
+            // If we've gone, ~Self() has already failed the queued captures
+            if (auto const self = weak_self.lock())
+            {
+                self->drain();
+            }
+        });
+}
+
+namespace
+{
+void log_capture_failure()
+{
+    mir::log(
+        ::mir::logging::Severity::error,
+        "BasicScreenShooter",
+        std::current_exception(),
+        "failed to capture screen");
+}
+}
+
 void mc::BasicScreenShooter::capture(
     std::shared_ptr<mrs::WriteMappable> const& buffer,
     geom::Rectangle const& area,
@@ -343,31 +734,93 @@ void mc::BasicScreenShooter::capture(
     bool overlay_cursor,
     std::function<void(std::optional<time::Timestamp>)>&& callback)
 {
-    // TODO: use an atomic to keep track of number of in-flight captures, and error if it's too many
+    schedule(
+        [buffer, area, transform, overlay_cursor, callback=std::move(callback)](Self* self) -> std::function<void()>
+        {
+            if (self)
+            {
+                try
+                {
+                    return [captured_time=self->render(buffer, area, transform, overlay_cursor), callback]()
+                        {
+                            callback(captured_time);
+                        };
+                }
+                catch (...)
+                {
+                    log_capture_failure();
+                }
+            }
+
+            return [callback]() { callback(std::nullopt); };
+        });
+}
+
+void mc::BasicScreenShooter::capture(
+    std::shared_ptr<mrs::WriteMappable> const& buffer,
+    geom::Rectangle const& area,
+    geom::Rectangle const& buffer_region,
+    glm::mat2 const& transform,
+    bool overlay_cursor,
+    std::function<void(std::optional<time::Timestamp>, geom::Rectangle const&)>&& callback)
+{
+    schedule(
+        [buffer, area, buffer_region, transform, overlay_cursor, callback=std::move(callback)](Self* self)
+            -> std::function<void()>
+        {
+            if (self)
+            {
+                try
+                {
+                    return [result=self->render_region(buffer, area, buffer_region, transform, overlay_cursor), callback]()
+                        {
+                            callback(result.first, result.second);
+                        };
+                }
+                catch (...)
+                {
+                    log_capture_failure();
+                }
+            }
+
+            return [callback]() { callback(std::nullopt, {}); };
+        });
+}
 
-    executor.spawn([weak_self=std::weak_ptr{self}, buffer, area, transform, overlay_cursor, callback=std::move(callback)]
+void mc::BasicScreenShooter::capture(
+    std::shared_ptr<mg::DMABufBuffer> const& buffer,
+    geom::Rectangle const& area,
+    glm::mat2 const& transform,
+    bool overlay_cursor,
+    std::function<void(std::optional<time::Timestamp>)>&& callback)
+{
+    schedule(
+        [buffer, area, transform, overlay_cursor, callback=std::move(callback)](Self* self) -> std::function<void()>
         {
-            if (auto const self = weak_self.lock())
+            if (self)
             {
                 try
                 {
-                    callback(self->render(buffer, area, transform, overlay_cursor));
-                    return;
+                    return [captured_time=self->render(buffer, area, transform, overlay_cursor), callback]()
+                        {
+                            callback(captured_time);
+                        };
                 }
                 catch (...)
                 {
-                    mir::log(
-                        ::mir::logging::Severity::error,
-                        "BasicScreenShooter",
-                        std::current_exception(),
-                        "failed to capture screen");
+                    log_capture_failure();
                 }
             }
 
-            callback(std::nullopt);
+            return [callback]() { callback(std::nullopt); };
         });
 }
 
+auto mc::BasicScreenShooter::supports_dma_buf_targets() const -> bool
+{
+    return self->dma_buf_targets_supported;
+}
+
 mc::CompositorID mc::BasicScreenShooter::id() const
 {
     return self.get();
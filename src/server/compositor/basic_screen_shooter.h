@@ -19,16 +19,24 @@
 
 #include <mir/compositor/screen_shooter.h>
 #include <mir/graphics/platform.h>
+#include <mir/graphics/renderable.h>
 #include <mir/renderer/renderer_factory.h>
 #include <mir/renderer/sw/pixel_source.h>
 #include <mir/time/clock.h>
 
+#include <chrono>
+#include <deque>
 #include <mutex>
 #include <glm/glm.hpp>
 
 namespace mir
 {
 class Executor;
+namespace time
+{
+class Alarm;
+class AlarmFactory;
+}
 namespace renderer
 {
 class Renderer;
@@ -50,6 +58,7 @@ public:
         std::shared_ptr<Scene> const& scene,
         std::shared_ptr<time::Clock> const& clock,
         Executor& executor,
+        time::AlarmFactory& alarm_factory,
         std::span<std::shared_ptr<graphics::GLRenderingProvider>> const& providers,
         std::shared_ptr<renderer::RendererFactory> render_factory,
         std::shared_ptr<graphics::GraphicBufferAllocator> const& buffer_allocator,
@@ -64,22 +73,62 @@ public:
         bool overlay_cursor,
         std::function<void(std::optional<time::Timestamp>)>&& callback) override;
 
+    void capture(
+        std::shared_ptr<renderer::software::WriteMappable> const& buffer,
+        geometry::Rectangle const& area,
+        geometry::Rectangle const& buffer_region,
+        glm::mat2 const& transform,
+        bool overlay_cursor,
+        std::function<void(std::optional<time::Timestamp>, geometry::Rectangle const&)>&& callback) override;
+
+    void capture(
+        std::shared_ptr<graphics::DMABufBuffer> const& buffer,
+        geometry::Rectangle const& area,
+        glm::mat2 const& transform,
+        bool overlay_cursor,
+        std::function<void(std::optional<time::Timestamp>)>&& callback) override;
+
+    auto supports_dma_buf_targets() const -> bool override;
+
     CompositorID id() const override;
 
+    /// Captures requested while this many are already waiting to be rendered fail immediately
+    static std::size_t constexpr max_pending_captures{8};
+
+    /// Renderers left unused for this long are destroyed, and rebuilt by the next capture
+    static std::chrono::milliseconds constexpr idle_timeout{5000};
+
 private:
     struct Self
     {
         class OneShotBufferDisplayProvider;
+        class BufferRegion;
+        class DmaBufTargetProvider;
         class OffscreenDisplaySink;
 
+        /* Renders one capture (or, if passed nullptr, fails it) and returns the
+         * notification to deliver to the client
+         */
+        using CaptureJob = std::function<std::function<void()>(Self*)>;
+
         Self(
             std::shared_ptr<Scene> const& scene,
             std::shared_ptr<time::Clock> const& clock,
+            Executor& executor,
+            time::AlarmFactory& alarm_factory,
             std::shared_ptr<graphics::GLRenderingProvider> provider,
             std::shared_ptr<renderer::RendererFactory> render_factory,
             std::shared_ptr<mir::graphics::GLConfig> const& config,
             std::shared_ptr<graphics::OutputFilter> const& output_filter,
-std::shared_ptr<graphics::Cursor> const& cursor);
+            std::shared_ptr<graphics::Cursor> const& cursor);
+
+        ~Self();
+
+        /// Render queued captures until there are none left
+        void drain();
+
+        /// Destroy the renderers (and their GL resources) if no capture is in progress
+        void release_idle_renderers();
 
         auto render(
             std::shared_ptr<renderer::software::WriteMappable> const& buffer,
@@ -87,9 +136,39 @@ std::shared_ptr<graphics::Cursor> const& cursor);
             glm::mat2 const& transform,
             bool overlay_cursor) -> time::Timestamp;
 
+        /// Render only [buffer_region] of [buffer]; returns the region actually rendered
+        auto render_region(
+            std::shared_ptr<renderer::software::WriteMappable> const& buffer,
+            geometry::Rectangle const& area,
+            geometry::Rectangle const& buffer_region,
+            glm::mat2 const& transform,
+            bool overlay_cursor) -> std::pair<time::Timestamp, geometry::Rectangle>;
+
+        auto render(
+            std::shared_ptr<graphics::DMABufBuffer> const& buffer,
+            geometry::Rectangle const& area,
+            glm::mat2 const& transform,
+            bool overlay_cursor) -> time::Timestamp;
+
+        /// Snapshot the scene (and optionally the cursor) for a capture; requires mutex to be held
+        auto collect_renderables(bool overlay_cursor) -> std::pair<graphics::RenderableList, time::Timestamp>;
+
         auto renderer_for(geometry::Size buffer_size, MirPixelFormat buffer_format)
             -> renderer::Renderer&;
 
+        /// Note that [renderer] is about to render; requires mutex to be held
+        void make_active(renderer::Renderer& renderer);
+
+        /* Captures are rendered back-to-back by a single drain() on the executor,
+         * which keeps the capture context current for the whole burst. Client
+         * notifications are spawned separately, so that notifying one client
+         * overlaps rendering the next capture.
+         */
+        std::mutex queue_mutex;
+        std::deque<CaptureJob> pending_captures;
+        bool draining{false};
+        Executor& executor;
+
         std::mutex mutex;
         std::shared_ptr<Scene> const scene;
         std::shared_ptr<time::Clock> const clock;
@@ -105,13 +184,29 @@ std::shared_ptr<graphics::Cursor> const& cursor);
 
         std::unique_ptr<OffscreenDisplaySink> offscreen_sink;
         std::shared_ptr<OneShotBufferDisplayProvider> const output;
+
+        /* DMA-BUF targets are rendered through their own sink, so that CPU and GPU
+         * captures can be interleaved without rebuilding either renderer.
+         */
+        std::shared_ptr<DmaBufTargetProvider> const dma_buf_output;
+        std::unique_ptr<OffscreenDisplaySink> dma_buf_sink;
+        std::unique_ptr<renderer::Renderer> dma_buf_renderer;
+        bool const dma_buf_targets_supported;
         std::shared_ptr<mir::graphics::GLConfig> config;
         std::shared_ptr<graphics::OutputFilter> const output_filter;
         std::shared_ptr<graphics::Cursor> cursor;
+
+        /// The renderer whose context was last made current by drain(), if any
+        renderer::Renderer* active_renderer{nullptr};
+
+        /// Rescheduled each time drain() finishes; declared last, so it is cancelled before anything it touches goes
+        std::unique_ptr<time::Alarm> const idle_alarm;
     };
     std::shared_ptr<Self> const self;
     Executor& executor;
 
+    void schedule(Self::CaptureJob&& job);
+
     static auto select_provider(
         std::span<std::shared_ptr<graphics::GLRenderingProvider>> const& providers,
         std::shared_ptr<graphics::GraphicBufferAllocator> const& buffer_allocator)
@@ -25,6 +25,7 @@ namespace mt = mir::time;
 mc::BasicScreenShooterFactory::BasicScreenShooterFactory(
     std::shared_ptr<Scene> const& scene,
     std::shared_ptr<mt::Clock> const& clock,
+    std::shared_ptr<mt::AlarmFactory> const& alarm_factory,
     std::vector<std::shared_ptr<mg::GLRenderingProvider>> const& providers,
     std::shared_ptr<mr::RendererFactory> const& render_factory,
     std::shared_ptr<mg::GraphicBufferAllocator> const& buffer_allocator,
@@ -33,6 +34,7 @@ mc::BasicScreenShooterFactory::BasicScreenShooterFactory(
     std::shared_ptr<graphics::Cursor> const& cursor)
     : scene(scene),
       clock(clock),
+      alarm_factory(alarm_factory),
       providers(providers),
       renderer_factory(render_factory),
       buffer_allocator(buffer_allocator),
@@ -49,5 +51,5 @@ auto mc::BasicScreenShooterFactory::create(Executor& executor) -> std::unique_pt
 auto mc::BasicScreenShooterFactory::create_for_scene(Executor& executor, std::shared_ptr<Scene> const& scene) -> std::unique_ptr<ScreenShooter>
 {
     return std::make_unique<BasicScreenShooter>(
-        scene, clock, executor, providers, renderer_factory, buffer_allocator, config, output_filter, cursor);
+        scene, clock, executor, *alarm_factory, providers, renderer_factory, buffer_allocator, config, output_filter, cursor);
 }
@@ -37,6 +37,7 @@ class OutputFilter;
 
 namespace time
 {
+class AlarmFactory;
 class Clock;
 }
 
@@ -50,6 +51,7 @@ public:
     BasicScreenShooterFactory(
         std::shared_ptr<Scene> const& scene,
         std::shared_ptr<time::Clock> const& clock,
+        std::shared_ptr<time::AlarmFactory> const& alarm_factory,
         std::vector<std::shared_ptr<graphics::GLRenderingProvider>> const& providers,
         std::shared_ptr<renderer::RendererFactory> const& render_factory,
         std::shared_ptr<graphics::GraphicBufferAllocator> const& buffer_allocator,
@@ -62,6 +64,7 @@ public:
 private:
     std::shared_ptr<Scene> const scene;
     std::shared_ptr<time::Clock> const clock;
+    std::shared_ptr<time::AlarmFactory> const alarm_factory;
     std::vector<std::shared_ptr<graphics::GLRenderingProvider>> providers;
     std::shared_ptr<renderer::RendererFactory> const renderer_factory;
     std::shared_ptr<graphics::GraphicBufferAllocator> buffer_allocator;
@@ -29,6 +29,7 @@
 #include <mir/main_loop.h>
 #include <mir/graphics/platform.h>
 #include <mir/options/configuration.h>
+#include <mir/startup_report.h>
 
 #include <cstdlib>
 
@@ -91,6 +92,7 @@ mir::DefaultServerConfiguration::the_compositor()
     return compositor(
         [this]()
         {
+            StartupPhase const phase{the_startup_report(), "Compositor"};
             std::chrono::milliseconds const composite_delay(
                 the_options()->get<int>(options::composite_delay_opt));
 
@@ -138,6 +140,7 @@ auto mir::DefaultServerConfiguration::the_screen_shooter_factory() -> std::share
             return std::make_shared<compositor::BasicScreenShooterFactory>(
                 the_scene(),
                 the_clock(),
+                the_main_loop(),
                 providers,
                 the_renderer_factory(),
                 the_buffer_allocator(),
@@ -27,6 +27,7 @@
 #include <mir/graphics/platform.h>
 #include <mir/compositor/buffer_stream.h>
 #include <mir/renderer/renderer.h>
+#include <mir/scene/surface.h>
 #include "occlusion.h"
 #include <memory>
 
@@ -110,10 +111,12 @@ bool mc::DefaultDisplayBufferCompositor::composite(mc::SceneElementSequence&& sc
             clipped_dest.top_left.y.as_value() - renderable->screen_position().top_left.y.as_value()
         };
 
+        auto const surface = renderable->surface_if_any();
         framebuffers.emplace_back(mg::DisplayElement{
             renderable->screen_position(),
             geometry::RectangleF{source_origin, source_size},
-            std::move(fb)
+            std::move(fb),
+            surface && surface.value()->tearing_allowed()
         });
     }
 
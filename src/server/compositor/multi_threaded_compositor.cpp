@@ -17,6 +17,8 @@
 #include "multi_threaded_compositor.h"
 #include <mir/compositor/scene_element.h>
 #include <mir/graphics/cursor.h>
+#include <mir/graphics/renderable.h>
+#include <mir/scene/surface.h>
 #include <mir/graphics/display.h>
 #include <mir/graphics/display_sink.h>
 #include <mir/compositor/display_buffer_compositor.h>
@@ -33,10 +35,13 @@
 #include <mir/signal.h>
 #include <mir/log.h>
 
+#include <algorithm>
 #include <atomic>
+#include <optional>
 #include <thread>
 #include <chrono>
 #include <future>
+#include <iterator>
 #include <experimental/scope>
 #include <boost/throw_exception.hpp>
 
@@ -72,6 +77,47 @@ public:
 private:
     std::shared_ptr<mg::Renderable> const renderable_;
 };
+
+/// Ranks content types by how promptly they need compositing
+auto urgency(MirContentType content_type) -> int
+{
+    switch (content_type)
+    {
+    case mir_content_type_photo:
+        return 0;
+
+    case mir_content_type_none:
+        return 1;
+
+    case mir_content_type_video:
+        return 2;
+
+    case mir_content_type_game:
+        return 3;
+    }
+
+    return 1;
+}
+
+/// The most urgent content type of the surfaces shown in area (none if there are no surfaces)
+auto most_urgent_content(mc::SceneElementSequence const& elements, mir::geometry::Rectangle const& area)
+    -> MirContentType
+{
+    std::optional<MirContentType> result;
+    for (auto const& element : elements)
+    {
+        auto const renderable = element->renderable();
+        auto const surface = renderable->surface_if_any();
+        if (!surface || !renderable->screen_position().overlaps(area))
+            continue;
+
+        auto const content_type = surface.value()->content_type();
+        if (!result || urgency(content_type) > urgency(*result))
+            result = content_type;
+    }
+
+    return result.value_or(mir_content_type_none);
+}
 }
 
 namespace mir
@@ -89,7 +135,8 @@ public:
         std::shared_ptr<DisplayListener> const& display_listener,
         std::chrono::milliseconds fixed_composite_delay,
         std::shared_ptr<CompositorReport> const& report,
-        std::shared_ptr<mg::Cursor> const& cursor) :
+        std::shared_ptr<mg::Cursor> const& cursor,
+        std::shared_ptr<std::atomic<int>> const& groups_showing_motion) :
         compositor_factory{db_compositor_factory},
         group(group),
         scene(scene),
@@ -98,6 +145,7 @@ public:
         display_listener{display_listener},
         report{report},
         cursor{cursor},
+        groups_showing_motion{groups_showing_motion},
         started_future{started.get_future()},
         stopped_future{stopped.get_future()}
     {
@@ -110,6 +158,7 @@ public:
         auto const signal_when_stopped = std::experimental::scope_exit(
             [this]()
             {
+                show_motion(false);
                 stopped.set_value();
             });
 
@@ -178,11 +227,16 @@ public:
                  */
                 if (running)
                 {
+                    auto const frame_start = std::chrono::steady_clock::now();
+                    auto shown_content = mir_content_type_photo;
                     bool needs_post = false;
-                    for (auto& tuple : compositors)
+                    for (auto& [sink, compositor] : compositors)
                     {
-                        auto& compositor = std::get<1>(tuple);
                         auto scene_elements = scene->scene_elements_for(compositor.get());
+                        auto const content = most_urgent_content(scene_elements, sink->view_area());
+                        if (urgency(content) > urgency(shown_content))
+                            shown_content = content;
+
                         if (cursor->needs_compositing())
                         {
                             if (auto const cursor_renderable = cursor->renderable())
@@ -197,15 +251,36 @@ public:
                     if (needs_post)
                         group.post();
 
+                    show_motion(
+                        shown_content == mir_content_type_video || shown_content == mir_content_type_game);
+
                     /*
                      * "Predictive bypass" optimization: If the last frame was
                      * bypassed/overlayed or you simply have a fast GPU, it is
                      * beneficial to sleep for most of the next frame. This reduces
                      * the latency between snapshotting the scene and post()
                      * completing by almost a whole frame.
+                     *
+                     * A game wants its next frame on screen as soon as it is
+                     * submitted, so is not made to wait for it (but a fixed
+                     * --composite-delay still applies).
                      */
-                    auto delay = force_sleep >= std::chrono::milliseconds::zero() ?
-                                 force_sleep : group.recommended_sleep();
+                    std::chrono::steady_clock::duration delay =
+                        force_sleep >= std::chrono::milliseconds::zero() ? force_sleep :
+                        shown_content == mir_content_type_game ? 0ms :
+                        group.recommended_sleep();
+
+                    /*
+                     * Still images can wait: while other outputs are showing
+                     * video or games, outputs showing only photos stay idle for
+                     * at least as long as their last frame took to composite
+                     * and post. When post() waits for vblank that is about
+                     * every other frame, leaving the GPU to the outputs whose
+                     * content is moving.
+                     */
+                    if (shown_content == mir_content_type_photo && *groups_showing_motion > 0)
+                        delay = std::max(delay, std::chrono::steady_clock::now() - frame_start);
+
                     std::this_thread::sleep_for(delay);
                 }
             }
@@ -243,6 +318,21 @@ public:
         wakeup.raise();
     }
 
+    auto composites(mg::DisplaySyncGroup const& other) const -> bool
+    {
+        return &group == &other;
+    }
+
+    /// Whether this group is showing video or games, which other groups yield to
+    void show_motion(bool motion)
+    {
+        if (motion != showing_motion)
+        {
+            showing_motion = motion;
+            *groups_showing_motion += motion ? 1 : -1;
+        }
+    }
+
     void wait_until_started()
     {
         if (started_future.wait_for(10s) != std::future_status::ready)
@@ -270,6 +360,8 @@ private:
     std::shared_ptr<DisplayListener> const display_listener;
     std::shared_ptr<CompositorReport> const report;
     std::shared_ptr<mg::Cursor> const cursor;
+    std::shared_ptr<std::atomic<int>> const groups_showing_motion;
+    bool showing_motion{false};
     std::promise<void> started;
     std::future<void> started_future;
     std::promise<void> stopped;
@@ -296,7 +388,8 @@ mc::MultiThreadedCompositor::MultiThreadedCompositor(
       cursor{cursor},
       state{CompositorState::stopped},
       fixed_composite_delay{fixed_composite_delay},
-      compose_on_start{compose_on_start}
+      compose_on_start{compose_on_start},
+      groups_showing_motion{std::make_shared<std::atomic<int>>(0)}
 {
     observer = std::make_shared<ms::SceneChangeNotification>(
     [this]()
@@ -317,6 +410,7 @@ mc::MultiThreadedCompositor::~MultiThreadedCompositor()
 void mc::MultiThreadedCompositor::schedule_compositing()
 {
     report->scheduled();
+    std::lock_guard lock{thread_functors_mutex};
     for (auto& f : thread_functors)
         f->schedule_compositing();
 }
@@ -324,6 +418,7 @@ void mc::MultiThreadedCompositor::schedule_compositing()
 void mc::MultiThreadedCompositor::schedule_compositing(geometry::Rectangle const& damage) const
 {
     report->scheduled();
+    std::lock_guard lock{thread_functors_mutex};
     for (auto& f : thread_functors)
         f->schedule_compositing(damage);
 }
@@ -383,21 +478,67 @@ void mc::MultiThreadedCompositor::stop()
     state = CompositorState::stopped;
 }
 
+void mc::MultiThreadedCompositor::configure_display(
+    mg::Display& to_configure,
+    mg::DisplayConfiguration const& conf)
+{
+    if (state != CompositorState::started)
+    {
+        Compositor::configure_display(to_configure, conf);
+        return;
+    }
+
+    {
+        /* If the display rejects the change, restart whatever we stopped for it */
+        auto restart_if_unwinding = on_unwind([this]
+            {
+                try
+                {
+                    create_compositing_threads();
+                }
+                catch (...)
+                {
+                    mir::log(
+                        mir::logging::Severity::error,
+                        "MultiThreadedCompositor",
+                        std::current_exception(),
+                        "Failed to restart compositing after a failed display configuration");
+                }
+            });
+
+        /* Outputs the change leaves alone keep compositing throughout */
+        to_configure.configure_incrementally(
+            conf,
+            [this](mg::DisplaySyncGroup& group) { destroy_compositing_thread_for(group); });
+    }
+
+    create_compositing_threads();
+
+    /* Surfaces may now be shown on a different set of outputs */
+    schedule_compositing();
+}
+
 void mc::MultiThreadedCompositor::create_compositing_threads()
 {
     /* Start the display buffer compositing threads */
-    display->for_each_display_sync_group([this](mg::DisplaySyncGroup& group)
+    std::vector<CompositingFunctor*> created;
+    display->for_each_display_sync_group([this, &created](mg::DisplaySyncGroup& group)
     {
+        std::lock_guard lock{thread_functors_mutex};
+        if (std::ranges::any_of(thread_functors, [&group](auto const& f) { return f->composites(group); }))
+            return;
+
         auto thread_functor = std::make_unique<mc::CompositingFunctor>(
             display_buffer_compositor_factory, group, scene, display_listener,
-            fixed_composite_delay, report, cursor);
+            fixed_composite_delay, report, cursor, groups_showing_motion);
 
         mir::thread_pool_executor.spawn(std::ref(*thread_functor));
+        created.push_back(thread_functor.get());
         thread_functors.push_back(std::move(thread_functor));
     });
 
     std::exception_ptr x;
-    for (auto& functor : thread_functors)
+    for (auto const functor : created)
     try
     {
         functor->wait_until_started();
@@ -415,11 +556,44 @@ void mc::MultiThreadedCompositor::create_compositing_threads()
 
 void mc::MultiThreadedCompositor::destroy_compositing_threads()
 {
-    for (auto& f : thread_functors)
+    std::vector<std::unique_ptr<CompositingFunctor>> stopping;
+    {
+        std::lock_guard lock{thread_functors_mutex};
+        stopping.swap(thread_functors);
+    }
+
+    /* A thread that fails to stop may still be using its functor */
+    auto keep_if_unwinding = on_unwind([this, &stopping]
+        {
+            std::lock_guard lock{thread_functors_mutex};
+            std::move(stopping.begin(), stopping.end(), std::back_inserter(thread_functors));
+        });
+
+    for (auto& f : stopping)
         f->stop();
 
-    for (auto& f : thread_functors)
+    for (auto& f : stopping)
         f->wait_until_stopped();
+}
+
+void mc::MultiThreadedCompositor::destroy_compositing_thread_for(mg::DisplaySyncGroup& group)
+{
+    std::unique_ptr<CompositingFunctor> stopping;
+    {
+        std::lock_guard lock{thread_functors_mutex};
+        auto const f = std::ranges::find_if(thread_functors, [&group](auto const& f) { return f->composites(group); });
+        if (f == thread_functors.end())
+            return;
+
+        stopping = std::move(*f);
+        thread_functors.erase(f);
+    }
+
+    auto keep_if_unwinding = on_unwind([this, &stopping]
+        {
+            std::lock_guard lock{thread_functors_mutex};
+            thread_functors.push_back(std::move(stopping));
+        });
 
-    thread_functors.clear();
+    stopping->wait_until_stopped();
 }
@@ -21,6 +21,7 @@
 #include <mir/geometry/forward.h>
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <chrono>
 #include <atomic>
@@ -30,6 +31,8 @@ namespace mir
 namespace graphics
 {
 class Display;
+class DisplayConfiguration;
+class DisplaySyncGroup;
 class Cursor;
 }
 namespace scene
@@ -68,12 +71,17 @@ public:
         bool compose_on_start);
     ~MultiThreadedCompositor();
 
-    void start();
-    void stop();
+    void start() override;
+    void stop() override;
+
+    /// Stops and starts compositing threads for only the display groups the change removes and adds
+    void configure_display(graphics::Display& to_configure, graphics::DisplayConfiguration const& conf) override;
 
 private:
+    /// Starts compositing threads for any display groups that don't have one
     void create_compositing_threads();
     void destroy_compositing_threads();
+    void destroy_compositing_thread_for(graphics::DisplaySyncGroup& group);
 
     std::shared_ptr<graphics::Display> const display;
     std::shared_ptr<DisplayBufferCompositorFactory> const display_buffer_compositor_factory;
@@ -82,11 +90,15 @@ private:
     std::shared_ptr<CompositorReport> const report;
     std::shared_ptr<graphics::Cursor> const cursor;
 
+    /// Guards thread_functors, which scene changes are scheduled on while display groups come and go
+    std::mutex mutable thread_functors_mutex;
     std::vector<std::unique_ptr<CompositingFunctor>> thread_functors;
 
     std::atomic<CompositorState> state;
     std::chrono::milliseconds fixed_composite_delay;
     bool compose_on_start;
+    /// The number of display groups currently showing video or games
+    std::shared_ptr<std::atomic<int>> const groups_showing_motion;
 
     void schedule_compositing();
     void schedule_compositing(geometry::Rectangle const& damage) const;
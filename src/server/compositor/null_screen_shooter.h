@@ -40,9 +40,28 @@ public:
         bool overlay_cursor,
         std::function<void(std::optional<time::Timestamp>)>&& callback) override;
 
+    void capture(
+        std::shared_ptr<renderer::software::WriteMappable> const& buffer,
+        geometry::Rectangle const& area,
+        geometry::Rectangle const& buffer_region,
+        glm::mat2 const& transform,
+        bool overlay_cursor,
+        std::function<void(std::optional<time::Timestamp>, geometry::Rectangle const&)>&& callback) override;
+
+    void capture(
+        std::shared_ptr<graphics::DMABufBuffer> const& buffer,
+        geometry::Rectangle const& area,
+        glm::mat2 const& transform,
+        bool overlay_cursor,
+        std::function<void(std::optional<time::Timestamp>)>&& callback) override;
+
+    auto supports_dma_buf_targets() const -> bool override;
+
     CompositorID id() const override;
 
 private:
+    void fail(std::function<void(std::optional<time::Timestamp>)>&& callback);
+
     Executor& executor;
 };
 }
@@ -22,6 +22,7 @@
 #include <mir/emergency_cleanup.h>
 #include <mir/frontend/wayland.h>
 
+#include <mir/logging/async_logger.h>
 #include <mir/logging/dumb_console_logger.h>
 #include <mir/options/option.h>
 #include <mir/options/program_option.h>
@@ -175,7 +176,7 @@ auto mir::DefaultServerConfiguration::the_logger()
     return logger(
         []() -> std::shared_ptr<ml::Logger>
         {
-            return std::make_shared<ml::DumbConsoleLogger>();
+            return std::make_shared<ml::AsyncLogger>(std::make_shared<ml::DumbConsoleLogger>());
         });
 }
 
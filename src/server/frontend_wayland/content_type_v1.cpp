@@ -0,0 +1,124 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "content_type_v1.h"
+#include "wl_surface.h"
+
+#include <mir/wayland/protocol_error.h>
+
+namespace mf = mir::frontend;
+
+namespace mir
+{
+namespace frontend
+{
+class ContentTypeManagerV1 : public wayland::ContentTypeManagerV1
+{
+public:
+    explicit ContentTypeManagerV1(wl_resource* resource);
+
+    class Global : public wayland::ContentTypeManagerV1::Global
+    {
+    public:
+        explicit Global(wl_display* display);
+
+    private:
+        void bind(wl_resource* new_wp_content_type_manager_v1) override;
+    };
+
+private:
+    void get_surface_content_type(wl_resource* id, wl_resource* surface) override;
+};
+}
+}
+
+namespace
+{
+auto mir_content_type_from(uint32_t content_type) -> MirContentType
+{
+    switch (content_type)
+    {
+    case mf::ContentTypeV1::Type::photo:
+        return mir_content_type_photo;
+
+    case mf::ContentTypeV1::Type::video:
+        return mir_content_type_video;
+
+    case mf::ContentTypeV1::Type::game:
+        return mir_content_type_game;
+
+    default:
+        return mir_content_type_none;
+    }
+}
+}
+
+auto mf::create_content_type_manager_v1(wl_display* display)
+    -> std::shared_ptr<wayland::ContentTypeManagerV1::Global>
+{
+    return std::make_shared<ContentTypeManagerV1::Global>(display);
+}
+
+mf::ContentTypeManagerV1::ContentTypeManagerV1(wl_resource* resource)
+    : wayland::ContentTypeManagerV1{resource, Version<1>{}}
+{
+}
+
+mf::ContentTypeManagerV1::Global::Global(wl_display* display)
+    : wayland::ContentTypeManagerV1::Global{display, Version<1>{}}
+{
+}
+
+void mf::ContentTypeManagerV1::Global::bind(wl_resource* new_wp_content_type_manager_v1)
+{
+    new ContentTypeManagerV1{new_wp_content_type_manager_v1};
+}
+
+void mf::ContentTypeManagerV1::get_surface_content_type(wl_resource* id, wl_resource* surface)
+{
+    auto const wl_surface = WlSurface::from(surface);
+    if (wl_surface->get_content_type())
+    {
+        throw wayland::ProtocolError{
+            resource,
+            Error::already_constructed,
+            "Surface already has a content type object attached"};
+    }
+
+    wl_surface->set_content_type(new ContentTypeV1{id, wl_surface});
+}
+
+mf::ContentTypeV1::ContentTypeV1(wl_resource* resource, WlSurface* surface)
+    : wayland::ContentTypeV1{resource, Version<1>{}},
+      surface{surface}
+{
+}
+
+mf::ContentTypeV1::~ContentTypeV1()
+{
+    if (surface)
+    {
+        surface.value().set_pending_content_type(mir_content_type_none);
+    }
+}
+
+void mf::ContentTypeV1::set_content_type(uint32_t content_type)
+{
+    if (surface)
+    {
+        surface.value().set_pending_content_type(mir_content_type_from(content_type));
+    }
+}
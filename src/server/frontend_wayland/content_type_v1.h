@@ -0,0 +1,55 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_CONTENT_TYPE_V1_H
+#define MIR_FRONTEND_CONTENT_TYPE_V1_H
+
+#include "content-type-v1_wrapper.h"
+
+#include <mir/wayland/weak.h>
+
+#include <memory>
+
+struct wl_display;
+
+namespace mir
+{
+namespace frontend
+{
+class WlSurface;
+
+auto create_content_type_manager_v1(wl_display* display)
+    -> std::shared_ptr<wayland::ContentTypeManagerV1::Global>;
+
+/// The wp_content_type_v1 extension of a wl_surface
+///
+/// The content type is double-buffered surface state: it is passed to the surface as pending state, and reverts to
+/// none when this object is destroyed.
+class ContentTypeV1 : public wayland::ContentTypeV1
+{
+public:
+    ContentTypeV1(wl_resource* resource, WlSurface* surface);
+    ~ContentTypeV1() override;
+
+private:
+    void set_content_type(uint32_t content_type) override;
+
+    wayland::Weak<WlSurface> const surface;
+};
+}
+}
+
+#endif // MIR_FRONTEND_CONTENT_TYPE_V1_H
@@ -0,0 +1,199 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cursor_shape_v1.h"
+#include "wl_pointer.h"
+
+#include <mir/input/cursor_images.h>
+#include <mir/wayland/protocol_error.h>
+#include <mir/wayland/weak.h>
+#include <mir_toolkit/cursors.h>
+
+#include <array>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace mi = mir::input;
+
+namespace
+{
+/// The xcursor names of the shapes, indexed by the shape enum value less one. These are the CSS cursor names the
+/// protocol's shapes are taken from, which cursor themes provide.
+std::array<char const*, 34> const shape_names{
+    "default",
+    "context-menu",
+    "help",
+    "pointer",
+    "progress",
+    "wait",
+    "cell",
+    "crosshair",
+    "text",
+    "vertical-text",
+    "alias",
+    "copy",
+    "move",
+    "no-drop",
+    "not-allowed",
+    "grab",
+    "grabbing",
+    "e-resize",
+    "n-resize",
+    "ne-resize",
+    "nw-resize",
+    "s-resize",
+    "se-resize",
+    "sw-resize",
+    "w-resize",
+    "ew-resize",
+    "ns-resize",
+    "nesw-resize",
+    "nwse-resize",
+    "col-resize",
+    "row-resize",
+    "all-scroll",
+    "zoom-in",
+    "zoom-out",
+};
+
+/// The theme image for each shape, looked up the first time it is used
+class ShapeImages
+{
+public:
+    explicit ShapeImages(std::shared_ptr<mi::CursorImages> const& cursor_images)
+        : cursor_images{cursor_images}
+    {
+    }
+
+    auto valid(uint32_t shape) const -> bool
+    {
+        return shape >= 1 && shape <= shape_names.size();
+    }
+
+    auto image(uint32_t shape) -> std::shared_ptr<mg::CursorImage>
+    {
+        auto& image = images[shape - 1];
+        if (!image)
+        {
+            image = cursor_images->image(shape_names[shape - 1], mi::default_cursor_size);
+        }
+        if (!image)
+        {
+            image = cursor_images->image(mir_default_cursor_name, mi::default_cursor_size);
+        }
+        return image;
+    }
+
+private:
+    std::shared_ptr<mi::CursorImages> const cursor_images;
+    std::array<std::shared_ptr<mg::CursorImage>, shape_names.size()> images;
+};
+}
+
+namespace mir
+{
+namespace frontend
+{
+class CursorShapeManagerV1 : public wayland::CursorShapeManagerV1
+{
+public:
+    CursorShapeManagerV1(wl_resource* resource, std::shared_ptr<ShapeImages> const& images);
+
+    class Global : public wayland::CursorShapeManagerV1::Global
+    {
+    public:
+        Global(wl_display* display, std::shared_ptr<input::CursorImages> const& cursor_images);
+
+    private:
+        void bind(wl_resource* new_wp_cursor_shape_manager_v1) override;
+
+        std::shared_ptr<ShapeImages> const images;
+    };
+
+private:
+    void get_pointer(wl_resource* cursor_shape_device, wl_resource* pointer) override;
+
+    std::shared_ptr<ShapeImages> const images;
+};
+
+class CursorShapeDeviceV1 : public wayland::CursorShapeDeviceV1
+{
+public:
+    CursorShapeDeviceV1(wl_resource* resource, WlPointer* pointer, std::shared_ptr<ShapeImages> const& images);
+
+private:
+    void set_shape(uint32_t serial, uint32_t shape) override;
+
+    wayland::Weak<WlPointer> const pointer;
+    std::shared_ptr<ShapeImages> const images;
+};
+}
+}
+
+auto mf::create_cursor_shape_manager_v1(wl_display* display, std::shared_ptr<mi::CursorImages> const& cursor_images)
+    -> std::shared_ptr<wayland::CursorShapeManagerV1::Global>
+{
+    return std::make_shared<CursorShapeManagerV1::Global>(display, cursor_images);
+}
+
+mf::CursorShapeManagerV1::CursorShapeManagerV1(wl_resource* resource, std::shared_ptr<ShapeImages> const& images)
+    : wayland::CursorShapeManagerV1{resource, Version<1>{}},
+      images{images}
+{
+}
+
+mf::CursorShapeManagerV1::Global::Global(wl_display* display, std::shared_ptr<mi::CursorImages> const& cursor_images)
+    : wayland::CursorShapeManagerV1::Global{display, Version<1>{}},
+      images{std::make_shared<ShapeImages>(cursor_images)}
+{
+}
+
+void mf::CursorShapeManagerV1::Global::bind(wl_resource* new_wp_cursor_shape_manager_v1)
+{
+    new CursorShapeManagerV1{new_wp_cursor_shape_manager_v1, images};
+}
+
+void mf::CursorShapeManagerV1::get_pointer(wl_resource* cursor_shape_device, wl_resource* pointer)
+{
+    new CursorShapeDeviceV1{cursor_shape_device, WlPointer::from(pointer), images};
+}
+
+mf::CursorShapeDeviceV1::CursorShapeDeviceV1(
+    wl_resource* resource,
+    WlPointer* pointer,
+    std::shared_ptr<ShapeImages> const& images)
+    : wayland::CursorShapeDeviceV1{resource, Version<1>{}},
+      pointer{pointer},
+      images{images}
+{
+}
+
+void mf::CursorShapeDeviceV1::set_shape(uint32_t serial, uint32_t shape)
+{
+    if (!images->valid(shape))
+    {
+        throw wayland::ProtocolError{
+            resource,
+            Error::invalid_shape,
+            "Invalid cursor shape %u", shape};
+    }
+
+    // The device is inert once its wl_pointer has gone
+    if (pointer)
+    {
+        pointer.value().set_cursor_image(serial, images->image(shape));
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_CURSOR_SHAPE_V1_H
+#define MIR_FRONTEND_CURSOR_SHAPE_V1_H
+
+#include "cursor-shape-v1_wrapper.h"
+
+#include <memory>
+
+struct wl_display;
+
+namespace mir
+{
+namespace input
+{
+class CursorImages;
+}
+namespace frontend
+{
+/// wp_cursor_shape_manager_v1 lets clients pick a cursor from the server's theme instead of drawing their own.
+///
+/// The images are looked up once per shape and shared by all clients, so the platform sees the same image each time
+/// a shape is used, and can reuse its scaled copy.
+auto create_cursor_shape_manager_v1(wl_display* display, std::shared_ptr<input::CursorImages> const& cursor_images)
+    -> std::shared_ptr<wayland::CursorShapeManagerV1::Global>;
+}
+}
+
+#endif // MIR_FRONTEND_CURSOR_SHAPE_V1_H
@@ -56,6 +56,32 @@ mf::DesktopFile::DesktopFile(const char* id, const char* wm_class, const char* e
       exec{exec ? exec : ""}
 {}
 
+mf::LazyDesktopFileCache::LazyDesktopFileCache(std::function<std::shared_ptr<DesktopFileCache>()> build)
+    : build{std::move(build)}
+{
+}
+
+auto mf::LazyDesktopFileCache::cache() const -> DesktopFileCache const&
+{
+    std::call_once(built, [this] { built_cache = build(); });
+    return *built_cache;
+}
+
+std::shared_ptr<mf::DesktopFile> mf::LazyDesktopFileCache::lookup_by_app_id(std::string const& name) const
+{
+    return cache().lookup_by_app_id(name);
+}
+
+std::shared_ptr<mf::DesktopFile> mf::LazyDesktopFileCache::lookup_by_wm_class(std::string const& name) const
+{
+    return cache().lookup_by_wm_class(name);
+}
+
+std::shared_ptr<mf::DesktopFile> mf::LazyDesktopFileCache::lookup_by_exec_string(std::string const& exec) const
+{
+    return cache().lookup_by_exec_string(exec);
+}
+
 mf::DesktopFileManager::DesktopFileManager(std::shared_ptr<DesktopFileCache> cache)
     : cache{cache}
 {
@@ -18,8 +18,10 @@
 #define MIR_FRONTEND_DESKTOP_FILE_MANAGER_H
 
 #include <mir/fd.h>
+#include <functional>
 #include <string>
 #include <memory>
+#include <mutex>
 
 namespace mir
 {
@@ -49,6 +51,23 @@ public:
     virtual std::shared_ptr<DesktopFile> lookup_by_exec_string(std::string const&) const = 0;
 };
 
+/// Builds the real cache on first lookup, so that a server no client asks for app ids never reads the desktop files
+class LazyDesktopFileCache : public DesktopFileCache
+{
+public:
+    LazyDesktopFileCache(std::function<std::shared_ptr<DesktopFileCache>()> build);
+    std::shared_ptr<DesktopFile> lookup_by_app_id(std::string const&) const override;
+    std::shared_ptr<DesktopFile> lookup_by_wm_class(std::string const&) const override;
+    std::shared_ptr<DesktopFile> lookup_by_exec_string(std::string const&) const override;
+
+private:
+    auto cache() const -> DesktopFileCache const&;
+
+    std::function<std::shared_ptr<DesktopFileCache>()> const build;
+    std::once_flag mutable built;
+    std::shared_ptr<DesktopFileCache> mutable built_cache;
+};
+
 class DesktopFileManager
 {
 public:
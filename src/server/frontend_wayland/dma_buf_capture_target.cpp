@@ -0,0 +1,83 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dma_buf_capture_target.h"
+#include "wayland_wrapper.h"
+
+#include <mir/graphics/dmabuf_buffer.h>
+#include <mir/graphics/drm_formats.h>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+
+namespace
+{
+class DmaBufCaptureTarget : public mg::DMABufBuffer
+{
+public:
+    explicit DmaBufCaptureTarget(mg::DMABufBuffer const& client_buffer)
+        : format_{client_buffer.format()},
+          modifier_{client_buffer.modifier()},
+          planes_{client_buffer.planes()},
+          layout_{client_buffer.layout()},
+          size_{client_buffer.size()}
+    {
+    }
+
+    auto format() const -> mg::DRMFormat override
+    {
+        return format_;
+    }
+
+    auto modifier() const -> std::optional<uint64_t> override
+    {
+        return modifier_;
+    }
+
+    auto planes() const -> std::vector<PlaneDescriptor> const& override
+    {
+        return planes_;
+    }
+
+    auto layout() const -> mg::gl::Texture::Layout override
+    {
+        return layout_;
+    }
+
+    auto size() const -> geom::Size override
+    {
+        return size_;
+    }
+
+private:
+    mg::DRMFormat const format_;
+    std::optional<uint64_t> const modifier_;
+    std::vector<PlaneDescriptor> const planes_;
+    mg::gl::Texture::Layout const layout_;
+    geom::Size const size_;
+};
+}
+
+auto mf::dma_buf_capture_target(wl_resource* buffer) -> std::shared_ptr<mg::DMABufBuffer>
+{
+    // The linux-dmabuf implementation's wl_buffers are DMABufBuffers themselves
+    if (auto const client_buffer = dynamic_cast<mg::DMABufBuffer*>(wayland::Buffer::from(buffer)))
+    {
+        return std::make_shared<DmaBufCaptureTarget>(*client_buffer);
+    }
+    return nullptr;
+}
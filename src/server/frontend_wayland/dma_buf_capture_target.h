@@ -0,0 +1,44 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_DMA_BUF_CAPTURE_TARGET_H_
+#define MIR_FRONTEND_DMA_BUF_CAPTURE_TARGET_H_
+
+#include <memory>
+
+struct wl_resource;
+
+namespace mir
+{
+namespace graphics
+{
+class DMABufBuffer;
+}
+namespace frontend
+{
+/**
+ * Snapshot a client's linux-dmabuf wl_buffer for use as a screen capture target
+ *
+ * The snapshot holds its own references to the dma-bufs, so it remains valid until
+ * the capture completes even if the client destroys the wl_buffer in the meantime.
+ *
+ * \return  The capture target, or nullptr if buffer is not a linux-dmabuf buffer
+ */
+auto dma_buf_capture_target(wl_resource* buffer) -> std::shared_ptr<graphics::DMABufBuffer>;
+}
+}
+
+#endif // MIR_FRONTEND_DMA_BUF_CAPTURE_TARGET_H_
@@ -62,8 +62,17 @@ public:
         std::shared_ptr<renderer::software::RWMappable> const& shm_data,
         geom::Rectangle const& frame_damage,
         CaptureCallback const& callback) override;
+    bool supports_dma_buf_targets() const override;
+    void begin_capture(
+        std::shared_ptr<graphics::DMABufBuffer> const& dma_buf,
+        geom::Rectangle const& frame_damage,
+        CaptureCallback const& callback) override;
 
 private:
+    /// Capture into either kind of target; they differ only in how constraints are checked
+    template<typename Target>
+    void capture_into(Target const& target, geom::Rectangle const& frame_damage, CaptureCallback const& callback);
+
     class SceneObserver;
     class SurfaceObserver;
 
@@ -192,7 +201,7 @@ void mf::ExtForeignToplevelImageCopyBackend::surface_resized()
             return;
         }
 
-        session->set_buffer_constraints(window_size);
+        session->set_buffer_constraints(window_size, supports_dma_buf_targets());
         output_space_area = {{}, window_size};
         apply_damage(std::nullopt);
     }
@@ -204,7 +213,29 @@ bool mf::ExtForeignToplevelImageCopyBackend::has_damage() { return ExtImageCopyB
 
 void mf::ExtForeignToplevelImageCopyBackend::begin_capture(
     std::shared_ptr<renderer::software::RWMappable> const& shm_data,
-    [[maybe_unused]] geom::Rectangle const& frame_damage,
+    geom::Rectangle const& frame_damage,
+    CaptureCallback const& callback)
+{
+    capture_into(shm_data, frame_damage, callback);
+}
+
+bool mf::ExtForeignToplevelImageCopyBackend::supports_dma_buf_targets() const
+{
+    return screen_shooter->supports_dma_buf_targets();
+}
+
+void mf::ExtForeignToplevelImageCopyBackend::begin_capture(
+    std::shared_ptr<graphics::DMABufBuffer> const& dma_buf,
+    geom::Rectangle const& frame_damage,
+    CaptureCallback const& callback)
+{
+    capture_into(dma_buf, frame_damage, callback);
+}
+
+template<typename Target>
+void mf::ExtForeignToplevelImageCopyBackend::capture_into(
+    Target const& target,
+    geom::Rectangle const& frame_damage,
     CaptureCallback const& callback)
 {
     using FailureReason = wayland::ImageCopyCaptureFrameV1::FailureReason;
@@ -220,7 +251,7 @@ void mf::ExtForeignToplevelImageCopyBackend::begin_capture(
     glm::mat4 const transform{1};
 
     // Check that the provided buffer matches our constraints
-    if (!shm_data || shm_data->format() != mir_pixel_format_argb_8888 || shm_data->size() != buffer_size)
+    if (!meets_buffer_constraints(target, buffer_size))
     {
         callback(std::unexpected(FailureReason::buffer_constraints));
         return;
@@ -245,14 +276,18 @@ void mf::ExtForeignToplevelImageCopyBackend::begin_capture(
         break;
     }
 
-    // TODO: capture only the region covered by
-    // union(buffer_space_damage, frame->frame_damage)
+    // The client's buffer already holds everything outside of what's changed since
+    // the last frame and whatever the client tells us it hasn't been kept up to date with
+    auto const stale_region = frame_damage.size == geom::Size{} ?
+        buffer_space_damage :
+        geom::Rectangles{buffer_space_damage, frame_damage}.bounding_rectangle();
 
-    screen_shooter->capture(
-        shm_data,
+    start_capture(
+        *screen_shooter,
+        target,
         output_space_area,
+        stale_region,
         transform,
-        overlay_cursor,
         [executor = ctx->wayland_executor, buffer_space_damage, callback](std::optional<time::Timestamp> captured_time)
         {
             executor->spawn(
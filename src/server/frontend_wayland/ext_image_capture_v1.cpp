@@ -18,17 +18,23 @@
 
 #include <glm/glm.hpp>
 
+#include <mir/compositor/screen_shooter.h>
 #include <mir/executor.h>
 #include <mir/fatal.h>
 #include <mir/graphics/cursor_image.h>
+#include <mir/graphics/dmabuf_buffer.h>
+#include <mir/graphics/drm_formats.h>
 #include <mir/input/cursor_observer.h>
 #include <mir/input/cursor_observer_multiplexer.h>
 #include <mir/renderer/sw/pixel_source.h>
 #include <mir/time/clock.h>
 #include <mir/wayland/protocol_error.h>
+#include "dma_buf_capture_target.h"
 #include "shm.h"
 #include "wayland_timespec.h"
 
+#include <drm_fourcc.h>
+
 #include <cstring>
 
 namespace mg = mir::graphics;
@@ -182,6 +188,72 @@ bool mf::ExtImageCopyBackend::has_damage()
     return damage_amount != DamageAmount::none;
 }
 
+bool mf::ExtImageCopyBackend::meets_buffer_constraints(
+    std::shared_ptr<renderer::software::RWMappable> const& shm_data,
+    geom::Size const& buffer_size)
+{
+    return shm_data && shm_data->format() == mir_pixel_format_argb_8888 && shm_data->size() == buffer_size;
+}
+
+bool mf::ExtImageCopyBackend::meets_buffer_constraints(
+    std::shared_ptr<graphics::DMABufBuffer> const& dma_buf,
+    geom::Size const& buffer_size)
+{
+    if (!dma_buf || dma_buf->format() != DRM_FORMAT_ARGB8888 || dma_buf->size() != buffer_size)
+    {
+        return false;
+    }
+
+    // We only advertise linear buffers; an implicit modifier leaves the layout to the allocator, which we accept too
+    auto const modifier = dma_buf->modifier().value_or(DRM_FORMAT_MOD_INVALID);
+    return modifier == DRM_FORMAT_MOD_LINEAR || modifier == DRM_FORMAT_MOD_INVALID;
+}
+
+void mf::ExtImageCopyBackend::start_capture(
+    compositor::ScreenShooter& screen_shooter,
+    std::shared_ptr<renderer::software::RWMappable> const& shm_data,
+    geom::Rectangle const& area,
+    geom::Rectangle const& buffer_region,
+    glm::mat2 const& transform,
+    std::function<void(std::optional<time::Timestamp>)>&& on_captured)
+{
+    screen_shooter.capture(
+        shm_data,
+        area,
+        buffer_region,
+        transform,
+        overlay_cursor,
+        [on_captured=std::move(on_captured)](std::optional<time::Timestamp> captured_time, geom::Rectangle const&)
+        {
+            on_captured(captured_time);
+        });
+}
+
+void mf::ExtImageCopyBackend::start_capture(
+    compositor::ScreenShooter& screen_shooter,
+    std::shared_ptr<graphics::DMABufBuffer> const& dma_buf,
+    geom::Rectangle const& area,
+    geom::Rectangle const&,
+    glm::mat2 const& transform,
+    std::function<void(std::optional<time::Timestamp>)>&& on_captured)
+{
+    // Rendering into the GPU buffer is cheap compared to reading back; there's little to gain by restricting it
+    screen_shooter.capture(dma_buf, area, transform, overlay_cursor, std::move(on_captured));
+}
+
+bool mf::ExtImageCopyBackend::supports_dma_buf_targets() const
+{
+    return false;
+}
+
+void mf::ExtImageCopyBackend::begin_capture(
+    std::shared_ptr<graphics::DMABufBuffer> const&,
+    geom::Rectangle const&,
+    CaptureCallback const& callback)
+{
+    callback(std::unexpected(wayland::ImageCopyCaptureFrameV1::FailureReason::buffer_constraints));
+}
+
 /* Image capture sources */
 
 mf::ExtImageCaptureSourceV1::ExtImageCaptureSourceV1(
@@ -281,11 +353,23 @@ mf::ExtImageCopyCaptureSessionV1::~ExtImageCopyCaptureSessionV1()
 {
 }
 
-void mf::ExtImageCopyCaptureSessionV1::set_buffer_constraints(geom::Size const &buffer_size)
+void mf::ExtImageCopyCaptureSessionV1::set_buffer_constraints(geom::Size const &buffer_size, bool accepts_dma_buf)
 {
     send_buffer_size_event(
         buffer_size.width.as_uint32_t(), buffer_size.height.as_uint32_t());
     send_shm_format_event(wayland::Shm::Format::argb8888);
+    if (accepts_dma_buf)
+    {
+        // Linear buffers are the one layout every device we might render on can target
+        wl_array modifiers{};
+        wl_array_init(&modifiers);
+        if (auto const modifier = static_cast<uint64_t*>(wl_array_add(&modifiers, sizeof(uint64_t))))
+        {
+            *modifier = DRM_FORMAT_MOD_LINEAR;
+        }
+        send_dmabuf_format_event(DRM_FORMAT_ARGB8888, &modifiers);
+        wl_array_release(&modifiers);
+    }
     send_done_event();
 }
 
@@ -415,23 +499,30 @@ bool mf::ExtImageCopyCaptureFrameV1::is_ready() const
 void mf::ExtImageCopyCaptureFrameV1::begin_capture(ExtImageCopyBackend& backend)
 {
     capture_has_begun = true;
-    // Check buffer constraints
-    auto shm_buffer = dynamic_cast<ShmBuffer*>(wayland::as_nullable_ptr(target));
-    if (!shm_buffer)
-    {
-        send_failed_event(FailureReason::buffer_constraints);
-        return;
-    }
-    auto shm_data = shm_buffer->data();
-    backend.begin_capture(
-        shm_data, frame_damage,
+    auto const on_captured =
         [frame=wayland::make_weak(this)](ExtImageCopyBackend::CaptureResult const& result)
             {
                 if (frame)
                 {
                     frame.value().report_result(result);
                 }
-            });
+            };
+
+    // Check buffer constraints
+    if (auto const shm_buffer = dynamic_cast<ShmBuffer*>(wayland::as_nullable_ptr(target)))
+    {
+        backend.begin_capture(shm_buffer->data(), frame_damage, on_captured);
+        return;
+    }
+    if (target && backend.supports_dma_buf_targets())
+    {
+        if (auto const dma_buf = dma_buf_capture_target(target.value().resource))
+        {
+            backend.begin_capture(dma_buf, frame_damage, on_captured);
+            return;
+        }
+    }
+    send_failed_event(FailureReason::buffer_constraints);
 }
 
 void mf::ExtImageCopyCaptureFrameV1::report_result(
@@ -493,6 +584,8 @@ public:
                      ExtImageCopyCaptureCursorSessionV1& cursor_session,
                      std::shared_ptr<time::Clock> const& clock);
 
+    // The cursor image is composed on the CPU, so only wl_shm targets are accepted
+    using ExtImageCopyBackend::begin_capture;
     void begin_capture(
         std::shared_ptr<renderer::software::RWMappable> const& shm_data,
         geom::Rectangle const& frame_damage,
@@ -529,7 +622,7 @@ void mf::ExtImageCopyCaptureCursorSessionV1::ImageCopyBackend::image_set_to(
     if (size != output_space_area.size)
     {
         output_space_area = geom::Rectangle{{0, 0}, size};
-        session->set_buffer_constraints(size);
+        session->set_buffer_constraints(size, false);
     }
     apply_damage(std::nullopt);
 }
@@ -23,6 +23,8 @@
 #include "ext-image-capture-source-v1_wrapper.h"
 #include "ext-image-copy-capture-v1_wrapper.h"
 
+#include <glm/glm.hpp>
+
 #include <expected>
 #include <functional>
 #include <memory>
@@ -32,6 +34,8 @@
 namespace mir
 {
 class Executor;
+namespace compositor { class ScreenShooter; }
+namespace graphics { class DMABufBuffer; }
 namespace input { class CursorObserverMultiplexer; }
 namespace renderer::software { class RWMappable; }
 namespace time { class Clock; }
@@ -59,6 +63,15 @@ public:
         geometry::Rectangle const& frame_damage,
         CaptureCallback const& callback) = 0;
 
+    /// Whether this backend can render directly into linux-dmabuf buffers
+    virtual bool supports_dma_buf_targets() const;
+
+    // \pre has_damage() == true && supports_dma_buf_targets() == true
+    virtual void begin_capture(
+        std::shared_ptr<graphics::DMABufBuffer> const& dma_buf,
+        geometry::Rectangle const& frame_damage,
+        CaptureCallback const& callback);
+
 protected:
     enum class DamageAmount
     {
@@ -75,6 +88,35 @@ protected:
     DamageAmount damage_amount = DamageAmount::full;
 
     void apply_damage(std::optional<geometry::Rectangle> const& damage);
+
+    /// Whether a client's buffer matches the constraints we advertise for a capture of buffer_size
+    /// @{
+    static bool meets_buffer_constraints(
+        std::shared_ptr<renderer::software::RWMappable> const& shm_data,
+        geometry::Size const& buffer_size);
+    static bool meets_buffer_constraints(
+        std::shared_ptr<graphics::DMABufBuffer> const& dma_buf,
+        geometry::Size const& buffer_size);
+    /// @}
+
+    /// Have [screen_shooter] capture [area] into a client's buffer, updating at least
+    /// [buffer_region] of it (anything the client's copy doesn't already hold)
+    /// @{
+    void start_capture(
+        compositor::ScreenShooter& screen_shooter,
+        std::shared_ptr<renderer::software::RWMappable> const& shm_data,
+        geometry::Rectangle const& area,
+        geometry::Rectangle const& buffer_region,
+        glm::mat2 const& transform,
+        std::function<void(std::optional<time::Timestamp>)>&& on_captured);
+    void start_capture(
+        compositor::ScreenShooter& screen_shooter,
+        std::shared_ptr<graphics::DMABufBuffer> const& dma_buf,
+        geometry::Rectangle const& area,
+        geometry::Rectangle const& buffer_region,
+        glm::mat2 const& transform,
+        std::function<void(std::optional<time::Timestamp>)>&& on_captured);
+    /// @}
 };
 
 using ExtImageCopyBackendFactory =
@@ -106,7 +148,8 @@ public:
         ExtImageCopyBackendFactory const& backend_factory);
     ~ExtImageCopyCaptureSessionV1();
 
-    void set_buffer_constraints(geometry::Size const& buffer_size);
+    /// Advertise the buffers frames can be captured into; wl_shm buffers are always accepted
+    void set_buffer_constraints(geometry::Size const& buffer_size, bool accepts_dma_buf);
     void set_stopped();
     void maybe_capture_frame();
 
@@ -74,8 +74,17 @@ public:
         std::shared_ptr<renderer::software::RWMappable> const& shm_data,
         geom::Rectangle const& frame_damage,
         CaptureCallback const& callback) override;
+    bool supports_dma_buf_targets() const override;
+    void begin_capture(
+        std::shared_ptr<graphics::DMABufBuffer> const& dma_buf,
+        geom::Rectangle const& frame_damage,
+        CaptureCallback const& callback) override;
 
 private:
+    /// Capture into either kind of target; they differ only in how constraints are checked
+    template<typename Target>
+    void capture_into(Target const& target, geom::Rectangle const& frame_damage, CaptureCallback const& callback);
+
     wayland::Weak<OutputGlobal> const output;
     std::shared_ptr<ExtImageCaptureV1Ctx> const ctx;
 
@@ -150,7 +159,7 @@ auto mf::ExtOutputImageCopyBackend::output_config_changed(graphics::DisplayConfi
 {
     // Send buffer constraints matching new output configuration
     auto const buffer_size = config.modes[config.current_mode_index].size;
-    session->set_buffer_constraints(buffer_size);
+    session->set_buffer_constraints(buffer_size, supports_dma_buf_targets());
 
     // Mark the whole buffer as damaged
     output_space_area = output.value().current_config().extents();
@@ -189,7 +198,29 @@ void mf::ExtOutputImageCopyBackend::create_change_notifier()
 
 void mf::ExtOutputImageCopyBackend::begin_capture(
     std::shared_ptr<renderer::software::RWMappable> const& shm_data,
-    [[maybe_unused]] geom::Rectangle const& frame_damage,
+    geom::Rectangle const& frame_damage,
+    CaptureCallback const& callback)
+{
+    capture_into(shm_data, frame_damage, callback);
+}
+
+bool mf::ExtOutputImageCopyBackend::supports_dma_buf_targets() const
+{
+    return screen_shooter->supports_dma_buf_targets();
+}
+
+void mf::ExtOutputImageCopyBackend::begin_capture(
+    std::shared_ptr<graphics::DMABufBuffer> const& dma_buf,
+    geom::Rectangle const& frame_damage,
+    CaptureCallback const& callback)
+{
+    capture_into(dma_buf, frame_damage, callback);
+}
+
+template<typename Target>
+void mf::ExtOutputImageCopyBackend::capture_into(
+    Target const& target,
+    geom::Rectangle const& frame_damage,
     CaptureCallback const& callback)
 {
     using FailureReason = wayland::ImageCopyCaptureFrameV1::FailureReason;
@@ -205,7 +236,7 @@ void mf::ExtOutputImageCopyBackend::begin_capture(
     auto const transform = output_config.transformation();
 
     // Check that the provided buffer matches our constraints
-    if (!shm_data || shm_data->format() != mir_pixel_format_argb_8888 || shm_data->size() != buffer_size)
+    if (!meets_buffer_constraints(target, buffer_size))
     {
         callback(std::unexpected(FailureReason::buffer_constraints));
         return;
@@ -228,14 +259,18 @@ void mf::ExtOutputImageCopyBackend::begin_capture(
         break;
     }
 
-    // TODO: capture only the region covered by
-    // union(buffer_space_damage, frame->frame_damage)
+    // The client's buffer already holds everything outside of what's changed since
+    // the last frame and whatever the client tells us it hasn't been kept up to date with
+    auto const stale_region = frame_damage.size == geom::Size{} ?
+        buffer_space_damage :
+        geom::Rectangles{buffer_space_damage, frame_damage}.bounding_rectangle();
 
-    screen_shooter->capture(
-        shm_data,
+    start_capture(
+        *screen_shooter,
+        target,
         output_space_area,
+        stale_region,
         transform,
-        overlay_cursor,
         [executor = ctx->wayland_executor, buffer_space_damage, callback](std::optional<time::Timestamp> captured_time)
         {
             executor->spawn(
@@ -18,6 +18,8 @@
 #include <mir/graphics/drm_formats.h>
 #include "../shm_backing.h"
 #include <mir/log.h>
+#include <mir/scene/session.h>
+#include <mir/wayland/client.h>
 #include <mir/wayland/protocol_error.h>
 
 #include <mir/wayland/weak.h>
@@ -227,7 +229,7 @@ mf::ShmPool::ShmPool(
     wayland::ShmPool(resource, Version<1>{}),
     wayland_executor{std::move(wayland_executor)},
     supported_formats{std::move(supported_formats)},
-    backing_store{shm::rw_pool_from_fd(std::move(backing_store), claimed_size)}
+    backing_store{shm::rw_pool_from_fd(std::move(backing_store), claimed_size, client->client_session()->process_id())}
 {
 }
 
@@ -387,6 +389,10 @@ void mf::ShmPool::resize(int32_t new_size)
                 wayland::Shm::Error::invalid_stride,
                 "New size %d is smaller than the current size of the backing store", new_size};
             break;
+        case shm::ResizeError::over_budget:
+            // The client's memory budget is enforced by disconnecting it
+            wl_client_post_no_memory(client->raw_client());
+            break;
         }
     }
 }
@@ -434,6 +440,11 @@ void mf::Shm::create_pool(wl_resource* id, Fd fd, int32_t size)
     {
         new ShmPool{id, wayland_executor, supported_formats, fd, size};
     }
+    catch (shm::OverBudgetError const&)
+    {
+        // The client's memory budget is enforced by disconnecting it
+        wl_client_post_no_memory(client->raw_client());
+    }
     catch (shm::MmapError const& err)
     {
         // The pool is backed by mmap()ing the client-provided file descriptor. Per the wl_shm spec a
@@ -0,0 +1,157 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "single_pixel_buffer_v1.h"
+
+#include <mir/graphics/solid_color_buffer.h>
+#include <mir/renderer/sw/pixel_source.h>
+#include <mir/synchronised.h>
+
+#include <limits>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace mrs = mir::renderer::software;
+
+namespace mir
+{
+namespace frontend
+{
+class SinglePixelBufferManagerV1 : public wayland::SinglePixelBufferManagerV1
+{
+public:
+    explicit SinglePixelBufferManagerV1(wl_resource* resource);
+
+    class Global : public wayland::SinglePixelBufferManagerV1::Global
+    {
+    public:
+        explicit Global(wl_display* display);
+
+    private:
+        void bind(wl_resource* new_wp_single_pixel_buffer_manager_v1) override;
+    };
+
+private:
+    void create_u32_rgba_buffer(wl_resource* id, uint32_t r, uint32_t g, uint32_t b, uint32_t a) override;
+};
+}
+}
+
+namespace
+{
+/// Tells the client when its buffer has been drawn, and when it may reuse it
+class NotifyingSolidColorBuffer : public mg::SolidColorBuffer
+{
+public:
+    NotifyingSolidColorBuffer(
+        glm::vec4 color,
+        std::function<void()>&& on_consumed,
+        std::function<void()>&& on_release)
+        : SolidColorBuffer{color},
+          on_consumed{std::move(on_consumed)},
+          on_release{std::move(on_release)}
+    {
+    }
+
+    ~NotifyingSolidColorBuffer() override
+    {
+        on_release();
+    }
+
+    auto map_readable() const -> std::unique_ptr<mrs::Mapping<std::byte const>> override
+    {
+        notify_consumed();
+        return SolidColorBuffer::map_readable();
+    }
+
+    void bind() override
+    {
+        SolidColorBuffer::bind();
+        notify_consumed();
+    }
+
+private:
+    void notify_consumed() const
+    {
+        auto consumed = on_consumed.lock_mut();
+        (*consumed)();
+        *consumed = [](){};
+    }
+
+    mir::Synchronised<std::function<void()>> on_consumed;
+    std::function<void()> const on_release;
+};
+}
+
+auto mf::create_single_pixel_buffer_manager_v1(wl_display* display)
+    -> std::shared_ptr<wayland::SinglePixelBufferManagerV1::Global>
+{
+    return std::make_shared<SinglePixelBufferManagerV1::Global>(display);
+}
+
+mf::SinglePixelBufferManagerV1::SinglePixelBufferManagerV1(wl_resource* resource)
+    : wayland::SinglePixelBufferManagerV1{resource, Version<1>{}}
+{
+}
+
+mf::SinglePixelBufferManagerV1::Global::Global(wl_display* display)
+    : wayland::SinglePixelBufferManagerV1::Global{display, Version<1>{}}
+{
+}
+
+void mf::SinglePixelBufferManagerV1::Global::bind(wl_resource* new_wp_single_pixel_buffer_manager_v1)
+{
+    new SinglePixelBufferManagerV1{new_wp_single_pixel_buffer_manager_v1};
+}
+
+void mf::SinglePixelBufferManagerV1::create_u32_rgba_buffer(
+    wl_resource* id,
+    uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+{
+    auto const normalise = [](uint32_t value)
+        {
+            return static_cast<float>(static_cast<double>(value) / std::numeric_limits<uint32_t>::max());
+        };
+
+    new SinglePixelBuffer{id, {normalise(r), normalise(g), normalise(b), normalise(a)}};
+}
+
+mf::SinglePixelBuffer::SinglePixelBuffer(wl_resource* resource, glm::vec4 color)
+    : Buffer{resource, Version<1>{}},
+      color_{color}
+{
+}
+
+auto mf::SinglePixelBuffer::color() const -> glm::vec4
+{
+    return color_;
+}
+
+auto mf::SinglePixelBuffer::graphics_buffer(
+    std::function<void()>&& on_consumed,
+    std::function<void()>&& on_release) const -> std::shared_ptr<mg::Buffer>
+{
+    return std::make_shared<NotifyingSolidColorBuffer>(color_, std::move(on_consumed), std::move(on_release));
+}
+
+auto mf::SinglePixelBuffer::from(wl_resource* resource) -> SinglePixelBuffer*
+{
+    if (auto buffer = wayland::Buffer::from(resource))
+    {
+        return dynamic_cast<SinglePixelBuffer*>(buffer);
+    }
+    return nullptr;
+}
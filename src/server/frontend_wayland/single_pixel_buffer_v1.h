@@ -0,0 +1,69 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_SINGLE_PIXEL_BUFFER_V1_H
+#define MIR_FRONTEND_SINGLE_PIXEL_BUFFER_V1_H
+
+#include "single-pixel-buffer-v1_wrapper.h"
+#include "wayland_wrapper.h"
+
+#include <glm/glm.hpp>
+
+#include <functional>
+#include <memory>
+
+struct wl_display;
+
+namespace mir
+{
+namespace graphics
+{
+class Buffer;
+}
+namespace frontend
+{
+auto create_single_pixel_buffer_manager_v1(wl_display* display)
+    -> std::shared_ptr<wayland::SinglePixelBufferManagerV1::Global>;
+
+/// A wl_buffer created by wp_single_pixel_buffer_manager_v1
+///
+/// These are drawn as a flat colour; nothing is allocated for them, whatever size they are scaled to.
+class SinglePixelBuffer : public wayland::Buffer
+{
+public:
+    /// Premultiplied RGBA, each component in [0, 1]
+    auto color() const -> glm::vec4;
+
+    /// Create a graphics buffer to submit for this wl_buffer
+    ///
+    /// \param on_consumed  Called the first time the buffer is drawn
+    /// \param on_release   Called when the compositor is done with the buffer
+    auto graphics_buffer(
+        std::function<void()>&& on_consumed,
+        std::function<void()>&& on_release) const -> std::shared_ptr<graphics::Buffer>;
+
+    static auto from(wl_resource* resource) -> SinglePixelBuffer*;
+
+private:
+    friend class SinglePixelBufferManagerV1;
+    SinglePixelBuffer(wl_resource* resource, glm::vec4 color);
+
+    glm::vec4 const color_;
+};
+}
+}
+
+#endif // MIR_FRONTEND_SINGLE_PIXEL_BUFFER_V1_H
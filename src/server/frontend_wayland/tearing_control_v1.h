@@ -0,0 +1,55 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_TEARING_CONTROL_V1_H
+#define MIR_FRONTEND_TEARING_CONTROL_V1_H
+
+#include "tearing-control-v1_wrapper.h"
+
+#include <mir/wayland/weak.h>
+
+#include <memory>
+
+struct wl_display;
+
+namespace mir
+{
+namespace frontend
+{
+class WlSurface;
+
+auto create_tearing_control_manager_v1(wl_display* display)
+    -> std::shared_ptr<wayland::TearingControlManagerV1::Global>;
+
+/// The wp_tearing_control_v1 extension of a wl_surface
+///
+/// The presentation hint is double-buffered surface state: it is passed to the surface as pending state, and
+/// reverts to vsync when this object is destroyed.
+class TearingControlV1 : public wayland::TearingControlV1
+{
+public:
+    TearingControlV1(wl_resource* resource, WlSurface* surface);
+    ~TearingControlV1() override;
+
+private:
+    void set_presentation_hint(uint32_t hint) override;
+
+    wayland::Weak<WlSurface> const surface;
+};
+}
+}
+
+#endif // MIR_FRONTEND_TEARING_CONTROL_V1_H
@@ -265,7 +265,8 @@ mf::WaylandConnector::WaylandConnector(
     std::shared_ptr<scene::SessionCoordinator> const& session_coordinator,
     std::shared_ptr<shell::TokenAuthority> const& token_authority,
     std::vector<std::shared_ptr<mg::RenderingPlatform>> const& render_platforms,
-    std::shared_ptr<input::CursorObserverMultiplexer> const& cursor_observer_multiplexer)
+    std::shared_ptr<input::CursorObserverMultiplexer> const& cursor_observer_multiplexer,
+    std::shared_ptr<input::CursorImages> const& cursor_images)
     : extension_filter{extension_filter},
       display{wl_display_create(), &cleanup_display},
       // TODO(mattkae): Run the server and hook it up to the rest of the system
@@ -338,8 +339,10 @@ mf::WaylandConnector::WaylandConnector(
         executor,
         display_config_registrar);
 
+    // Only the foreign toplevel extensions resolve app ids, and only once a client binds them
     desktop_file_manager = std::make_shared<mf::DesktopFileManager>(
-        std::make_shared<mf::GDesktopFileCache>(main_loop));
+        std::make_shared<mf::LazyDesktopFileCache>(
+            [main_loop]() { return std::make_shared<mf::GDesktopFileCache>(main_loop); }));
 
     data_device_manager_global = std::make_unique<WlDataDeviceManager>(
         display.get(),
@@ -376,7 +379,8 @@ mf::WaylandConnector::WaylandConnector(
         cursor_observer_multiplexer,
         action_group_manager,
         input_trigger_registry,
-        keyboard_state_tracker});
+        keyboard_state_tracker,
+        cursor_images});
 
     std::vector<mg::DRMFormat> shm_formats;
     for (auto const pixel_format : this->allocator->supported_pixel_formats())
@@ -52,6 +52,7 @@ class InputDeviceHub;
 class InputDeviceRegistry;
 class Seat;
 class CursorObserverMultiplexer;
+class CursorImages;
 class CompositeEventFilter;
 class KeyboardObserver;
 }
@@ -133,6 +134,7 @@ public:
         std::shared_ptr<InputTriggerRegistry::ActionGroupManager> action_group_manager;
         std::shared_ptr<InputTriggerRegistry> input_trigger_registry;
         std::shared_ptr<KeyboardStateTracker> keyboard_state_tracker;
+        std::shared_ptr<input::CursorImages> cursor_images;
     };
 
     WaylandExtensions() = default;
@@ -189,7 +191,8 @@ public:
         std::shared_ptr<scene::SessionCoordinator> const& session_coordinator,
         std::shared_ptr<shell::TokenAuthority> const& token_authority,
         std::vector<std::shared_ptr<graphics::RenderingPlatform>> const& render_platforms,
-        std::shared_ptr<input::CursorObserverMultiplexer> const& cursor_observer_multiplexer);
+        std::shared_ptr<input::CursorObserverMultiplexer> const& cursor_observer_multiplexer,
+        std::shared_ptr<input::CursorImages> const& cursor_images);
 
     ~WaylandConnector() override;
 
@@ -25,7 +25,10 @@
 #include <mir/log.h>
 #include <mir/options/default_configuration.h>
 #include <mir/scene/session.h>
+#include <mir/startup_report.h>
 
+#include "content_type_v1.h"
+#include "cursor_shape_v1.h"
 #include "ext_image_capture_v1.h"
 #include "ext_foreign_toplevel_image_capture_source_v1.h"
 #include "ext_output_image_capture_source_v1.h"
@@ -41,6 +44,8 @@
 #include "primary_selection_v1.h"
 #include "relative_pointer_unstable_v1.h"
 #include "session_lock_v1.h"
+#include "single_pixel_buffer_v1.h"
+#include "tearing_control_v1.h"
 #include "text_input_v1.h"
 #include "text_input_v2.h"
 #include "text_input_v3.h"
@@ -275,6 +280,22 @@ std::vector<ExtensionBuilder> const internal_extension_builders = {
         {
             return mf::create_fractional_scale_v1(ctx.display);
         }),
+    make_extension_builder<mw::SinglePixelBufferManagerV1>([](auto const& ctx)
+        {
+            return mf::create_single_pixel_buffer_manager_v1(ctx.display);
+        }),
+    make_extension_builder<mw::TearingControlManagerV1>([](auto const& ctx)
+        {
+            return mf::create_tearing_control_manager_v1(ctx.display);
+        }),
+    make_extension_builder<mw::CursorShapeManagerV1>([](auto const& ctx)
+        {
+            return mf::create_cursor_shape_manager_v1(ctx.display, ctx.cursor_images);
+        }),
+    make_extension_builder<mw::ContentTypeManagerV1>([](auto const& ctx)
+        {
+            return mf::create_content_type_manager_v1(ctx.display);
+        }),
     make_extension_builder<mw::XdgActivationV1>([](auto const& ctx)
         {
             return mf::create_xdg_activation_v1(
@@ -412,7 +433,11 @@ auto mf::get_standard_extensions() -> std::vector<std::string>
         // TODO: reinstate this once the implementation is fixed!
         // mw::XdgWmDialogV1::interface_name,
         mw::XdgActivationV1::interface_name,
-        mw::FractionalScaleManagerV1::interface_name};
+        mw::FractionalScaleManagerV1::interface_name,
+        mw::SinglePixelBufferManagerV1::interface_name,
+        mw::TearingControlManagerV1::interface_name,
+        mw::CursorShapeManagerV1::interface_name,
+        mw::ContentTypeManagerV1::interface_name};
 }
 
 auto mf::get_supported_extensions() -> std::vector<std::string>
@@ -431,6 +456,7 @@ std::shared_ptr<mf::Connector>
     return wayland_connector(
         [this]() -> std::shared_ptr<mf::Connector>
         {
+            StartupPhase const phase{the_startup_report(), "Wayland connector"};
             auto options = the_options();
             bool const arw_socket = options->is_set(options::arw_server_socket_opt);
 
@@ -471,7 +497,8 @@ std::shared_ptr<mf::Connector>
                 the_session_coordinator(),
                 the_token_authority(),
                 the_rendering_platforms(),
-                the_cursor_observer_multiplexer());
+                the_cursor_observer_multiplexer(),
+                the_cursor_images());
         });
 }
 
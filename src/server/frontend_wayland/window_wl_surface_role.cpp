@@ -135,7 +135,16 @@ void mf::WindowWlSurfaceRole::refresh_surface_data_now()
     {
         shell::SurfaceSpecification surface_data_spec;
         populate_spec_with_surface_data(surface_data_spec);
-        shell->modify_surface(session, scene_surface, surface_data_spec);
+
+        // A desynchronised subsurface commit often leaves the stream tree unchanged (for example, a
+        // new buffer in an already-mapped subsurface); don't make the shell rebuild it needlessly.
+        clear_pending_if_unchanged(surface_data_spec.streams, committed_streams);
+        clear_pending_if_unchanged(surface_data_spec.input_shape, committed_input_shape);
+
+        if (!surface_data_spec.is_empty())
+        {
+            shell->modify_surface(session, scene_surface, surface_data_spec);
+        }
     }
 }
 
@@ -418,6 +427,8 @@ void mf::WindowWlSurfaceRole::commit(WlSurfaceState const& state)
             clear_pending_if_unchanged(pending_changes->min_height, committed_min_size.height);
             clear_pending_if_unchanged(pending_changes->max_width,  committed_max_size.width);
             clear_pending_if_unchanged(pending_changes->max_height, committed_max_size.height);
+            clear_pending_if_unchanged(pending_changes->streams, committed_streams);
+            clear_pending_if_unchanged(pending_changes->input_shape, committed_input_shape);
         }
 
         if (pending_changes && !pending_changes->is_empty())
@@ -574,6 +585,8 @@ void mf::WindowWlSurfaceRole::create_scene_surface()
     if (mods.min_height) committed_min_size.height = mods.min_height.value();
     if (mods.max_width)  committed_max_size.width  = mods.max_width.value();
     if (mods.max_height) committed_max_size.height = mods.max_height.value();
+    committed_streams = mods.streams.value();
+    committed_input_shape = mods.input_shape.value();
 
     // The shell isn't guaranteed to respect the requested size
     // TODO: make initial updates atomic somehow
@@ -32,6 +32,7 @@
 
 #include <optional>
 #include <chrono>
+#include <vector>
 
 struct wl_client;
 struct wl_resource;
@@ -48,6 +49,7 @@ class Session;
 namespace shell
 {
 struct SurfaceSpecification;
+struct StreamSpecification;
 class Shell;
 }
 namespace wayland
@@ -179,6 +181,12 @@ private:
     geometry::Size committed_max_size;
     /// @}
 
+    /// The buffer streams and input shape of the surface tree as of last commit
+    /// @{
+    std::vector<shell::StreamSpecification> committed_streams;
+    std::vector<geometry::Rectangle> committed_input_shape;
+    /// @}
+
     std::unique_ptr<shell::SurfaceSpecification> pending_changes;
 
     shell::SurfaceSpecification& spec();
@@ -456,6 +456,29 @@ struct WlHiddenCursor : mf::WlPointer::Cursor
 private:
     CursorSurfaceRole surface_role;
 };
+
+/// A cursor image provided by the server, rather than drawn by the client
+struct ServerImageCursor : mf::WlPointer::Cursor
+{
+    explicit ServerImageCursor(std::shared_ptr<mg::CursorImage> const& image)
+        : image{image}
+    {
+    }
+
+    void apply_to(mf::WlSurface* surface) override
+    {
+        if (auto scene_surface = surface->scene_surface())
+        {
+            scene_surface.value()->set_cursor_image(image);
+        }
+    }
+
+    void set_hotspot(geom::Displacement const&) override {};
+    auto cursor_surface() const -> std::optional<mf::WlSurface*> override { return {}; };
+
+private:
+    std::shared_ptr<mg::CursorImage> const image;
+};
 }
 
 void mf::WlPointer::set_cursor(
@@ -493,6 +516,24 @@ void mf::WlPointer::set_cursor(
     }
 }
 
+void mf::WlPointer::set_cursor_image(uint32_t serial, std::shared_ptr<graphics::CursorImage> const& image)
+{
+    if (!enter_serial || serial != enter_serial.value())
+    {
+        return;
+    }
+
+    cursor.reset(); // clean up old cursor before creating new one
+    cursor = std::make_unique<ServerImageCursor>(image);
+    if (surface_under_cursor)
+        cursor->apply_to(&surface_under_cursor.value());
+}
+
+auto mf::WlPointer::from(wl_resource* resource) -> WlPointer*
+{
+    return dynamic_cast<WlPointer*>(wayland::Pointer::from(resource));
+}
+
 void mf::WlPointer::on_commit(WlSurface* surface)
 {
     // We need an explicit conversion before calling make_unique
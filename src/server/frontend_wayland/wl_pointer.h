@@ -36,6 +36,10 @@ struct MirPointerEvent;
 
 namespace mir
 {
+namespace graphics
+{
+class CursorImage;
+}
 namespace wayland
 {
 class RelativePointerV1;
@@ -76,6 +80,12 @@ public:
     void event(std::shared_ptr<MirPointerEvent const> const& event, WlSurface& root_surface);
     void leave(std::optional<std::shared_ptr<MirPointerEvent const>> const& event);
 
+    /// Show a server-side image (such as a wp_cursor_shape_v1 shape) as the cursor, in place of any cursor surface.
+    /// Like wl_pointer.set_cursor, this is ignored unless serial is that of the latest enter.
+    void set_cursor_image(uint32_t serial, std::shared_ptr<graphics::CursorImage> const& image);
+
+    static auto from(wl_resource* resource) -> WlPointer*;
+
     struct Cursor;
 
 private:
@@ -25,8 +25,11 @@
 #include "wl_subcompositor.h"
 #include "wl_region.h"
 #include "shm.h"
+#include "single_pixel_buffer_v1.h"
 #include "resource_lifetime_tracker.h"
 #include "linux_drm_syncobj.h"
+#include "tearing_control_v1.h"
+#include "content_type_v1.h"
 
 #include "wayland_wrapper.h"
 
@@ -86,6 +89,12 @@ void mf::WlSurfaceState::update_from(WlSurfaceState const& source)
     if (source.mirror_mode)
         mirror_mode = source.mirror_mode;
 
+    if (source.allow_tearing)
+        allow_tearing = source.allow_tearing;
+
+    if (source.content_type)
+        content_type = source.content_type;
+
     if (source.offset)
         offset = source.offset;
 
@@ -208,6 +217,16 @@ void mf::WlSurface::set_pending_offset(std::optional<geom::Displacement> const&
     pending.offset = offset;
 }
 
+void mf::WlSurface::set_pending_allow_tearing(bool allow_tearing)
+{
+    pending.allow_tearing = allow_tearing;
+}
+
+void mf::WlSurface::set_pending_content_type(MirContentType content_type)
+{
+    pending.content_type = content_type;
+}
+
 void mf::WlSurface::add_subsurface(WlSubsurface* child)
 {
     if (std::find(children.begin(), children.end(), child) != children.end())
@@ -475,6 +494,10 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
                 scene_surface.value()->set_orientation(state.orientation.value());
             if (state.mirror_mode)
                 scene_surface.value()->set_mirror_mode(state.mirror_mode.value());
+            if (state.allow_tearing)
+                scene_surface.value()->set_tearing_allowed(state.allow_tearing.value());
+            if (state.content_type)
+                scene_surface.value()->set_content_type(state.content_type.value());
             if (state.opaque_region)
                 scene_surface.value()->set_opaque_region(state.opaque_region.value());
         }
@@ -544,6 +567,17 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
                     wl_resource_get_client(resource),
                     current_buffer->id().as_value());
             }
+            else if (auto const single_pixel_buffer = SinglePixelBuffer::from(weak_buffer.value()))
+            {
+                current_buffer = single_pixel_buffer->graphics_buffer(
+                    std::move(executor_send_frame_callbacks),
+                    std::move(release_buffer));
+                tracepoint(
+                    mir_server_wayland,
+                    sw_buffer_committed,
+                    wl_resource_get_client(resource),
+                    current_buffer->id().as_value());
+            }
             else
             {
                 current_buffer = allocator->buffer_from_resource(
@@ -884,6 +918,26 @@ auto mf::WlSurface::get_fractional_scale() const -> wayland::Weak<FractionalScal
     return fractional_scale;
 }
 
+void mf::WlSurface::set_tearing_control(TearingControlV1* tearing_control)
+{
+    this->tearing_control = wayland::Weak{tearing_control};
+}
+
+auto mf::WlSurface::get_tearing_control() const -> wayland::Weak<TearingControlV1>
+{
+    return tearing_control;
+}
+
+void mf::WlSurface::set_content_type(ContentTypeV1* content_type)
+{
+    this->content_type = wayland::Weak{content_type};
+}
+
+auto mf::WlSurface::get_content_type() const -> wayland::Weak<ContentTypeV1>
+{
+    return content_type;
+}
+
 void mf::NullWlSurfaceRole::refresh_surface_data_now() {}
 void mf::NullWlSurfaceRole::commit(WlSurfaceState const& state) { surface->commit(state); }
 void mf::NullWlSurfaceRole::surface_destroyed() {}
@@ -65,6 +65,8 @@ class WlSubsurface;
 class ResourceLifetimeTracker;
 class Viewport;
 class SyncTimeline;
+class TearingControlV1;
+class ContentTypeV1;
 
 struct WlSurfaceState
 {
@@ -93,6 +95,8 @@ struct WlSurfaceState
     std::optional<geometry::Rectangles> opaque_region;
     std::optional<MirOrientation> orientation;
     std::optional<MirMirrorMode> mirror_mode;
+    std::optional<bool> allow_tearing;
+    std::optional<MirContentType> content_type;
     std::vector<wayland::Weak<Callback>> frame_callbacks;
     wayland::Weak<Viewport> viewport;
 
@@ -146,6 +150,10 @@ public:
     void set_role(WlSurfaceRole* role_);
     void clear_role();
     void set_pending_offset(std::optional<geometry::Displacement> const& offset);
+    /// Whether the content may be presented with tearing, see wp_tearing_control_v1
+    void set_pending_allow_tearing(bool allow_tearing);
+    /// The kind of content the surface shows, see wp_content_type_v1
+    void set_pending_content_type(MirContentType content_type);
     void add_subsurface(WlSubsurface* child);
     void remove_subsurface(WlSubsurface* child);
     bool has_subsurface_with_surface(WlSurface* surface) const;
@@ -163,6 +171,12 @@ public:
     void set_fractional_scale(FractionalScaleV1* fractional_scale);
     auto get_fractional_scale() const -> wayland::Weak<FractionalScaleV1>;
 
+    void set_tearing_control(TearingControlV1* tearing_control);
+    auto get_tearing_control() const -> wayland::Weak<TearingControlV1>;
+
+    void set_content_type(ContentTypeV1* content_type);
+    auto get_content_type() const -> wayland::Weak<ContentTypeV1>;
+
     /**
      * Associate a viewport (buffer scale & crop metadata) with this surface
      *
@@ -238,6 +252,8 @@ private:
     std::vector<SceneSurfaceCreatedCallback> scene_surface_created_callbacks;
     wayland::Weak<Viewport> viewport;
     wayland::Weak<FractionalScaleV1> fractional_scale;
+    wayland::Weak<TearingControlV1> tearing_control;
+    wayland::Weak<ContentTypeV1> content_type;
     wayland::Weak<SyncTimeline> sync_timeline;
 
     void send_frame_callbacks(CallbackList& list);
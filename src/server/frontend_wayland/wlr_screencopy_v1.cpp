@@ -22,6 +22,8 @@
 #include <mir/graphics/graphic_buffer_allocator.h>
 #include <mir/renderer/sw/pixel_source.h>
 #include <mir/graphics/buffer.h>
+#include <mir/graphics/dmabuf_buffer.h>
+#include <mir/graphics/drm_formats.h>
 #include <mir/scene/scene_change_notification.h>
 #include <mir/frontend/surface_stack.h>
 #include <mir/geometry/rectangles.h>
@@ -31,8 +33,11 @@
 #include "wayland_wrapper.h"
 #include "wayland_timespec.h"
 #include "output_manager.h"
+#include "dma_buf_capture_target.h"
 #include "shm.h"
 
+#include <drm_fourcc.h>
+
 #include <mutex>
 #include <optional>
 
@@ -158,6 +163,8 @@ public:
 
 private:
     void prepare_target(wl_resource* buffer);
+    void prepare_shm_target(ShmBuffer* shm_buffer);
+    void prepare_dma_buf_target(wl_resource* buffer);
     void report_result(std::optional<time::Timestamp> captured_time, geom::Rectangle buffer_space_damage);
 
     /// From wayland::WlrScreencopyFrameV1
@@ -176,6 +183,8 @@ private:
     bool copy_has_been_called{false};
     bool should_send_damage{false};
     std::shared_ptr<renderer::software::WriteMappable> target;
+    /// Set instead of target when the client supplied a linux-dmabuf buffer
+    std::shared_ptr<graphics::DMABufBuffer> dma_buf_target;
     /// @}
 };
 }
@@ -414,12 +423,19 @@ mf::WlrScreencopyFrameV1::WlrScreencopyFrameV1(
         params.buffer_size.width.as_uint32_t(),
         params.buffer_size.height.as_uint32_t(),
         stride.as_uint32_t());
+    if (manager->screen_shooter->supports_dma_buf_targets())
+    {
+        send_linux_dmabuf_event_if_supported(
+            DRM_FORMAT_ARGB8888,
+            params.buffer_size.width.as_uint32_t(),
+            params.buffer_size.height.as_uint32_t());
+    }
     send_buffer_done_event_if_supported();
 }
 
 void mf::WlrScreencopyFrameV1::capture(geom::Rectangle buffer_space_damage)
 {
-    if (!target)
+    if (!target && !dma_buf_target)
     {
         log_error("WlrScreencopyFrameV1::capture() called without a target, copy %s been called",
             copy_has_been_called ? "has" : "has not");
@@ -434,7 +450,7 @@ void mf::WlrScreencopyFrameV1::capture(geom::Rectangle buffer_space_damage)
         return;
     }
 
-    manager.value().screen_shooter->capture(std::move(target), params.output_space_area, params.transform, params.overlay_cursor,
+    auto on_captured =
         [wayland_executor=ctx->wayland_executor, buffer_space_damage, self=mw::make_weak(this)]
             (std::optional<time::Timestamp> captured_time)
         {
@@ -445,7 +461,24 @@ void mf::WlrScreencopyFrameV1::capture(geom::Rectangle buffer_space_damage)
                         self.value().report_result(captured_time, buffer_space_damage);
                     }
                 });
-        });
+        };
+
+    auto& screen_shooter = *manager.value().screen_shooter;
+    if (dma_buf_target)
+    {
+        screen_shooter.capture(
+            std::move(dma_buf_target),
+            params.output_space_area,
+            params.transform,
+            params.overlay_cursor,
+            std::move(on_captured));
+    }
+    else
+    {
+        // Moved, so the client's buffer is released as soon as the capture is done with it rather than with this frame
+        screen_shooter.capture(
+            std::move(target), params.output_space_area, params.transform, params.overlay_cursor, std::move(on_captured));
+    }
 }
 
 void mf::WlrScreencopyFrameV1::prepare_target(wl_resource* buffer)
@@ -458,14 +491,18 @@ void mf::WlrScreencopyFrameV1::prepare_target(wl_resource* buffer)
             "Attempted to copy frame multiple times"};
     }
     copy_has_been_called = true;
-    auto shm_buffer = mf::ShmBuffer::from(buffer);
-    if (!shm_buffer)
+    if (auto shm_buffer = mf::ShmBuffer::from(buffer))
     {
-        throw mw::ProtocolError{
-            resource,
-            Error::invalid_buffer,
-            "Copy target is not a wl_shm buffer"};
+        prepare_shm_target(shm_buffer);
+    }
+    else
+    {
+        prepare_dma_buf_target(buffer);
     }
+}
+
+void mf::WlrScreencopyFrameV1::prepare_shm_target(ShmBuffer* shm_buffer)
+{
     auto shm_data = shm_buffer->data();
     if (shm_data->format() != mir_pixel_format_argb_8888)
     {
@@ -513,6 +550,47 @@ void mf::WlrScreencopyFrameV1::prepare_target(wl_resource* buffer)
     };
 }
 
+void mf::WlrScreencopyFrameV1::prepare_dma_buf_target(wl_resource* buffer)
+{
+    if (!manager || !manager.value().screen_shooter->supports_dma_buf_targets())
+    {
+        throw mw::ProtocolError{
+            resource,
+            Error::invalid_buffer,
+            "Copy target is not a wl_shm buffer"};
+    }
+
+    auto dma_buf = dma_buf_capture_target(buffer);
+    if (!dma_buf)
+    {
+        throw mw::ProtocolError{
+            resource,
+            Error::invalid_buffer,
+            "Copy target is neither a wl_shm nor a linux-dmabuf buffer"};
+    }
+    if (dma_buf->format() != DRM_FORMAT_ARGB8888)
+    {
+        throw mw::ProtocolError{
+            resource,
+            Error::invalid_buffer,
+            "Invalid DMA-BUF format %s",
+            dma_buf->format().name()};
+    }
+    if (dma_buf->size() != params.buffer_size)
+    {
+        throw mw::ProtocolError{
+            resource,
+            Error::invalid_buffer,
+            "Invalid buffer size %dx%d, should be %dx%d",
+            dma_buf->size().width.as_int(),
+            dma_buf->size().height.as_int(),
+            params.buffer_size.width.as_int(),
+            params.buffer_size.height.as_int()};
+    }
+
+    dma_buf_target = std::move(dma_buf);
+}
+
 void mf::WlrScreencopyFrameV1::report_result(
     std::optional<time::Timestamp> captured_time,
     geom::Rectangle buffer_space_damage)
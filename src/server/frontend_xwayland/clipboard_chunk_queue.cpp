@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clipboard_chunk_queue.h"
+
+#include <sys/uio.h>
+
+#include <algorithm>
+
+namespace mf = mir::frontend;
+
+namespace
+{
+// Enough to fill a pipe in one call without building a large iovec array
+size_t const max_chunks_per_write = 16;
+}
+
+void mf::ClipboardChunkQueue::push(std::vector<uint8_t>&& chunk)
+{
+    if (chunk.empty())
+    {
+        return;
+    }
+    pending += chunk.size();
+    chunks.push_back(std::move(chunk));
+}
+
+auto mf::ClipboardChunkQueue::write_to(int fd) -> ssize_t
+{
+    if (chunks.empty())
+    {
+        return 0;
+    }
+
+    iovec iov[max_chunks_per_write];
+    auto const iov_count = std::min(chunks.size(), max_chunks_per_write);
+    for (auto i = 0u; i < iov_count; ++i)
+    {
+        auto const skip = i == 0 ? written_from_front : 0;
+        iov[i].iov_base = chunks[i].data() + skip;
+        iov[i].iov_len = chunks[i].size() - skip;
+    }
+
+    auto const written = writev(fd, iov, static_cast<int>(iov_count));
+    if (written < 0)
+    {
+        return written;
+    }
+
+    pending -= written;
+    auto remaining = static_cast<size_t>(written) + written_from_front;
+    while (!chunks.empty() && remaining >= chunks.front().size())
+    {
+        remaining -= chunks.front().size();
+        chunks.pop_front();
+    }
+    written_from_front = remaining;
+
+    return written;
+}
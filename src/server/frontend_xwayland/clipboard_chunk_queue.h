@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_CLIPBOARD_CHUNK_QUEUE_H_
+#define MIR_FRONTEND_CLIPBOARD_CHUNK_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace mir
+{
+namespace frontend
+{
+/// Clipboard data waiting to be written to a receiver's fd
+///
+/// Chunks are written out in the order they were pushed, and are never copied or moved once queued, so the cost of a
+/// transfer is linear in its size however slowly the receiver reads it.
+class ClipboardChunkQueue
+{
+public:
+    void push(std::vector<uint8_t>&& chunk);
+
+    /// Writes as much pending data as fd will accept without blocking
+    /// \returns the number of bytes written, or -1 with errno set on failure
+    auto write_to(int fd) -> ssize_t;
+
+    auto pending_bytes() const -> size_t { return pending; }
+    auto empty() const -> bool { return pending == 0; }
+
+private:
+    std::deque<std::vector<uint8_t>> chunks;
+    size_t written_from_front{0}; ///< how much of chunks.front() has already been written
+    size_t pending{0};
+};
+}
+}
+
+#endif // MIR_FRONTEND_CLIPBOARD_CHUNK_QUEUE_H_
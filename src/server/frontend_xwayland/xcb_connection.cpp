@@ -207,36 +207,47 @@ void mf::XCBConnection::verify_not_in_error_state() const
 }
 
 auto mf::XCBConnection::query_name(xcb_atom_t atom) const -> std::string
+{
+    return query_names({atom}).front();
+}
+
+auto mf::XCBConnection::query_names(std::vector<xcb_atom_t> const& atoms) const -> std::vector<std::string>
 {
     std::lock_guard lock{atom_name_cache_mutex};
-    auto const iter = atom_name_cache.find(atom);
 
-    if (iter == atom_name_cache.end())
+    // Send all the requests before waiting on any reply, so uncached names cost a single round-trip
+    std::unordered_map<xcb_atom_t, xcb_get_atom_name_cookie_t> requests;
+    for (auto const atom : atoms)
     {
-        xcb_get_atom_name_cookie_t const cookie = xcb_get_atom_name(xcb_connection, atom);
-        auto const reply = make_unique_cptr(xcb_get_atom_name_reply(xcb_connection, cookie, nullptr));
+        if (!atom_name_cache.contains(atom) && !requests.contains(atom))
+        {
+            requests.emplace(atom, xcb_get_atom_name(xcb_connection, atom));
+        }
+    }
 
-        std::string name;
+    for (auto const& [atom, cookie] : requests)
+    {
+        auto const reply = make_unique_cptr(xcb_get_atom_name_reply(xcb_connection, cookie, nullptr));
 
         if (reply)
         {
-            name = std::string{
+            atom_name_cache[atom] = std::string{
                 xcb_get_atom_name_name(reply.get()),
                 static_cast<size_t>(xcb_get_atom_name_name_length(reply.get()))};
         }
         else
         {
-            name = "Atom " + std::to_string(atom);
+            atom_name_cache[atom] = "Atom " + std::to_string(atom);
         }
-
-        atom_name_cache[atom] = name;
-
-        return name;
     }
-    else
+
+    std::vector<std::string> names;
+    names.reserve(atoms.size());
+    for (auto const atom : atoms)
     {
-        return iter->second;
+        names.push_back(atom_name_cache.at(atom));
     }
+    return names;
 }
 
 auto mf::XCBConnection::reply_contains_string_data(xcb_get_property_reply_t const* reply) const -> bool
@@ -529,6 +540,8 @@ auto mf::XCBConnection::reply_debug_string(xcb_get_property_reply_t* reply) cons
                     ss << "Atom property has format " << std::to_string(reply->format);
                     break;
                 }
+                // Fetch any names we don't know yet in one go
+                query_names({static_cast<xcb_atom_t*>(ptr), static_cast<xcb_atom_t*>(ptr) + len});
                 ss << data_buffer_to_debug_string<xcb_atom_t, std::string>(
                     static_cast<xcb_atom_t*>(ptr),
                     len,
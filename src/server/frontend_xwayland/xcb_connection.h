@@ -33,6 +33,7 @@
 #include <functional>
 #include <mutex>
 #include <atomic>
+#include <memory>
 #include <optional>
 
 namespace mir
@@ -135,6 +136,27 @@ public:
         {
         }
 
+        /// A handler that only calls through to this one while \p owner is alive
+        /// (replies must still be collected after the owner is gone, or they stay queued on the connection)
+        auto while_alive(std::weak_ptr<void const> const& owner) const -> Handler<T>
+        {
+            return Handler<T>{
+                [owner, on_success = on_success](T const& value)
+                {
+                    if (auto const live = owner.lock())
+                    {
+                        on_success(value);
+                    }
+                },
+                [owner, on_error = on_error](std::string const& message)
+                {
+                    if (auto const live = owner.lock())
+                    {
+                        on_error(message);
+                    }
+                }};
+        }
+
         std::function<void(T const& value)> on_success;
         std::function<void(std::string const& message)> on_error;
     };
@@ -151,6 +173,8 @@ public:
 
     /// Looks up an atom's name, or requests it from the X server if it is not already cached
     auto query_name(xcb_atom_t atom) const -> std::string;
+    /// Looks up several atoms' names, requesting any that are not cached from the X server in a single round-trip
+    auto query_names(std::vector<xcb_atom_t> const& atoms) const -> std::vector<std::string>;
     auto reply_contains_string_data(xcb_get_property_reply_t const* reply) const -> bool;
     auto string_from(xcb_get_property_reply_t const* reply) const -> std::string;
 
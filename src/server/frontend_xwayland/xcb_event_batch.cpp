@@ -0,0 +1,63 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "xcb_event_batch.h"
+
+#include <mir/log.h>
+
+namespace mf = mir::frontend;
+
+void mf::handle_event_batch(
+    std::vector<UniqueCPtr<xcb_generic_event_t>> const& events,
+    std::function<std::function<void()>(xcb_generic_event_t* event)> const& prefetch,
+    std::function<void()> const& flush,
+    std::function<void(xcb_generic_event_t* event, std::function<void()> const& prefetched)> const& handle)
+{
+    std::vector<std::function<void()>> prefetched(events.size());
+    for (auto i = 0u; i < events.size(); i++)
+    {
+        try
+        {
+            prefetched[i] = prefetch(events[i].get());
+        }
+        catch (...)
+        {
+            log(
+                logging::Severity::warning,
+                MIR_LOG_COMPONENT,
+                std::current_exception(),
+                "Error requesting data for XCB event");
+        }
+    }
+
+    flush();
+
+    for (auto i = 0u; i < events.size(); i++)
+    {
+        try
+        {
+            handle(events[i].get(), prefetched[i]);
+        }
+        catch (...)
+        {
+            log(
+                logging::Severity::warning,
+                MIR_LOG_COMPONENT,
+                std::current_exception(),
+                "Error processing XCB event");
+        }
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_XCB_EVENT_BATCH_H_
+#define MIR_FRONTEND_XCB_EVENT_BATCH_H_
+
+#include <mir/c_memory.h>
+
+#include <xcb/xcb.h>
+#include <functional>
+#include <vector>
+
+namespace mir
+{
+namespace frontend
+{
+/// Handles a batch of XCB events in the order they arrived
+///
+/// Every event is passed to prefetch before any is handled, so that everything the batch needs to read from the X
+/// server is requested in one round-trip; flush is called once they all have been. Each event is then passed to
+/// handle with the function prefetch returned for it (empty if there was nothing to read). An event earlier in the
+/// batch may have destroyed what a prefetched function applies its replies to, so those functions must cope with that.
+/// An exception handling one event is logged, and does not stop the rest of the batch from being handled.
+void handle_event_batch(
+    std::vector<UniqueCPtr<xcb_generic_event_t>> const& events,
+    std::function<std::function<void()>(xcb_generic_event_t* event)> const& prefetch,
+    std::function<void()> const& flush,
+    std::function<void(xcb_generic_event_t* event, std::function<void()> const& prefetched)> const& handle);
+}
+}
+
+#endif // MIR_FRONTEND_XCB_EVENT_BATCH_H_
@@ -25,6 +25,7 @@
 #include <xcb/xfixes.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <algorithm>
 
 namespace mf = mir::frontend;
 namespace ms = mir::scene;
@@ -32,7 +33,23 @@ namespace md = mir::dispatch;
 
 namespace
 {
-size_t const increment_chunk_size = 64 * 1024;
+size_t const min_increment_chunk_size = 64 * 1024;
+// Bounds the memory each transfer holds, however large a request the X server would accept
+size_t const max_increment_chunk_size = 1024 * 1024;
+
+/// The largest chunk of property data the X server will accept in a single ChangeProperty request
+auto increment_chunk_size_for(mf::XCBConnection const& connection) -> size_t
+{
+    // The maximum request length is in four-byte units, and includes the request header (which BIG-REQUESTS extends
+    // by a further four bytes)
+    auto const max_request_bytes = static_cast<size_t>(xcb_get_maximum_request_length(connection)) * 4;
+    auto const header_bytes = sizeof(xcb_change_property_request_t) + 4;
+    if (max_request_bytes <= header_bytes + min_increment_chunk_size)
+    {
+        return min_increment_chunk_size;
+    }
+    return std::min(max_request_bytes - header_bytes, max_increment_chunk_size);
+}
 
 auto create_selection_window(mf::XCBConnection const& connection) -> xcb_window_t
 {
@@ -93,7 +110,8 @@ public:
         xcb_window_t requester,
         xcb_atom_t selection,
         xcb_atom_t property,
-        xcb_atom_t target)
+        xcb_atom_t target,
+        size_t chunk_size)
         : connection{connection},
           provider{provider},
           source_fd{std::move(source_fd)},
@@ -102,7 +120,7 @@ public:
           selection{selection},
           property{property},
           target{target},
-          buffer_size{increment_chunk_size},
+          buffer_size{chunk_size},
           data_size{0},
           buffer{new uint8_t[buffer_size]}
     {
@@ -125,30 +143,25 @@ private:
 
         if (events & md::FdEvent::readable || events & md::FdEvent::remote_closed)
         {
-            auto const free_space = buffer_size - data_size;
-            ssize_t len = 0;
-            if (free_space > 0)
+            auto const len = read(source_fd, buffer.get() + data_size, buffer_size - data_size);
+            if (len < 0)
             {
-                len = read(source_fd, buffer.get() + data_size, free_space);
-                if (len < 0)
-                {
-                    // Error reading from fd
-                    notify_cancelled(mir::errno_to_cstr(errno));
-                    return false;
-                }
-                data_size += len;
+                // Error reading from fd
+                notify_cancelled(mir::errno_to_cstr(errno));
+                return false;
             }
+            data_size += len;
 
-            if (len == 0)
+            if (len == 0 || data_size == buffer_size)
             {
-                // We've either hit EOF or filled up our buffer
+                // We've either hit EOF or filled up our buffer; either way there's no point waiting to send it
 
                 if (incremental_transfer_in_progress)
                 {
                     // Time to send more data.
                     progress_incremental_transfer();
                 }
-                else if (free_space == 0)
+                else if (data_size == buffer_size)
                 {
                     // We filled up the buffer. Long buffers need to use incremental transfers.
                     initiate_incremental_transfer();
@@ -303,7 +316,8 @@ mf::XWaylandClipboardProvider::XWaylandClipboardProvider(
       dispatcher{dispatcher},
       clipboard{clipboard},
       clipboard_observer{std::make_shared<ClipboardObserver>(this)},
-      selection_window{create_selection_window(*connection)}
+      selection_window{create_selection_window(*connection)},
+      increment_chunk_size{increment_chunk_size_for(*connection)}
 {
     clipboard->register_interest(clipboard_observer);
     if (auto const source = clipboard->paste_source())
@@ -472,7 +486,8 @@ void mf::XWaylandClipboardProvider::send_data(
         requester,
         connection->CLIPBOARD,
         property,
-        target));
+        target,
+        increment_chunk_size));
 }
 
 void mf::XWaylandClipboardProvider::paste_source_set(std::shared_ptr<ms::DataExchangeSource> const& source)
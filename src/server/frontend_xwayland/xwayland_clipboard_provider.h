@@ -104,6 +104,8 @@ private:
     std::shared_ptr<scene::Clipboard> const clipboard;
     std::shared_ptr<ClipboardObserver> const clipboard_observer;
     xcb_window_t const selection_window;
+    /// How much data we send to an X11 client at once; also the largest transfer we send without INCR
+    size_t const increment_chunk_size;
 
     std::mutex mutex;
     /// The timestamp of when we took ownership of the clipboard. May be XCB_TIME_CURRENT_TIME or outdated if we haven't
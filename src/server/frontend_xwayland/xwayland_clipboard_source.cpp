@@ -15,6 +15,7 @@
  */
 
 #include "xwayland_clipboard_source.h"
+#include "clipboard_chunk_queue.h"
 
 #include "xwayland_log.h"
 #include <mir/errno_utils.h>
@@ -124,31 +125,74 @@ private:
     XWaylandClipboardSource* owner; ///< Can be null
 };
 
+/// Callbacks from DataSenders, which may outlive us in the dispatcher, reach us through this
+struct mf::XWaylandClipboardSource::Lifetime
+{
+    explicit Lifetime(XWaylandClipboardSource* source)
+        : source{source}
+    {
+    }
+
+    /// Calls f(source) unless the source has been destroyed, which waits until f() returns
+    template<typename F>
+    void if_alive(F&& f)
+    {
+        std::lock_guard lock{mutex};
+        if (source)
+        {
+            f(*source);
+        }
+    }
+
+    std::mutex mutex;
+    XWaylandClipboardSource* source;
+};
+
 class mf::XWaylandClipboardSource::DataSender : public md::Dispatchable
 {
 public:
-    DataSender(mir::Fd const& destination_fd)
-        : destination_fd{destination_fd}
+    /// \param on_failure  Called, with this, when the data can not be written to \p destination_fd
+    DataSender(mir::Fd const& destination_fd, std::function<void(DataSender const*)>&& on_failure)
+        : destination_fd{destination_fd},
+          on_failure{std::move(on_failure)}
     {
     }
 
     /// Returns if the previous buffer was empty. If return value is true, this needs to be added to the dispatcher.
     auto add_data(std::vector<uint8_t>&& new_data) -> bool {
         std::lock_guard lock{mutex};
-        if (data.empty())
+        auto const was_empty = pending.empty();
+        pending.push(std::move(new_data));
+        return was_empty;
+    }
+
+    /// Returns true if the receiver has caught up enough for us to accept another chunk from the X11 client now,
+    /// otherwise request_more() is called (on the dispatcher thread) once it has
+    auto ready_for_more_or(std::function<void()>&& request_more) -> bool
+    {
+        std::lock_guard lock{mutex};
+        if (pending.pending_bytes() < max_backlog)
         {
-            data = std::move(new_data);
             return true;
         }
-        else
-        {
-            data.reserve(data.size() + new_data.size());
-            std::copy(new_data.begin(), new_data.end(), std::back_inserter(data));
-            return false;
-        }
+
+        resume = std::move(request_more);
+        return false;
+    }
+
+    /// Drops any pending ready_for_more_or() request
+    void cancel_resume()
+    {
+        std::lock_guard lock{mutex};
+        resume = nullptr;
     }
 
 private:
+    /* An X11 client sends the next chunk of an incremental transfer as soon as we delete the last one, so if the
+     * receiver reads more slowly than the X11 client writes we hold off deleting it until this much has drained.
+     */
+    static size_t constexpr max_backlog{4 * 1024 * 1024};
+
     auto watch_fd() const -> mir::Fd override
     {
         return destination_fd;
@@ -156,32 +200,38 @@ private:
 
     auto dispatch(md::FdEvents events) -> bool override
     {
-        std::lock_guard lock{mutex};
+        std::unique_lock lock{mutex};
 
         if (events & md::FdEvent::error)
         {
             mir::log_error("failed to send X11 clipboard data: fd error");
-            return false;
+            return fail(std::move(lock));
         }
 
         if (events & md::FdEvent::remote_closed)
         {
             mir::log_error("failed to send X11 clipboard data: fd closed");
-            return false;
+            return fail(std::move(lock));
         }
 
         if (events & md::FdEvent::writable)
         {
-            auto const len = write(destination_fd, &data[0], data.size());
-            if (len < 0)
+            if (pending.write_to(destination_fd) < 0)
             {
                 mir::log_error("failed to send X11 clipboard data: %s", mir::errno_to_cstr(errno));
-                return false;
+                return fail(std::move(lock));
             }
-            data.erase(data.begin(), data.begin() + len);
         }
 
-        return !data.empty();
+        auto const keep_writing = !pending.empty();
+        if (resume && pending.pending_bytes() < max_backlog)
+        {
+            auto const request_more = std::exchange(resume, nullptr);
+            lock.unlock();
+            request_more();
+        }
+
+        return keep_writing;
     }
 
     auto relevant_events() const -> md::FdEvents override
@@ -189,10 +239,22 @@ private:
         return md::FdEvent::writable;
     }
 
+    /// Gives up on the transfer, so that the source can start another
+    auto fail(std::unique_lock<std::mutex> lock) -> bool
+    {
+        resume = nullptr;
+        lock.unlock();
+
+        on_failure(this);
+        return false;
+    }
+
     mir::Fd const destination_fd;
+    std::function<void(DataSender const*)> const on_failure;
 
     std::mutex mutex;
-    std::vector<uint8_t> data;
+    ClipboardChunkQueue pending;
+    std::function<void()> resume;
 };
 
 mf::XWaylandClipboardSource::XWaylandClipboardSource(
@@ -202,7 +264,8 @@ mf::XWaylandClipboardSource::XWaylandClipboardSource(
     : connection{connection},
       dispatcher{dispatcher},
       clipboard{clipboard},
-      receiving_window{create_receiving_window(connection)}
+      receiving_window{create_receiving_window(connection)},
+      lifetime{std::make_shared<Lifetime>(this)}
 {
 }
 
@@ -221,8 +284,19 @@ auto mf::XWaylandClipboardSource::source_is_from(ms::DataExchangeSource* source,
 
 mf::XWaylandClipboardSource::~XWaylandClipboardSource()
 {
+    {
+        // Waits for any callback from a DataSender to finish (so must not hold our mutex)
+        std::lock_guard lifetime_lock{lifetime->mutex};
+        lifetime->source = nullptr;
+    }
+
     std::unique_lock lock{mutex};
     auto const source_to_reset = std::move(clipboard_source);
+    if (in_progress_send)
+    {
+        // It may outlive us in the dispatcher, so mustn't ask us for more data
+        in_progress_send->cancel_resume();
+    }
     lock.unlock();
 
     if (source_to_reset)
@@ -245,7 +319,12 @@ void mf::XWaylandClipboardSource::initiate_send(xcb_atom_t target_type, Fd const
         log_error("can not send clipboard data from X11 because another send is currently in progress");
         return;
     }
-    in_progress_send = std::make_shared<DataSender>(receiver_fd);
+    in_progress_send = std::make_shared<DataSender>(
+        receiver_fd,
+        [lifetime = lifetime](DataSender const* sender)
+        {
+            lifetime->if_alive([sender](XWaylandClipboardSource& source) { source.abort_send(sender); });
+        });
     lock.unlock();
 
     if (verbose_xwayland_logging_enabled())
@@ -407,10 +486,11 @@ void mf::XWaylandClipboardSource::create_source(xcb_timestamp_t timestamp, std::
 
 void mf::XWaylandClipboardSource::read_and_send_wl_selection_data(std::lock_guard<std::mutex> const& lock)
 {
+    // Deleting the property is what asks the X11 client for the next chunk, so that waits until we're ready for it
     auto const completion = connection.read_property(
         receiving_window,
         connection._WL_SELECTION,
-        true, // delete
+        false, // delete
         0x1fffffff, // length lifted from Weston
         {[&](xcb_get_property_reply_t* reply)
         {
@@ -421,6 +501,8 @@ void mf::XWaylandClipboardSource::read_and_send_wl_selection_data(std::lock_guar
                     log_info("Initiating incremental data transfer from X11");
                 }
                 incremental_transfer_in_progress = true;
+                // Deleting the INCR property starts the transfer
+                request_next_chunk();
             }
             else
             {
@@ -432,7 +514,13 @@ void mf::XWaylandClipboardSource::read_and_send_wl_selection_data(std::lock_guar
         [&](const std::string& error_message)
         {
             log_error("Error getting selection property: %s", error_message.c_str());
+            if (in_progress_send)
+            {
+                in_progress_send->cancel_resume();
+            }
             in_progress_send.reset();
+            incremental_transfer_in_progress = false;
+            request_next_chunk();
         }});
 
     completion();
@@ -447,6 +535,7 @@ void mf::XWaylandClipboardSource::add_data_to_in_progress_send(
     if (!in_progress_send)
     {
         log_error("Can not send clipboard data from X11 because there is no send in progress");
+        request_next_chunk();
         return;
     }
 
@@ -471,5 +560,40 @@ void mf::XWaylandClipboardSource::add_data_to_in_progress_send(
         // in_progress_send may still be sending data on it's fd, but the dispatcher will hold onto it until it's done
         in_progress_send.reset();
         incremental_transfer_in_progress = false;
+        request_next_chunk();
     }
+    else
+    {
+        // This may run on the dispatcher thread, after we have been destroyed
+        auto const ready = in_progress_send->ready_for_more_or(
+            [lifetime = lifetime]()
+            {
+                lifetime->if_alive([](XWaylandClipboardSource& source) { source.request_next_chunk(); });
+            });
+
+        if (ready)
+        {
+            request_next_chunk();
+        }
+    }
+}
+
+void mf::XWaylandClipboardSource::abort_send(DataSender const* sender)
+{
+    std::lock_guard lock{mutex};
+    if (in_progress_send.get() != sender)
+    {
+        // The transfer has already finished, and a new one may have started
+        return;
+    }
+
+    in_progress_send.reset();
+    incremental_transfer_in_progress = false;
+    request_next_chunk();
+}
+
+void mf::XWaylandClipboardSource::request_next_chunk()
+{
+    connection.delete_property(receiving_window, connection._WL_SELECTION);
+    connection.flush();
 }
@@ -62,6 +62,7 @@ public:
 private:
     class ClipboardSource;
     class DataSender;
+    struct Lifetime;
 
     XWaylandClipboardSource(XWaylandClipboardSource const&) = delete;
     XWaylandClipboardSource& operator=(XWaylandClipboardSource const&) = delete;
@@ -76,6 +77,12 @@ private:
     /// Sends the given data to the current destination fd
     void add_data_to_in_progress_send(std::lock_guard<std::mutex> const& lock, uint8_t* data_ptr, size_t data_size);
 
+    /// Abandons the transfer \p sender was making, if it is still in progress
+    void abort_send(DataSender const* sender);
+
+    /// Deletes _WL_SELECTION, which tells the X11 client we have consumed its contents
+    void request_next_chunk();
+
     XCBConnection& connection;
     std::shared_ptr<dispatch::MultiplexingDispatchable> const dispatcher;
     std::shared_ptr<scene::Clipboard> const clipboard;
@@ -87,6 +94,7 @@ private:
     std::shared_ptr<ClipboardSource> clipboard_source;
     bool incremental_transfer_in_progress{false};
     std::shared_ptr<DataSender> in_progress_send;
+    std::shared_ptr<Lifetime> const lifetime;
 };
 }
 }
@@ -20,6 +20,7 @@
 #include <mir/log.h>
 #include <mir/options/default_configuration.h>
 #include <mir/main_loop.h>
+#include <mir/startup_report.h>
 #include "wayland_connector.h"
 #include "xwayland_connector.h"
 
@@ -66,6 +67,7 @@ std::shared_ptr<mf::Connector> mir::DefaultServerConfiguration::the_xwayland_con
 {
     return xwayland_connector([this]() -> std::shared_ptr<mf::Connector> {
 
+        StartupPhase const phase{the_startup_report(), "XWayland connector"};
         auto options = the_options();
         auto const x11_enabled = options->is_set(mo::x11_display_opt) && options->get<bool>(mo::x11_display_opt);
 
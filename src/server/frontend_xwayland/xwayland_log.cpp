@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "xwayland_log.h"
+
+namespace ml = mir::logging;
+
+auto mir::xwayland_logging() -> ml::Tag const&
+{
+    static ml::Tag const& xwayland = []() -> ml::Tag const&
+        {
+            auto const& tag = ml::create_tag(ml::wayland(), "xwayland");
+            if (std::getenv("MIR_X11_VERBOSE_LOG"))
+            {
+                ml::tag::set_severity("base/wayland/xwayland", ml::Severity::debug);
+            }
+            return tag;
+        }();
+    return xwayland;
+}
+
+namespace
+{
+// Register the tag during server initialisation, so that --log-level can refer to it
+auto const& ensure_xwayland_registered = mir::xwayland_logging();
+}
@@ -23,10 +23,17 @@
 
 namespace mir
 {
+/// The "xwayland" logging tag, at debug severity if MIR_X11_VERBOSE_LOG is set
+auto xwayland_logging() -> logging::Tag const&;
+
+/// Whether to log verbosely: if the "xwayland" tag is at debug severity, or MIR_X11_VERBOSE_LOG is set
+///
+/// The environment is checked each time because tag severities are reset whenever a live log_level
+/// configuration is applied, which would otherwise silently undo MIR_X11_VERBOSE_LOG.
 inline auto verbose_xwayland_logging_enabled() -> bool
 {
-    static bool const log_verbose = std::getenv("MIR_X11_VERBOSE_LOG");
-    return log_verbose;
+    return logging::logging_enabled_for({xwayland_logging()}, logging::Severity::debug) ||
+        std::getenv("MIR_X11_VERBOSE_LOG");
 }
 } /* mir */
 
@@ -20,6 +20,7 @@
 #include "xwayland_spawner.h"
 #include "wayland_connector.h"
 #include <mir/log.h>
+#include <mir/memory_accounting.h>
 #include <mir/wayland/client.h>
 
 #include <boost/throw_exception.hpp>
@@ -177,11 +178,14 @@ mf::XWaylandServer::XWaylandServer(
       wayland_client{connect_xwayland_wl_client(wayland_connector, xwayland.wayland_fd, scale)},
       running{true}
 {
+    // Xwayland is charged for every X11 app; disconnecting it for one of them would take down them all
+    mir::memory::ledger().exempt_from_refusal(xwayland.pid);
 }
 
 mf::XWaylandServer::~XWaylandServer()
 {
     mir::log_info("Deiniting xwayland server");
+    mir::memory::ledger().end_exemption_from_refusal(xwayland.pid);
 
     // Terminate any running xservers
     if (kill(xwayland.pid, SIGTERM) == 0)
@@ -295,13 +295,13 @@ auto property_handler(
     std::shared_ptr<mf::XCBConnection> const& connection,
     xcb_window_t window,
     xcb_atom_t property,
-    mf::XCBConnection::Handler<T>&& handler) -> std::pair<xcb_atom_t, std::function<std::function<void()>()>>
+    mf::XCBConnection::Handler<T>&& handler) -> std::pair<xcb_atom_t, mf::XWaylandSurface::PropertyReader>
 {
     return std::make_pair(
         property,
-        [connection, window, property, handler = std::move(handler)]()
+        [connection, window, property, handler = std::move(handler)](std::weak_ptr<void const> const& owner)
         {
-            return connection->read_property(window, property, std::move(handler));
+            return connection->read_property(window, property, handler.while_alive(owner));
         });
 }
 
@@ -310,7 +310,7 @@ auto property_handler(
     std::shared_ptr<mf::XCBConnection> const& connection,
     xcb_window_t window,
     xcb_atom_t property,
-    std::function<void(T const&)> handler) -> std::pair<xcb_atom_t, std::function<std::function<void()>()>>
+    std::function<void(T const&)> handler) -> std::pair<xcb_atom_t, mf::XWaylandSurface::PropertyReader>
 {
     return property_handler<T>(connection, window, property, mf::XCBConnection::Handler<T>{std::move(handler)});
 }
@@ -679,16 +679,25 @@ void mf::XWaylandSurface::wm_change_state_client_message(uint32_t const (&data)[
     request_scene_surface_state(new_state.active_mir_state());
 }
 
-void mf::XWaylandSurface::property_notify(xcb_atom_t property)
+auto mf::XWaylandSurface::property_notify(xcb_atom_t property) -> std::function<void()>
 {
     auto const handler = property_handlers.find(property);
-    if (handler != property_handlers.end())
+    if (handler == property_handlers.end())
     {
-        auto completion = handler->second();
-        completion();
-
-        apply_any_mods_to_scene_surface();
+        return {};
     }
+
+    // The reply may be collected after the surface is destroyed by an earlier event in the same batch
+    return [weak_self = weak_from_this(), completion = handler->second(weak_from_this())]()
+        {
+            auto const self = weak_self.lock();
+            completion();
+
+            if (self)
+            {
+                self->apply_any_mods_to_scene_surface();
+            }
+        };
 }
 
 void mf::XWaylandSurface::attach_wl_surface(WlSurface* wl_surface)
@@ -705,7 +714,6 @@ void mf::XWaylandSurface::attach_wl_surface(WlSurface* wl_surface)
 
     auto state = StateTracker::make_withdrawn();
     shell::SurfaceSpecification spec;
-    std::vector<std::shared_ptr<void>> keep_alive_until_spec_is_used;
 
     auto const observer = std::make_shared<XWaylandSurfaceObserver>(
         *wm_shell.wayland_executor,
@@ -719,7 +727,7 @@ void mf::XWaylandSurface::attach_wl_surface(WlSurface* wl_surface)
 
         state = cached.state;
 
-        XWaylandSurfaceRole::populate_surface_data_scaled(wl_surface, scale, spec, keep_alive_until_spec_is_used);
+        XWaylandSurfaceRole::populate_surface_data(wl_surface, spec);
 
         // May be overridden by anything in the pending spec
         spec.top_left = cached.geometry.top_left;
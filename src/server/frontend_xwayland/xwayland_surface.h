@@ -66,9 +66,14 @@ enum class NetWmStateAction: uint32_t
 
 class XWaylandSurface
     : public XWaylandSurfaceRoleSurface,
-      public XWaylandSurfaceObserverSurface
+      public XWaylandSurfaceObserverSurface,
+      public std::enable_shared_from_this<XWaylandSurface>
 {
 public:
+    /// Requests a property, returning a function that waits on the reply and, if the owner is
+    /// still alive, applies it
+    using PropertyReader = std::function<std::function<void()>(std::weak_ptr<void const> const& owner)>;
+
     XWaylandSurface(
         XWaylandWM *wm,
         std::shared_ptr<XCBConnection> const& connection,
@@ -87,8 +92,10 @@ public:
     void configure_notify(xcb_configure_notify_event_t* event);
     void net_wm_state_client_message(uint32_t const (&data)[5]);
     void wm_change_state_client_message(uint32_t const (&data)[5]);
-    void property_notify(xcb_atom_t property);
-    void attach_wl_surface(WlSurface* wl_surface); ///< Should only be called on the Wayland thread
+    /// Requests the new value of a changed property, if it is one we track
+    /// Returns a function that waits on the reply and applies it, or an empty function if there is nothing to read
+    /// The returned function is safe to call after this surface is destroyed
+    auto property_notify(xcb_atom_t property) -> std::function<void()>;
     void move_resize(uint32_t detail);
 
 private:
@@ -149,6 +156,7 @@ private:
     /// @{
     void wl_surface_destroyed() override;
     auto scene_surface() const -> std::optional<std::shared_ptr<scene::Surface>> override;
+    void attach_wl_surface(WlSurface* wl_surface) override;
     /// @}
 
     /// Creates a pending spec if needed and returns a reference
@@ -187,7 +195,8 @@ private:
     /// function handles all that.
     void prep_surface_spec(ProofOfMutexLock const&, shell::SurfaceSpecification& mods);
 
-    /// Return data from any surface scaled to XWayland coordinates
+    /// Return data from any surface scaled to XWayland coordinates. All geometry sent to X goes through these, so X
+    /// clients size their windows (and so their buffers) in raw pixels at the XWayland scale.
     /// @{
     auto scaled_top_left_of(scene::Surface const& surface) -> geometry::Point;
     auto scaled_content_offset_of(scene::Surface const& surface) -> geometry::Displacement;
@@ -212,7 +221,7 @@ private:
     std::shared_ptr<XWaylandClientManager> const client_manager;
     xcb_window_t const window;
     float const scale;
-    std::map<xcb_window_t, std::function<std::function<void()>()>> const property_handlers;
+    std::map<xcb_window_t, PropertyReader> const property_handlers;
 
     std::mutex mutable mutex;
 
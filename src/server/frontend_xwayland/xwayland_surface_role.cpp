@@ -16,7 +16,6 @@
 
 #include "xwayland_surface_role.h"
 #include "xwayland_surface_role_surface.h"
-#include "scaled_buffer_stream.h"
 #include "xwayland_log.h"
 
 #include "wl_surface.h"
@@ -41,6 +40,14 @@ mf::XWaylandSurfaceRole::XWaylandSurfaceRole(
       scale{scale}
 {
     wl_surface->set_role(this);
+
+    // X clients always render in raw pixels, which at our scale are exactly the output's physical pixels. Treating
+    // the XWayland scale as the buffer scale sizes the surface's stream in logical coordinates, so nothing needs to
+    // resample the buffer on its way to the screen.
+    WlSurfaceState state;
+    state.scale = scale;
+    wl_surface->commit(state);
+
     if (verbose_xwayland_logging_enabled())
     {
         log_debug("Created XWaylandSurfaceRole for wl_surface@%u", wl_resource_get_id(wl_surface->resource));
@@ -56,33 +63,23 @@ mf::XWaylandSurfaceRole::~XWaylandSurfaceRole()
     }
 }
 
-void mf::XWaylandSurfaceRole::populate_surface_data_scaled(
+void mf::XWaylandSurfaceRole::attach(
+    std::shared_ptr<shell::Shell> const& shell,
+    std::shared_ptr<XWaylandSurfaceRoleSurface> const& wm_surface,
     WlSurface* wl_surface,
-    float scale,
-    shell::SurfaceSpecification& spec,
-    std::vector<std::shared_ptr<void>>& keep_alive_until_spec_is_used)
+    float scale)
+{
+    // Will destroy itself
+    new XWaylandSurfaceRole{shell, wm_surface, wl_surface, scale};
+
+    wm_surface->attach_wl_surface(wl_surface);
+}
+
+void mf::XWaylandSurfaceRole::populate_surface_data(WlSurface* wl_surface, shell::SurfaceSpecification& spec)
 {
     spec.streams = std::vector<shell::StreamSpecification>();
     spec.input_shape = std::vector<geom::Rectangle>();
     wl_surface->populate_surface_data(spec.streams.value(), spec.input_shape.value(), {});
-
-    if (scale != 1.0f)
-    {
-        auto const inv_scale = 1.0f / scale;
-
-        for (auto& stream : spec.streams.value())
-        {
-            if (auto inner = std::dynamic_pointer_cast<mc::BufferStream>(stream.stream.lock()))
-            {
-                // We could set the scale of the original stream, but then the WlSurface would see the scaled size.
-                // Instead, we wrap the surface's stream in our own that scales without the surface knowing.
-                auto scaled = std::make_shared<ScaledBufferStream>(std::move(inner), scale);
-                stream.stream = scaled;
-                keep_alive_until_spec_is_used.push_back(std::move(scaled));
-            }
-            stream.displacement = stream.displacement * inv_scale;
-        }
-    }
 }
 
 auto mf::XWaylandSurfaceRole::scene_surface() const -> std::optional<std::shared_ptr<scene::Surface>>
@@ -107,8 +104,7 @@ void mf::XWaylandSurfaceRole::refresh_surface_data_now()
         return;
 
     shell::SurfaceSpecification spec;
-    std::vector<std::shared_ptr<void>> keep_alive_until_spec_is_used;
-    populate_surface_data_scaled(wl_surface, scale, spec, keep_alive_until_spec_is_used);
+    populate_surface_data(wl_surface, spec);
     shell->modify_surface(session, surface.value(), spec);
 }
 
@@ -119,11 +115,13 @@ void mf::XWaylandSurfaceRole::commit(WlSurfaceState const& state)
         BOOST_THROW_EXCEPTION(std::runtime_error("Got XWaylandSurfaceRole::commit() when the role had no surface"));
     }
 
-    // HACK: Some applications might scale up while users don't want them to
-    // `--x11-scale` helps with this by scaling down the application according
-    // to user preference.
+    // Xwayland does not set a buffer scale, but if anything does it must not override the one applied in the
+    // constructor: X clients always render at the XWayland scale.
     auto state_copy{state};
-    state_copy.scale = scale;
+    if (state_copy.scale)
+    {
+        state_copy.scale = scale;
+    }
 
     wl_surface->commit(state_copy);
 
@@ -144,10 +142,9 @@ void mf::XWaylandSurfaceRole::commit(WlSurfaceState const& state)
             spec.state = mir_window_state_hidden;
         }
 
-        std::vector<std::shared_ptr<void>> keep_alive_until_spec_is_used;
         if (state_copy.surface_data_needs_refresh())
         {
-            populate_surface_data_scaled(wl_surface, scale, spec, keep_alive_until_spec_is_used);
+            populate_surface_data(wl_surface, spec);
         }
 
         if (!spec.is_empty())
@@ -47,15 +47,19 @@ public:
         float scale);
     ~XWaylandSurfaceRole(); ///< Must be called on the Wayland thread!
 
-    /// Populates the buffer streams and input shape from the surface into the spec. Scales both as needed. If scale is
-    /// not 1.0 it wraps the surface's buffer streams in scaled buffer streams. These are stored in the spec as
-    /// weak_ptrs, so they are also pushed onto keep_alive_until_spec_is_used. Once you call modify_surface()
-    /// or otherwise use the spec, shared_ptrs will have been created and this can be dropped.
-    static void populate_surface_data_scaled(
+    /// Gives wl_surface an XWaylandSurfaceRole, then attaches it to wm_surface. The role comes first so that the
+    /// wl_surface's streams are already at the XWayland scale when the scene surface is created from them.
+    /// Should only be called on the Wayland thread
+    static void attach(
+        std::shared_ptr<shell::Shell> const& shell,
+        std::shared_ptr<XWaylandSurfaceRoleSurface> const& wm_surface,
         WlSurface* wl_surface,
-        float scale,
-        shell::SurfaceSpecification& spec,
-        std::vector<std::shared_ptr<void>>& keep_alive_until_spec_is_used);
+        float scale);
+
+    /// Populates the buffer streams and input shape from the surface into the spec. The role applies the XWayland
+    /// scale as the wl_surface's buffer scale, so the streams are already sized in Mir's logical coordinates and X
+    /// clients' buffers are composited at their native resolution.
+    static void populate_surface_data(WlSurface* wl_surface, shell::SurfaceSpecification& spec);
 
 private:
     std::shared_ptr<shell::Shell> const shell;
@@ -39,6 +39,7 @@ public:
 
     virtual void wl_surface_destroyed() = 0;
     virtual auto scene_surface() const -> std::optional<std::shared_ptr<scene::Surface>> = 0;
+    virtual void attach_wl_surface(WlSurface* wl_surface) = 0; ///< Should only be called on the Wayland thread
 
 private:
     XWaylandSurfaceRoleSurface(XWaylandSurfaceRoleSurface const&) = delete;
@@ -19,6 +19,7 @@
  */
 
 #include "xwayland_wm.h"
+#include "xcb_event_batch.h"
 #include "xwayland_log.h"
 #include "xwayland_surface.h"
 #include "xwayland_wm_shell.h"
@@ -282,31 +283,47 @@ mf::XWaylandWM::~XWaylandWM()
 
 void mf::XWaylandWM::handle_events()
 {
-    bool got_events = false;
-
     connection->verify_not_in_error_state();
 
-    while (auto const event = mir::make_unique_cptr(xcb_poll_for_event(*connection)))
+    /* Drain the whole batch before handling any of it, so that every property the batch
+     * needs can be requested up front and we make one round-trip for all of them, rather
+     * than one for each event.
+     */
+    std::vector<mir::UniqueCPtr<xcb_generic_event_t>> events;
+    while (auto event = mir::make_unique_cptr(xcb_poll_for_event(*connection)))
+    {
+        events.push_back(std::move(event));
+    }
+
+    if (events.empty())
     {
-        try
+        return;
+    }
+
+    handle_event_batch(
+        events,
+        [this](xcb_generic_event_t* event) { return prefetch_replies(event); },
+        [this]() { connection->flush(); },
+        [this](xcb_generic_event_t* event, std::function<void()> const& prefetched_replies)
         {
-            handle_event(event.get());
-        }
-        catch (...)
+            handle_event(event, prefetched_replies);
+        });
+
+    connection->flush();
+}
+
+auto mf::XWaylandWM::prefetch_replies(xcb_generic_event_t* event) -> std::function<void()>
+{
+    if ((event->response_type & ~0x80) == XCB_PROPERTY_NOTIFY)
+    {
+        auto const property_event = reinterpret_cast<xcb_property_notify_event_t*>(event);
+        if (auto const surface = get_wm_surface(property_event->window))
         {
-            log(
-                logging::Severity::warning,
-                MIR_LOG_COMPONENT,
-                std::current_exception(),
-                "Error processing XCB event");
+            return surface.value()->property_notify(property_event->atom);
         }
-        got_events = true;
     }
 
-    if (got_events)
-    {
-        connection->flush();
-    }
+    return {};
 }
 
 auto mf::XWaylandWM::get_wm_surface(
@@ -515,9 +532,12 @@ void mf::XWaylandWM::manage_window(xcb_window_t window, geom::Rectangle const& g
         {
             std::vector<std::function<void()>> functions;
             int const prop_count = xcb_list_properties_atoms_length(props_reply.get());
+            auto const atoms = xcb_list_properties_atoms(props_reply.get());
+            // Warm the atom name cache, rather than making a round-trip per property as we log it
+            connection->query_names({atoms, atoms + prop_count});
             for (int i = 0; i < prop_count; i++)
             {
-                auto const atom = xcb_list_properties_atoms(props_reply.get())[i];
+                auto const atom = atoms[i];
 
                 auto const log_prop = [this, atom](std::string const& value)
                     {
@@ -581,7 +601,7 @@ void mf::XWaylandWM::manage_window(xcb_window_t window, geom::Rectangle const& g
     connection->flush();
 }
 
-void mf::XWaylandWM::handle_event(xcb_generic_event_t* event)
+void mf::XWaylandWM::handle_event(xcb_generic_event_t* event, std::function<void()> const& prefetched_replies)
 {
     // see https://www.systutorials.com/docs/linux/man/3-xcb-requests/
     int const xcb_error_type = 0;
@@ -642,7 +662,7 @@ void mf::XWaylandWM::handle_event(xcb_generic_event_t* event)
             log_debug("XCB_MAPPING_NOTIFY");
         break;
     case XCB_PROPERTY_NOTIFY:
-        handle_property_notify(reinterpret_cast<xcb_property_notify_event_t *>(event));
+        handle_property_notify(reinterpret_cast<xcb_property_notify_event_t *>(event), prefetched_replies);
         break;
     case XCB_CLIENT_MESSAGE:
         handle_client_message(reinterpret_cast<xcb_client_message_event_t *>(event));
@@ -681,7 +701,9 @@ void mf::XWaylandWM::handle_event(xcb_generic_event_t* event)
     }
 }
 
-void mf::XWaylandWM::handle_property_notify(xcb_property_notify_event_t *event)
+void mf::XWaylandWM::handle_property_notify(
+    xcb_property_notify_event_t *event,
+    std::function<void()> const& prefetched_replies)
 {
     if (verbose_xwayland_logging_enabled())
     {
@@ -696,11 +718,10 @@ void mf::XWaylandWM::handle_property_notify(xcb_property_notify_event_t *event)
         {
             auto const log_prop = [this, event](std::string const& value)
                 {
-                    auto const prop_name = connection->query_name(event->atom);
                     log_debug(
                         "XCB_PROPERTY_NOTIFY (%s).%s: %s",
                         connection->window_debug_string(event->window).c_str(),
-                        prop_name.c_str(),
+                        connection->query_name(event->atom).c_str(),
                         value.c_str());
                 };
 
@@ -723,9 +744,20 @@ void mf::XWaylandWM::handle_property_notify(xcb_property_notify_event_t *event)
         }
     }
 
-    if (auto const surface = get_wm_surface(event->window))
+    if (prefetched_replies)
+    {
+        /* Even if an earlier event in the batch destroyed the surface the reply still has
+         * to be collected; it is only applied if the surface is still alive.
+         */
+        prefetched_replies();
+    }
+    else if (auto const surface = get_wm_surface(event->window))
     {
-        surface.value()->property_notify(event->atom);
+        // The surface was created by an earlier event in this batch, so nothing was prefetched
+        if (auto const reply = surface.value()->property_notify(event->atom))
+        {
+            reply();
+        }
     }
 
     // Inform the clipboard provider, in case this is part of an incremental data send
@@ -899,10 +931,7 @@ void mf::XWaylandWM::handle_surface_id(
                     auto const shell = weak_shell.lock();
                     if (surface && shell)
                     {
-                        surface->attach_wl_surface(wl_surface);
-
-                        // Will destroy itself
-                        new XWaylandSurfaceRole{shell, surface, wl_surface, scale};
+                        XWaylandSurfaceRole::attach(shell, surface, wl_surface, scale);
                     }
                     else
                     {
@@ -19,6 +19,7 @@
 #ifndef MIR_FRONTEND_XWAYLAND_WM_H
 #define MIR_FRONTEND_XWAYLAND_WM_H
 
+#include <mir/c_memory.h>
 #include <mir/dispatch/threaded_dispatcher.h>
 #include <mir/geometry/rectangle.h>
 #include "wayland_connector.h"
@@ -29,6 +30,7 @@
 #include <thread>
 #include <optional>
 #include <mutex>
+#include <vector>
 
 #include <wayland-server-core.h>
 #include <xcb/xfixes.h>
@@ -95,10 +97,15 @@ private:
     /// May occasionally be called multiple times for the same window
     void manage_window(xcb_window_t window, geometry::Rectangle const& geometry, bool override_redirect);
 
-    void handle_event(xcb_generic_event_t* event);
+    /// Requests everything the event will need to read from the X server, without waiting on any of it
+    /// Returns a function that waits on and applies the replies (empty if there are none)
+    auto prefetch_replies(xcb_generic_event_t* event) -> std::function<void()>;
+
+    /// [prefetched_replies] is as returned by prefetch_replies() for this event
+    void handle_event(xcb_generic_event_t* event, std::function<void()> const& prefetched_replies);
     void handle_create_notify(xcb_create_notify_event_t *event);
     void handle_motion_notify(xcb_motion_notify_event_t *event);
-    void handle_property_notify(xcb_property_notify_event_t *event);
+    void handle_property_notify(xcb_property_notify_event_t *event, std::function<void()> const& prefetched_replies);
     void handle_map_request(xcb_map_request_event_t *event);
     void handle_surface_id(std::weak_ptr<XWaylandSurface> const& weak_surface, xcb_client_message_event_t *event);
     void handle_move_resize(std::shared_ptr<XWaylandSurface> surface, xcb_client_message_event_t *event);
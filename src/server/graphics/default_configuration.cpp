@@ -25,6 +25,7 @@
 #include "software_cursor.h"
 #include "platform_probe.h"
 #include <mir/shell/accessibility_manager.h>
+#include <mir/startup_report.h>
 
 #include <mir/graphics/gl_config.h>
 #include <mir/graphics/platform.h>
@@ -138,6 +139,7 @@ auto mir::DefaultServerConfiguration::the_display_platforms() -> std::vector<std
 {
     if (display_platforms.empty())
     {
+        StartupPhase const phase{the_startup_report(), "Display platforms"};
         std::stringstream error_report;
 
         try
@@ -209,6 +211,7 @@ auto mir::DefaultServerConfiguration::the_rendering_platforms() ->
 {
     if (rendering_platforms.empty())
     {
+        StartupPhase const phase{the_startup_report(), "Rendering platforms"};
         std::stringstream error_report;
         std::vector<std::pair<mg::SupportedDevice, std::shared_ptr<mir::SharedLibrary>>> platform_modules;
         std::multimap<std::string, std::shared_ptr<graphics::RenderingPlatform>> rendering_platform_map;
@@ -230,6 +233,7 @@ auto mir::DefaultServerConfiguration::the_rendering_platforms() ->
             {
                 auto const manually_selected_platforms =
                     select_platforms_from_list(the_options()->get<std::string>(options::platform_rendering_libs), platforms);
+                auto const udev = std::make_shared<mir::udev::Context>();
 
                 for (auto const& platform : manually_selected_platforms)
                 {
@@ -238,7 +242,8 @@ auto mir::DefaultServerConfiguration::the_rendering_platforms() ->
                             display_targets,
                             *platform,
                             *the_options_provider()->options_for(*platform),
-                            the_console_services());
+                            the_console_services(),
+                            udev);
 
                     bool found_supported_device{false};
                     for (auto& device : supported_devices)
@@ -400,6 +405,7 @@ mir::DefaultServerConfiguration::the_display()
     return display(
         [this]() -> std::shared_ptr<mg::Display>
         {
+            StartupPhase const phase{the_startup_report(), "Display"};
             std::vector<std::unique_ptr<mg::Display>> displays;
             displays.reserve(the_display_platforms().size());
             for (auto const& platform : the_display_platforms())
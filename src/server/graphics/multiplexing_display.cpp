@@ -286,6 +286,17 @@ void mg::MultiplexingDisplay::configure(DisplayConfiguration const& conf)
     }
 }
 
+void mg::MultiplexingDisplay::configure_incrementally(
+    DisplayConfiguration const& conf,
+    std::function<void(DisplaySyncGroup&)> const& removing)
+{
+    auto const& real_conf = dynamic_cast<CompositeDisplayConfiguration const&>(conf);
+    for (auto i = 0u; i < displays.size(); ++i)
+    {
+        displays[i]->configure_incrementally(*real_conf.components[i], removing);
+    }
+}
+
 void mg::MultiplexingDisplay::register_configuration_change_handler(
     EventHandlerRegister& handlers,
     DisplayConfigurationChangeHandler const& conf_change_handler)
@@ -38,6 +38,10 @@ public:
 
     void configure(DisplayConfiguration const& conf) override;
 
+    void configure_incrementally(
+        DisplayConfiguration const& conf,
+        std::function<void(DisplaySyncGroup&)> const& removing) override;
+
     void register_configuration_change_handler(
         EventHandlerRegister& handlers,
         DisplayConfigurationChangeHandler const& conf_change_handler) override;
@@ -14,7 +14,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
- #include "platform_probe.h"
+#include "platform_probe.h"
+#include "platform_probe_cache.h"
 
 #include <mir/graphics/display.h>
 #include <mir/log.h>
@@ -27,6 +28,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <filesystem>
+#include <iterator>
 #include <boost/throw_exception.hpp>
 #include <dlfcn.h>
 
@@ -99,15 +102,16 @@ auto is_graphics_module(mir::SharedLibrary const& module) -> bool
 auto mir::graphics::probe_display_module(
     SharedLibrary const& module,
     mo::Option const& options,
-    std::shared_ptr<ConsoleServices> const& console) -> std::vector<SupportedDevice>
+    std::shared_ptr<ConsoleServices> const& console,
+    std::shared_ptr<udev::Context> const& udev) -> std::vector<SupportedDevice>
 {
     return probe_module(
-        [&console, &options, &module]() -> std::vector<mg::SupportedDevice>
+        [&console, &udev, &options, &module]() -> std::vector<mg::SupportedDevice>
         {
             auto probe = module.load_function<mir::graphics::PlatformProbe>(
                 "probe_display_platform",
                 MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
-            return probe(console, std::make_shared<mir::udev::Context>(), options);
+            return probe(console, udev, options);
         },
         module,
         "display");
@@ -117,15 +121,16 @@ auto mir::graphics::probe_rendering_module(
     std::span<std::shared_ptr<mg::DisplayPlatform>> const& platforms,
     SharedLibrary const& module,
     mo::Option const& options,
-    std::shared_ptr<ConsoleServices> const& console) -> std::vector<SupportedDevice>
+    std::shared_ptr<ConsoleServices> const& console,
+    std::shared_ptr<udev::Context> const& udev) -> std::vector<SupportedDevice>
 {
     return probe_module(
-        [&console, &options, &module, &platforms]() -> std::vector<SupportedDevice>
+        [&console, &udev, &options, &module, &platforms]() -> std::vector<SupportedDevice>
         {
             auto probe = module.load_function<mg::RenderProbe>(
                 "probe_rendering_platform",
                 MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
-            return probe(platforms, *console, std::make_shared<mir::udev::Context>(), options);
+            return probe(platforms, *console, udev, options);
         },
         module,
         "rendering");
@@ -276,18 +281,32 @@ auto mg::modules_for_device(
 #pragma GCC diagnostic push
 #endif
 
-auto mir::graphics::display_modules_for_device(
-    std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+namespace
+{
+using ModuleSelection = std::vector<std::pair<mg::SupportedDevice, std::shared_ptr<mir::SharedLibrary>>>;
+
+auto display_modules_using(
+    std::shared_ptr<mir::udev::Context> const& udev,
+    std::vector<std::shared_ptr<mir::SharedLibrary>> const& modules,
     mo::Configuration const& options,
-    std::shared_ptr<ConsoleServices> const& console) -> std::vector<std::pair<SupportedDevice, std::shared_ptr<SharedLibrary>>>
+    std::shared_ptr<mir::ConsoleServices> const& console) -> ModuleSelection
 {
-    return modules_for_device(
-        [&options, &console](mir::SharedLibrary const& module) -> std::vector<mg::SupportedDevice>
+    return mg::modules_for_device(
+        [&options, &console, &udev](mir::SharedLibrary const& module) -> std::vector<mg::SupportedDevice>
         {
-            return mg::probe_display_module(module, *options.options_for(module), console);
+            return mg::probe_display_module(module, *options.options_for(module), console, udev);
         },
         modules,
-        TypePreference::prefer_nested);
+        mg::TypePreference::prefer_nested);
+}
+}
+
+auto mir::graphics::display_modules_for_device(
+    std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+    mo::Configuration const& options,
+    std::shared_ptr<ConsoleServices> const& console) -> std::vector<std::pair<SupportedDevice, std::shared_ptr<SharedLibrary>>>
+{
+    return display_modules_using(std::make_shared<udev::Context>(), modules, options, console);
 }
 
 auto mir::graphics::rendering_modules_for_device(
@@ -296,12 +315,13 @@ auto mir::graphics::rendering_modules_for_device(
     mo::Configuration const& options,
     std::shared_ptr<ConsoleServices> const& console) -> std::vector<std::pair<SupportedDevice, std::shared_ptr<SharedLibrary>>>
 {
+    auto const udev = std::make_shared<udev::Context>();
     return modules_for_device(
-        [&platforms, &options, &console](SharedLibrary const& module) -> std::vector<SupportedDevice>
+        [&platforms, &options, &console, &udev](SharedLibrary const& module) -> std::vector<SupportedDevice>
         {
             if (is_graphics_module(module))
             {
-                return probe_rendering_module(platforms, module, *options.options_for(module), console);
+                return probe_rendering_module(platforms, module, *options.options_for(module), console, udev);
             }
             else
             {
@@ -374,16 +394,81 @@ auto select_platforms_from_list(std::string const& selection, std::vector<std::s
     return selected_modules;
 }
 
+auto dso_filename(mir::SharedLibrary const& module) -> std::string
+{
+    Dl_info info;
+
+    auto describe = module.load_function<mir::graphics::DescribeModule>("describe_graphics_module", MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
+
+    dladdr(reinterpret_cast<void const*>(describe), &info);
+    return info.dli_fname;
+}
+
 auto dso_filename_alphabetically_before(mir::SharedLibrary const& a, mir::SharedLibrary const& b) -> bool
 {
-    Dl_info info_a, info_b;
+    return dso_filename(a) < dso_filename(b);
+}
 
-    auto describe_a = a.load_function<mir::graphics::DescribeModule>("describe_graphics_module", MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
-    auto describe_b = b.load_function<mir::graphics::DescribeModule>("describe_graphics_module", MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
+auto dso_filenames_of(ModuleSelection const& selection) -> std::vector<std::string>
+{
+    std::vector<std::string> filenames;
+    for (auto const& [_, module] : selection)
+    {
+        filenames.push_back(dso_filename(*module));
+    }
+    std::ranges::sort(filenames);
+    auto const duplicates = std::ranges::unique(filenames);
+    filenames.erase(duplicates.begin(), duplicates.end());
+    return filenames;
+}
+
+/* Probing a platform can be slow (it may mean initialising a GPU driver, or connecting to a host
+ * display server), and most starts are on a system that hasn't changed since the last. So we
+ * remember which modules were selected and, if the system looks the same, probe only those.
+ *
+ * The cached modules are still probed, so if they no longer claim the system (or claim it
+ * differently) we fall back to probing everything.
+ */
+auto display_modules_using_cache(
+    std::filesystem::path const& cache_file,
+    std::string const& platform_path,
+    std::shared_ptr<mir::udev::Context> const& udev,
+    std::vector<std::shared_ptr<mir::SharedLibrary>> const& modules,
+    mo::Configuration const& options,
+    std::shared_ptr<mir::ConsoleServices> const& console) -> ModuleSelection
+{
+    auto const fingerprint = mg::probe_fingerprint(platform_path, udev);
+
+    if (auto const cached = mg::load_probe_cache(cache_file, fingerprint))
+    {
+        // Keep the modules in the order we'd probe them without the cache, so ties are broken the same way
+        std::vector<std::shared_ptr<mir::SharedLibrary>> candidates;
+        std::ranges::copy_if(
+            modules,
+            std::back_inserter(candidates),
+            [&cached](auto const& module) { return std::ranges::find(*cached, dso_filename(*module)) != cached->end(); });
+
+        if (candidates.size() == cached->size())
+        {
+            try
+            {
+                auto selection = display_modules_using(udev, candidates, options, console);
+                if (dso_filenames_of(selection) == *cached)
+                {
+                    mir::log_info("Using display platforms remembered in %s", cache_file.c_str());
+                    return selection;
+                }
+            }
+            catch (std::runtime_error const&)
+            {
+            }
+        }
+        mir::log_info("Display platforms remembered in %s no longer apply; probing all platforms", cache_file.c_str());
+    }
 
-    dladdr(reinterpret_cast<void const*>(describe_a), &info_a);
-    dladdr(reinterpret_cast<void const*>(describe_b), &info_b);
-    return std::strcmp(info_a.dli_fname, info_b.dli_fname) < 0;
+    auto selection = display_modules_using(udev, modules, options, console);
+    mg::save_probe_cache(cache_file, fingerprint, dso_filenames_of(selection));
+    return selection;
 }
 }
 
@@ -395,6 +480,8 @@ auto mg::select_display_modules(
 {
     std::vector<std::pair<SupportedDevice, std::shared_ptr<SharedLibrary>>> platform_modules;
 
+    // Share one udev context between every probe, rather than each platform building its own
+    auto const udev = std::make_shared<mir::udev::Context>();
     auto const global_options = options.global_options();
     auto const& path = global_options->get<std::string>(options::platform_path);
     auto platforms = mir::libraries_for_path(path, lib_loader_report);
@@ -472,7 +559,8 @@ auto mg::select_display_modules(
                 graphics::probe_display_module(
                     *platform,
                     *options.options_for(*platform),
-                    console);
+                    console,
+                    udev);
 
             bool found_supported_device{false};
             for (auto& device : supported_devices)
@@ -517,13 +605,26 @@ auto mg::select_display_modules(
             // We don't need to probe the virtual platform; that is done separately below.
             platforms.erase(virtual_platform_pos);
         }
-        platform_modules = display_modules_for_device(platforms, options, console);
+        if (global_options->is_set(options::platform_probe_cache_opt))
+        {
+            platform_modules = display_modules_using_cache(
+                global_options->get<std::string>(options::platform_probe_cache_opt),
+                path,
+                udev,
+                platforms,
+                options,
+                console);
+        }
+        else
+        {
+            platform_modules = display_modules_using(udev, platforms, options, console);
+        }
     }
 
     if (virtual_platform)
     {
         auto virtual_probe = probe_display_module(
-            *virtual_platform, *options.options_for(*virtual_platform), console);
+            *virtual_platform, *options.options_for(*virtual_platform), console, udev);
         if (virtual_probe.size() && virtual_probe.front().support_level >= mg::probe::supported)
         {
             platform_modules.emplace_back(std::move(virtual_probe.front()), std::move(virtual_platform));
@@ -27,6 +27,11 @@ namespace mir
 {
 class ConsoleServices;
 
+namespace udev
+{
+class Context;
+}
+
 namespace options
 {
 class Configuration;
@@ -51,13 +56,15 @@ auto modules_for_device(
 auto probe_display_module(
     SharedLibrary const& module,
     options::Option const& options,
-    std::shared_ptr<ConsoleServices> const& console) -> std::vector<SupportedDevice>;
+    std::shared_ptr<ConsoleServices> const& console,
+    std::shared_ptr<udev::Context> const& udev) -> std::vector<SupportedDevice>;
 
 auto probe_rendering_module(
     std::span<std::shared_ptr<DisplayPlatform>> const& platforms,
     SharedLibrary const& module,
     options::Option const& options,
-    std::shared_ptr<ConsoleServices> const& console) -> std::vector<SupportedDevice>;
+    std::shared_ptr<ConsoleServices> const& console,
+    std::shared_ptr<udev::Context> const& udev) -> std::vector<SupportedDevice>;
 
 auto display_modules_for_device(
     std::vector<std::shared_ptr<SharedLibrary>> const& modules,
@@ -72,6 +79,12 @@ auto rendering_modules_for_device(
     std::shared_ptr<ConsoleServices> const& console)
     -> std::vector<std::pair<SupportedDevice, std::shared_ptr<SharedLibrary>>>;
 
+/**
+ * Probes the platform modules in the configured platform path, and selects those to use for display.
+ *
+ * If the platform probe cache option is set, and nothing it depends upon has changed since the
+ * cache was written, only the modules selected last time are probed.
+ */
 auto select_display_modules(
     options::Configuration const& options,
     std::shared_ptr<ConsoleServices> const& console,
@@ -0,0 +1,168 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "platform_probe_cache.h"
+
+#include <mir/log.h>
+#include <mir/udev/wrapper.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+namespace mg = mir::graphics;
+namespace fs = std::filesystem;
+
+namespace
+{
+/// Identifies the file format, so that a cache written by an incompatible Mir is ignored
+char const* const cache_header = "mir-platform-probe-cache 1";
+
+/// FNV-1a: unlike std::hash, stable between builds
+auto hash(std::string const& text) -> std::string
+{
+    uint64_t result = 0xcbf29ce484222325;
+    for (auto const c : text)
+    {
+        result ^= static_cast<unsigned char>(c);
+        result *= 0x100000001b3;
+    }
+    return std::format("{:016x}", result);
+}
+
+void describe_modules(std::ostream& out, fs::path const& platform_path)
+{
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (fs::directory_iterator i{platform_path, ec}, end; !ec && i != end; i.increment(ec))
+    {
+        if (i->is_regular_file(ec))
+        {
+            files.push_back(i->path());
+        }
+    }
+    std::ranges::sort(files);
+
+    for (auto const& file : files)
+    {
+        auto const size = fs::file_size(file, ec);
+        auto const modified = fs::last_write_time(file, ec);
+        out << "module " << file.filename().string() << ' ' << size << ' '
+            << modified.time_since_epoch().count() << '\n';
+    }
+}
+
+void describe_devices(std::ostream& out, std::shared_ptr<mir::udev::Context> const& udev)
+{
+    mir::udev::Enumerator drm_devices{udev};
+    drm_devices.match_subsystem("drm");
+    drm_devices.match_sysname("card[0-9]*");
+    drm_devices.scan_devices();
+
+    std::vector<std::string> devices;
+    for (auto const& device : drm_devices)
+    {
+        auto const parent = device.parent();
+        auto const driver = parent && parent->driver() ? parent->driver() : "";
+        devices.push_back(std::format("device {} {}", device.syspath(), driver));
+    }
+    std::ranges::sort(devices);
+
+    for (auto const& device : devices)
+    {
+        out << device << '\n';
+    }
+}
+
+void describe_environment(std::ostream& out)
+{
+    for (auto const variable : {"WAYLAND_DISPLAY", "DISPLAY"})
+    {
+        auto const value = std::getenv(variable);
+        out << "env " << variable << '=' << (value ? value : "") << '\n';
+    }
+}
+}
+
+auto mg::probe_fingerprint(fs::path const& platform_path, std::shared_ptr<udev::Context> const& udev) -> std::string
+{
+    std::ostringstream description;
+    describe_modules(description, platform_path);
+    describe_devices(description, udev);
+    describe_environment(description);
+    return hash(description.str());
+}
+
+auto mg::load_probe_cache(fs::path const& cache_file, std::string const& fingerprint)
+    -> std::optional<std::vector<std::string>>
+{
+    std::ifstream in{cache_file};
+    std::string header, cached_fingerprint;
+    if (!std::getline(in, header) || header != cache_header ||
+        !std::getline(in, cached_fingerprint) || cached_fingerprint != fingerprint)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::string> modules;
+    for (std::string module; std::getline(in, module);)
+    {
+        if (!module.empty())
+        {
+            modules.push_back(module);
+        }
+    }
+
+    if (modules.empty())
+    {
+        return std::nullopt;
+    }
+    return modules;
+}
+
+void mg::save_probe_cache(
+    fs::path const& cache_file,
+    std::string const& fingerprint,
+    std::vector<std::string> const& modules)
+{
+    // Write to a temporary file and rename it into place, so that a concurrent start never sees half a cache
+    auto const temporary = fs::path{cache_file}.concat(".new");
+    {
+        std::ofstream out{temporary, std::ios::trunc};
+        out << cache_header << '\n' << fingerprint << '\n';
+        for (auto const& module : modules)
+        {
+            out << module << '\n';
+        }
+
+        if (!out.flush())
+        {
+            mir::log_warning("Failed to write platform probe cache %s", temporary.c_str());
+            return;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(temporary, cache_file, ec);
+    if (ec)
+    {
+        mir::log_warning("Failed to update platform probe cache %s: %s", cache_file.c_str(), ec.message().c_str());
+        fs::remove(temporary, ec);
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_PLATFORM_PROBE_CACHE_H_
+#define MIR_GRAPHICS_PLATFORM_PROBE_CACHE_H_
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mir
+{
+namespace udev
+{
+class Context;
+}
+
+namespace graphics
+{
+/**
+ * Summarises everything platform selection depends upon that can be cheaply inspected:
+ * the platform modules in \p platform_path (by name, size and modification time), the DRM
+ * devices present and the drivers bound to them, and whether we are running nested.
+ *
+ * If the result matches a previous run's, platform selection is expected to pick the same modules.
+ */
+auto probe_fingerprint(std::filesystem::path const& platform_path, std::shared_ptr<udev::Context> const& udev)
+    -> std::string;
+
+/**
+ * Reads the modules selected by a previous run from \p cache_file.
+ *
+ * \return  The filenames of the selected modules, or std::nullopt if there is no usable cache or
+ *          it was written for a different \p fingerprint.
+ */
+auto load_probe_cache(std::filesystem::path const& cache_file, std::string const& fingerprint)
+    -> std::optional<std::vector<std::string>>;
+
+/**
+ * Records \p modules as the selection for \p fingerprint in \p cache_file.
+ *
+ * Failure to write the cache is logged, but is not an error.
+ */
+void save_probe_cache(
+    std::filesystem::path const& cache_file,
+    std::string const& fingerprint,
+    std::vector<std::string> const& modules);
+}
+}
+
+#endif // MIR_GRAPHICS_PLATFORM_PROBE_CACHE_H_
@@ -18,11 +18,13 @@
 #include <mir/options/configuration.h>
 
 #include "reports.h"
+#include "first_frame_report.h"
 #include "lttng_report_factory.h"
 #include "logging_report_factory.h"
 #include "null_report_factory.h"
 
 #include <mir/abnormal_exit.h>
+#include <mir/startup_report.h>
 
 namespace mg = mir::graphics;
 namespace mf = mir::frontend;
@@ -64,7 +66,13 @@ auto mir::DefaultServerConfiguration::the_compositor_report() -> std::shared_ptr
     return compositor_report(
         [this]()->std::shared_ptr<mc::CompositorReport>
         {
-            return report_factory(options::compositor_report_opt)->create_compositor_report();
+            auto report = report_factory(options::compositor_report_opt)->create_compositor_report();
+            if (the_options()->get<std::string>(options::startup_report_opt) != options::off_opt_value)
+            {
+                // The startup report ends with the first frames
+                report = std::make_shared<report::FirstFrameReport>(report, the_startup_report());
+            }
+            return report;
         });
 }
 
@@ -112,3 +120,12 @@ auto mir::DefaultServerConfiguration::the_shell_report() -> std::shared_ptr<shel
             return report_factory(options::shell_report_opt)->create_shell_report();
         });
 }
+
+auto mir::DefaultServerConfiguration::the_startup_report() -> std::shared_ptr<StartupReport>
+{
+    return startup_report(
+        [this]()->std::shared_ptr<StartupReport>
+        {
+            return report_factory(options::startup_report_opt)->create_startup_report();
+        });
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "first_frame_report.h"
+
+#include <mir/startup_report.h>
+
+#include <algorithm>
+
+namespace mr = mir::report;
+
+mr::FirstFrameReport::FirstFrameReport(
+    std::shared_ptr<compositor::CompositorReport> const& wrapped,
+    std::shared_ptr<StartupReport> const& startup_report)
+    : wrapped{wrapped},
+      startup_report{startup_report}
+{
+}
+
+void mr::FirstFrameReport::added_display(int width, int height, int x, int y, SubCompositorId id)
+{
+    wrapped->added_display(width, height, x, y, id);
+}
+
+void mr::FirstFrameReport::began_frame(SubCompositorId id)
+{
+    wrapped->began_frame(id);
+}
+
+void mr::FirstFrameReport::renderables_in_frame(SubCompositorId id, graphics::RenderableList const& renderables)
+{
+    wrapped->renderables_in_frame(id, renderables);
+
+    if (seen_client_frame.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    auto const shows_a_surface = std::ranges::any_of(
+        renderables,
+        [](auto const& renderable)
+        {
+            auto const surface = renderable->surface_if_any();
+            return surface && *surface;
+        });
+
+    if (shows_a_surface)
+    {
+        std::lock_guard lock{mutex};
+        client_frames_in_progress.insert(id);
+    }
+}
+
+void mr::FirstFrameReport::rendered_frame(SubCompositorId id)
+{
+    wrapped->rendered_frame(id);
+}
+
+void mr::FirstFrameReport::finished_frame(SubCompositorId id)
+{
+    wrapped->finished_frame(id);
+
+    if (!seen_frame.load(std::memory_order_relaxed) && !seen_frame.exchange(true))
+    {
+        startup_report->first_frame();
+    }
+
+    if (!seen_client_frame.load(std::memory_order_relaxed))
+    {
+        std::lock_guard lock{mutex};
+        if (client_frames_in_progress.erase(id) && !seen_client_frame.exchange(true))
+        {
+            client_frames_in_progress.clear();
+            startup_report->first_client_frame();
+        }
+    }
+}
+
+void mr::FirstFrameReport::started()
+{
+    wrapped->started();
+}
+
+void mr::FirstFrameReport::stopped()
+{
+    wrapped->stopped();
+}
+
+void mr::FirstFrameReport::scheduled()
+{
+    wrapped->scheduled();
+}
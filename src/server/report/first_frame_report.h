@@ -0,0 +1,64 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_FIRST_FRAME_REPORT_H_
+#define MIR_REPORT_FIRST_FRAME_REPORT_H_
+
+#include <mir/compositor/compositor_report.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace mir
+{
+class StartupReport;
+
+namespace report
+{
+/// Passes compositor reports on, telling the StartupReport when the first frames are composited
+class FirstFrameReport : public compositor::CompositorReport
+{
+public:
+    FirstFrameReport(
+        std::shared_ptr<compositor::CompositorReport> const& wrapped,
+        std::shared_ptr<StartupReport> const& startup_report);
+
+    void added_display(int width, int height, int x, int y, SubCompositorId id) override;
+    void began_frame(SubCompositorId id) override;
+    void renderables_in_frame(SubCompositorId id, graphics::RenderableList const& renderables) override;
+    void rendered_frame(SubCompositorId id) override;
+    void finished_frame(SubCompositorId id) override;
+    void started() override;
+    void stopped() override;
+    void scheduled() override;
+
+private:
+    std::shared_ptr<compositor::CompositorReport> const wrapped;
+    std::shared_ptr<StartupReport> const startup_report;
+
+    std::atomic<bool> seen_frame{false};
+    std::atomic<bool> seen_client_frame{false};
+
+    std::mutex mutex;
+    /// The compositors whose frame in progress shows a client's surface, until we've seen one finished
+    std::set<SubCompositorId> client_frames_in_progress;
+};
+}
+}
+
+#endif /* MIR_REPORT_FIRST_FRAME_REPORT_H_ */
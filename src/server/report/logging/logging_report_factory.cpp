@@ -22,6 +22,8 @@
 #include "shell_report.h"
 #include "input_report.h"
 #include "seat_report.h"
+#include "startup_report.h"
+#include "memory_report.h"
 #include <mir/logging/shared_library_prober_report.h>
 
 namespace mr = mir::report;
@@ -67,3 +69,13 @@ std::shared_ptr<mir::shell::ShellReport> mir::report::LoggingReportFactory::crea
 {
     return std::make_shared<mir::logging::ShellReport>(logger);
 }
+
+std::shared_ptr<mir::StartupReport> mr::LoggingReportFactory::create_startup_report()
+{
+    return std::make_shared<logging::StartupReport>(logger, clock);
+}
+
+std::shared_ptr<mir::MemoryReport> mr::LoggingReportFactory::create_memory_report()
+{
+    return std::make_shared<logging::MemoryReport>(logger);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory_report.h"
+
+#include <mir/logging/logger.h>
+
+#include <format>
+#include <string>
+
+namespace ml = mir::logging;
+namespace mrl = mir::report::logging;
+namespace mm = mir::memory;
+
+namespace
+{
+char const* const component = "memory";
+
+auto in_kib(std::size_t bytes) -> double
+{
+    return bytes / 1024.0;
+}
+
+auto describe(mm::Usage const& usage) -> std::string
+{
+    auto result = std::format("{:.1f}KiB", in_kib(usage.total()));
+    for (auto i = 0u; i != mm::category_count; ++i)
+    {
+        auto const category = static_cast<mm::Category>(i);
+        if (usage[category])
+        {
+            result += std::format(" {}={:.1f}KiB", mm::name_of(category), in_kib(usage[category]));
+        }
+    }
+    return result;
+}
+}
+
+mrl::MemoryReport::MemoryReport(std::shared_ptr<ml::Logger> const& logger)
+    : logger{logger}
+{
+}
+
+void mrl::MemoryReport::usage(
+    mm::Usage const& total,
+    std::map<mm::ClientId, mm::Usage> const& by_client)
+{
+    logger->log(ml::Severity::informational, "Total: " + describe(total), component);
+    for (auto const& [client, usage] : by_client)
+    {
+        logger->log(ml::Severity::informational, std::format("  Client pid {}: {}", client, describe(usage)), component);
+    }
+}
+
+void mrl::MemoryReport::client_over_budget(mm::ClientId client, std::size_t usage, std::size_t budget)
+{
+    auto const msg = std::format(
+        "Client pid {} is over its memory budget: {:.1f}KiB of {:.1f}KiB",
+        client, in_kib(usage), in_kib(budget));
+    logger->log(ml::Severity::warning, msg, component);
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "startup_report.h"
+
+#include <mir/logging/logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+
+namespace ml = mir::logging;
+namespace mrl = mir::report::logging;
+
+namespace
+{
+char const* const component = "startup";
+
+auto in_ms(mir::time::Duration duration) -> double
+{
+    return std::chrono::duration<double, std::milli>{duration}.count();
+}
+}
+
+mrl::StartupReport::StartupReport(
+    std::shared_ptr<ml::Logger> const& logger,
+    std::shared_ptr<time::Clock> const& clock)
+    : logger{logger},
+      clock{clock},
+      start{clock->now()}
+{
+}
+
+void mrl::StartupReport::phase_begun(char const* phase)
+{
+    std::lock_guard lock{mutex};
+    phases.push_back({phase, clock->now()});
+}
+
+void mrl::StartupReport::phase_ended(char const* phase)
+{
+    auto const now = clock->now();
+
+    std::lock_guard lock{mutex};
+    // Phases end in the reverse of the order they began, unless they are on different threads
+    auto const ended = std::find_if(phases.rbegin(), phases.rend(), [phase](auto const& p) { return p.name == phase; });
+    if (ended == phases.rend())
+    {
+        return;
+    }
+
+    auto const depth = std::distance(ended, phases.rend()) - 1;
+    auto const msg = std::format(
+        "{:{}}{} took {:.3f}ms (finished {:.3f}ms after start)",
+        "", 2 * depth, phase, in_ms(now - ended->began), in_ms(now - start));
+    phases.erase(std::next(ended).base());
+
+    logger->log(ml::Severity::informational, msg, component);
+}
+
+void mrl::StartupReport::first_frame()
+{
+    auto const msg = std::format("First frame after {:.3f}ms", in_ms(clock->now() - start));
+    logger->log(ml::Severity::informational, msg, component);
+}
+
+void mrl::StartupReport::first_client_frame()
+{
+    auto const msg = std::format("First client frame after {:.3f}ms", in_ms(clock->now() - start));
+    logger->log(ml::Severity::informational, msg, component);
+}
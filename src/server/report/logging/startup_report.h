@@ -0,0 +1,70 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_LOGGING_STARTUP_REPORT_H_
+#define MIR_REPORT_LOGGING_STARTUP_REPORT_H_
+
+#include <mir/startup_report.h>
+#include <mir/time/clock.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mir
+{
+namespace logging
+{
+class Logger;
+}
+namespace report
+{
+namespace logging
+{
+
+class StartupReport : public mir::StartupReport
+{
+public:
+    StartupReport(std::shared_ptr<mir::logging::Logger> const& logger,
+                  std::shared_ptr<time::Clock> const& clock);
+
+    void phase_begun(char const* phase) override;
+    void phase_ended(char const* phase) override;
+    void first_frame() override;
+    void first_client_frame() override;
+
+private:
+    std::shared_ptr<mir::logging::Logger> const logger;
+    std::shared_ptr<time::Clock> const clock;
+    time::Timestamp const start;
+
+    struct Phase
+    {
+        std::string name;
+        time::Timestamp began;
+    };
+
+    std::mutex mutex;
+    /// The phases that have begun but not yet ended, outermost first
+    std::vector<Phase> phases;
+};
+
+}
+}
+}
+
+#endif /* MIR_REPORT_LOGGING_STARTUP_REPORT_H_ */
@@ -46,6 +46,8 @@ public:
     std::shared_ptr<input::SeatObserver> create_seat_report() override;
     std::shared_ptr<mir::SharedLibraryProberReport> create_shared_library_prober_report() override;
     std::shared_ptr<shell::ShellReport> create_shell_report() override;
+    std::shared_ptr<StartupReport> create_startup_report() override;
+    std::shared_ptr<MemoryReport> create_memory_report() override;
 
 private:
     std::shared_ptr<mir::logging::Logger> const logger;
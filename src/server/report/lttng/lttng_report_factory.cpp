@@ -21,6 +21,8 @@
 #include "input_report.h"
 #include "scene_report.h"
 #include "shared_library_prober_report.h"
+#include "startup_report.h"
+#include "memory_report.h"
 #include <boost/throw_exception.hpp>
 
 std::shared_ptr<mir::compositor::CompositorReport> mir::report::LttngReportFactory::create_compositor_report()
@@ -57,3 +59,13 @@ std::shared_ptr<mir::shell::ShellReport> mir::report::LttngReportFactory::create
 {
     BOOST_THROW_EXCEPTION(std::logic_error("Not implemented"));
 }
+
+std::shared_ptr<mir::StartupReport> mir::report::LttngReportFactory::create_startup_report()
+{
+    return std::make_shared<lttng::StartupReport>();
+}
+
+std::shared_ptr<mir::MemoryReport> mir::report::LttngReportFactory::create_memory_report()
+{
+    return std::make_shared<lttng::MemoryReport>();
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory_report.h"
+#include <mir/report/lttng/mir_tracepoint.h>
+
+#define TRACEPOINT_DEFINE
+#define TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#include "memory_report_tp.h"
+
+namespace mm = mir::memory;
+
+namespace
+{
+void trace_usage(mm::ClientId client, mm::Usage const& usage)
+{
+    for (auto i = 0u; i != mm::category_count; ++i)
+    {
+        auto const category = static_cast<mm::Category>(i);
+        mir_tracepoint(mir_server_memory, usage, client, mm::name_of(category), usage[category]);
+    }
+}
+}
+
+void mir::report::lttng::MemoryReport::usage(
+    mm::Usage const& total,
+    std::map<mm::ClientId, mm::Usage> const& by_client)
+{
+    trace_usage(mm::no_client, total);
+    for (auto const& [client, usage] : by_client)
+    {
+        trace_usage(client, usage);
+    }
+}
+
+void mir::report::lttng::MemoryReport::client_over_budget(mm::ClientId client, std::size_t usage, std::size_t budget)
+{
+    mir_tracepoint(mir_server_memory, client_over_budget, client, usage, budget);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER mir_server_memory
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "./memory_report_tp.h"
+
+#if !defined(MIR_LTTNG_MEMORY_REPORT_TP_H_) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define MIR_LTTNG_MEMORY_REPORT_TP_H_
+
+#include "lttng_utils.h"
+
+#include <stddef.h>
+#include <sys/types.h>
+
+/* client is 0 for the total across all clients */
+TRACEPOINT_EVENT(
+    mir_server_memory,
+    usage,
+    TP_ARGS(pid_t, client, char const*, category, size_t, bytes),
+    TP_FIELDS(
+        ctf_integer(pid_t, client, client)
+        ctf_string(category, category)
+        ctf_integer(size_t, bytes, bytes)
+    )
+)
+
+TRACEPOINT_EVENT(
+    mir_server_memory,
+    client_over_budget,
+    TP_ARGS(pid_t, client, size_t, usage, size_t, budget),
+    TP_FIELDS(
+        ctf_integer(pid_t, client, client)
+        ctf_integer(size_t, usage, usage)
+        ctf_integer(size_t, budget, budget)
+    )
+)
+
+#endif /* MIR_LTTNG_MEMORY_REPORT_TP_H_ */
+
+#include <lttng/tracepoint-event.h>
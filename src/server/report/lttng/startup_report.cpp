@@ -0,0 +1,41 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "startup_report.h"
+#include <mir/report/lttng/mir_tracepoint.h>
+
+#define TRACEPOINT_DEFINE
+#define TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#include "startup_report_tp.h"
+
+#include "lttng_utils.h"
+
+#define STARTUP_REPORT_TRACE_CALL(name) MIR_LTTNG_VOID_TRACE_CALL(StartupReport,mir_server_startup,name)
+
+STARTUP_REPORT_TRACE_CALL(first_frame)
+STARTUP_REPORT_TRACE_CALL(first_client_frame)
+
+#undef STARTUP_REPORT_TRACE_CALL
+
+void mir::report::lttng::StartupReport::phase_begun(char const* phase)
+{
+    mir_tracepoint(mir_server_startup, phase_begun, phase);
+}
+
+void mir::report::lttng::StartupReport::phase_ended(char const* phase)
+{
+    mir_tracepoint(mir_server_startup, phase_ended, phase);
+}
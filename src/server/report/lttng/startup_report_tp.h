@@ -0,0 +1,60 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER mir_server_startup
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "./startup_report_tp.h"
+
+#if !defined(MIR_LTTNG_STARTUP_REPORT_TP_H_) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define MIR_LTTNG_STARTUP_REPORT_TP_H_
+
+#include "lttng_utils.h"
+
+TRACEPOINT_EVENT_CLASS(
+    mir_server_startup,
+    phase_event,
+    TP_ARGS(char const*, phase),
+    TP_FIELDS(ctf_string(phase, phase))
+)
+
+TRACEPOINT_EVENT_INSTANCE(
+    mir_server_startup,
+    phase_event,
+    phase_begun,
+    TP_ARGS(char const*, phase)
+)
+
+TRACEPOINT_EVENT_INSTANCE(
+    mir_server_startup,
+    phase_event,
+    phase_ended,
+    TP_ARGS(char const*, phase)
+)
+
+MIR_LTTNG_VOID_TRACE_CLASS(mir_server_startup)
+
+#define STARTUP_REPORT_TRACE_POINT(name) MIR_LTTNG_VOID_TRACE_POINT(mir_server_startup,name)
+
+STARTUP_REPORT_TRACE_POINT(first_frame)
+STARTUP_REPORT_TRACE_POINT(first_client_frame)
+
+#undef STARTUP_REPORT_TRACE_POINT
+
+#endif /* MIR_LTTNG_STARTUP_REPORT_TP_H_ */
+
+#include <lttng/tracepoint-event.h>
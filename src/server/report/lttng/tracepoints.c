@@ -6,3 +6,5 @@
 #include "display_report_tp.h"
 #include "scene_report_tp.h"
 #include "shared_library_prober_report_tp.h"
+#include "startup_report_tp.h"
+#include "memory_report_tp.h"
@@ -0,0 +1,29 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory_report.h"
+
+namespace mrn = mir::report::null;
+
+void mrn::MemoryReport::usage(
+    memory::Usage const& /*total*/,
+    std::map<memory::ClientId, memory::Usage> const& /*by_client*/)
+{
+}
+
+void mrn::MemoryReport::client_over_budget(memory::ClientId /*client*/, std::size_t /*usage*/, std::size_t /*budget*/)
+{
+}
@@ -21,6 +21,8 @@
 #include "input_report.h"
 #include "seat_report.h"
 #include "shell_report.h"
+#include "startup_report.h"
+#include "memory_report.h"
 #include "scene_report.h"
 #include <mir/logging/null_shared_library_prober_report.h>
 
@@ -59,6 +61,16 @@ std::shared_ptr<mir::shell::ShellReport> mir::report::NullReportFactory::create_
     return std::make_shared<null::ShellReport>();
 }
 
+std::shared_ptr<mir::StartupReport> mir::report::NullReportFactory::create_startup_report()
+{
+    return std::make_shared<null::StartupReport>();
+}
+
+std::shared_ptr<mir::MemoryReport> mir::report::NullReportFactory::create_memory_report()
+{
+    return std::make_shared<null::MemoryReport>();
+}
+
 std::shared_ptr<mir::compositor::CompositorReport> mir::report::null_compositor_report()
 {
     return NullReportFactory{}.create_compositor_report();
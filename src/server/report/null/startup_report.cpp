@@ -0,0 +1,35 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "startup_report.h"
+
+namespace mrn = mir::report::null;
+
+void mrn::StartupReport::phase_begun(char const* /*phase*/)
+{
+}
+
+void mrn::StartupReport::phase_ended(char const* /*phase*/)
+{
+}
+
+void mrn::StartupReport::first_frame()
+{
+}
+
+void mrn::StartupReport::first_client_frame()
+{
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_NULL_STARTUP_REPORT_H_
+#define MIR_REPORT_NULL_STARTUP_REPORT_H_
+
+#include <mir/startup_report.h>
+
+namespace mir
+{
+namespace report
+{
+namespace null
+{
+
+class StartupReport : public mir::StartupReport
+{
+public:
+    void phase_begun(char const* /*phase*/) override;
+    void phase_ended(char const* /*phase*/) override;
+    void first_frame() override;
+    void first_client_frame() override;
+};
+
+}
+}
+}
+
+#endif /* MIR_REPORT_NULL_STARTUP_REPORT_H_ */
@@ -21,7 +21,9 @@
 
 namespace mir
 {
+class MemoryReport;
 class SharedLibraryProberReport;
+class StartupReport;
 namespace compositor
 {
 class CompositorReport;
@@ -55,6 +57,8 @@ public:
     virtual std::shared_ptr<input::SeatObserver> create_seat_report() = 0;
     virtual std::shared_ptr<SharedLibraryProberReport> create_shared_library_prober_report() = 0;
     virtual std::shared_ptr<shell::ShellReport> create_shell_report() = 0;
+    virtual std::shared_ptr<StartupReport> create_startup_report() = 0;
+    virtual std::shared_ptr<MemoryReport> create_memory_report() = 0;
 
 protected:
     ReportFactory() = default;
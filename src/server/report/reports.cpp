@@ -22,16 +22,24 @@
 #include <mir/observer_multiplexer.h>
 #include <mir/options/configuration.h>
 #include <mir/abnormal_exit.h>
+#include <mir/main_loop.h>
+#include <mir/memory_report.h>
+#include <mir/log.h>
 
 #include "report_factory.h"
 #include "lttng_report_factory.h"
 #include "logging_report_factory.h"
 #include "null_report_factory.h"
 
+#include <chrono>
+#include <csignal>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace mo = mir::options;
 namespace mr = mir::report;
+namespace mm = mir::memory;
 
 namespace
 {
@@ -105,6 +113,59 @@ std::shared_ptr<mir::input::SeatObserver> create_seat_reports(
         std::throw_with_nested(mir::AbnormalExit("Failed to create report for "s + mo::seat_report_opt));
     }
 }
+
+std::shared_ptr<mir::MemoryReport> create_memory_report(
+    mir::DefaultServerConfiguration& config,
+    std::string const& opt)
+{
+    using namespace std::string_literals;
+    try
+    {
+        return factory_for_type(config, parse_report_option(opt))->create_memory_report();
+    }
+    catch (...)
+    {
+        std::throw_with_nested(mir::AbnormalExit("Failed to create report for "s + mo::memory_report_opt));
+    }
+}
+
+auto parse_budget_action(std::string const& opt) -> mm::BudgetAction
+{
+    if (opt == "warn")
+    {
+        return mm::BudgetAction::warn;
+    }
+    else if (opt == "disconnect")
+    {
+        return mm::BudgetAction::refuse;
+    }
+    else
+    {
+        throw mir::AbnormalExit(
+            std::string("Invalid ") + mo::client_memory_budget_action_opt + " option: " + opt +
+            " (valid options are: \"warn\" and \"disconnect\")");
+    }
+}
+
+/// Limits how often each client's admitted over-budget allocations are logged
+class OverBudgetLogLimiter
+{
+public:
+    auto should_log(mm::ClientId client) -> bool
+    {
+        auto const now = std::chrono::steady_clock::now();
+        std::lock_guard lock{mutex};
+
+        std::erase_if(last_logged, [now](auto const& entry) { return now - entry.second >= interval; });
+        return last_logged.emplace(client, now).second;
+    }
+
+private:
+    static std::chrono::seconds constexpr interval{10};
+
+    std::mutex mutex;
+    std::unordered_map<mm::ClientId, std::chrono::steady_clock::time_point> last_logged;
+};
 }
 
 mir::report::Reports::Reports(
@@ -113,8 +174,48 @@ mir::report::Reports::Reports(
     : display_configuration_report{std::make_shared<logging::DisplayConfigurationReport>(server.the_logger())},
       display_configuration_multiplexer{server.the_display_configuration_observer_registrar()},
       seat_report{create_seat_reports(server, options.get<std::string>(mo::seat_report_opt))},
-      seat_observer_multiplexer{server.the_seat_observer_registrar()}
+      seat_observer_multiplexer{server.the_seat_observer_registrar()},
+      memory_report{create_memory_report(server, options.get<std::string>(mo::memory_report_opt))}
 {
     display_configuration_multiplexer->register_interest(display_configuration_report);
     seat_observer_multiplexer->register_interest(seat_report);
+
+    if (auto const budget_mib = options.get<int>(mo::client_memory_budget_opt); budget_mib > 0)
+    {
+        mm::ledger().set_client_budget(
+            static_cast<std::size_t>(budget_mib) * 1024 * 1024,
+            parse_budget_action(options.get<std::string>(mo::client_memory_budget_action_opt)),
+            [report = memory_report, limiter = std::make_shared<OverBudgetLogLimiter>()](
+                mm::ClientId client, std::size_t usage, std::size_t budget, bool refused)
+            {
+                // Logged whatever the report backend: the memory report may be off or going to lttng.
+                // An admitted client keeps allocating, so is only logged every so often.
+                if (refused || limiter->should_log(client))
+                {
+                    mir::log_warning(
+                        "Client (pid %d) is over its memory budget: %zu of %zu bytes%s",
+                        static_cast<int>(client), usage, budget, refused ? "; disconnecting it" : "");
+                }
+                report->client_over_budget(client, usage, budget);
+            });
+    }
+
+    if (options.get<std::string>(mo::memory_report_opt) != mo::off_opt_value)
+    {
+        // The main loop outlives us, so it must not keep the report alive
+        server.the_main_loop()->register_signal_handler(
+            {SIGUSR2},
+            [weak_report = std::weak_ptr{memory_report}](int)
+            {
+                if (auto const report = weak_report.lock())
+                {
+                    report->usage(mm::ledger().usage(), mm::ledger().usage_by_client());
+                }
+            });
+    }
+}
+
+mir::report::Reports::~Reports()
+{
+    mm::ledger().set_client_budget(0, mm::BudgetAction::warn, {});
 }
@@ -22,6 +22,7 @@
 namespace mir
 {
 class DefaultServerConfiguration;
+class MemoryReport;
 
 template<class Observer>
 class ObserverRegistrar;
@@ -52,12 +53,14 @@ class Reports
 {
 public:
     Reports(DefaultServerConfiguration& server, options::Option const& options);
+    ~Reports();
 
 private:
     std::shared_ptr<logging::DisplayConfigurationReport> const display_configuration_report;
     std::shared_ptr<ObserverRegistrar<graphics::DisplayConfigurationObserver>> const display_configuration_multiplexer;
     std::shared_ptr<input::SeatObserver> const seat_report;
     std::shared_ptr<ObserverRegistrar<input::SeatObserver>> const seat_observer_multiplexer;
+    std::shared_ptr<MemoryReport> const memory_report;
 };
 }
 }
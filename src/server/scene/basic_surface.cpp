@@ -326,6 +326,26 @@ void ms::BasicSurface::set_opaque_region(geom::Rectangles const& region)
     synchronised_state.lock()->opaque_region = region;
 }
 
+auto ms::BasicSurface::tearing_allowed() const -> bool
+{
+    return synchronised_state.lock()->tearing_allowed;
+}
+
+void ms::BasicSurface::set_tearing_allowed(bool allowed)
+{
+    synchronised_state.lock()->tearing_allowed = allowed;
+}
+
+auto ms::BasicSurface::content_type() const -> MirContentType
+{
+    return synchronised_state.lock()->content_type;
+}
+
+void ms::BasicSurface::set_content_type(MirContentType content_type)
+{
+    synchronised_state.lock()->content_type = content_type;
+}
+
 void ms::BasicSurface::resize(geom::Size const& desired_size)
 {
     geom::Size new_size = desired_size;
@@ -888,14 +908,49 @@ std::list<ms::StreamInfo> ms::BasicSurface::get_streams() const
     return synchronised_state.lock()->layers;
 }
 
+namespace
+{
+auto same_layer(ms::StreamInfo const& lhs, ms::StreamInfo const& rhs) -> bool
+{
+    return lhs.stream == rhs.stream && lhs.displacement == rhs.displacement;
+}
+
+auto contains_layer(std::list<ms::StreamInfo> const& layers, ms::StreamInfo const& layer) -> bool
+{
+    return std::ranges::any_of(layers, [&](auto const& candidate) { return same_layer(candidate, layer); });
+}
+}
+
 void ms::BasicSurface::set_streams(std::list<StreamInfo> const& s)
 {
     geom::Point surface_top_left;
     {
         auto state = synchronised_state.lock();
-        clear_frame_posted_callbacks(*state);
+
+        if (std::ranges::equal(state->layers, s, same_layer))
+        {
+            // Nothing has been added, removed, moved or restacked
+            return;
+        }
+
+        // Subsurface-heavy clients typically change one stream at a time, so only touch the
+        // callbacks of streams that have been removed, added or moved.
+        for (auto const& layer : state->layers)
+        {
+            if (!contains_layer(s, layer))
+            {
+                layer.stream->set_frame_posted_callback([](auto){});
+            }
+        }
+        for (auto const& layer : s)
+        {
+            if (!contains_layer(state->layers, layer))
+            {
+                update_frame_posted_callback(*state, layer);
+            }
+        }
+
         state->layers = s;
-        update_frame_posted_callbacks(*state);
         surface_top_left = state->surface_rect.top_left;
     }
     observers->moved_to(this, surface_top_left);
@@ -1167,21 +1222,26 @@ void mir::scene::BasicSurface::clear_frame_posted_callbacks(State& state)
 
 void mir::scene::BasicSurface::update_frame_posted_callbacks(State& state)
 {
-    for (auto& layer : state.layers)
+    for (auto const& layer : state.layers)
     {
-        auto const surface_local_position = geom::Point{} + state.margins.left + state.margins.top + layer.displacement;
-        layer.stream->set_frame_posted_callback(
-            [this, observers=std::weak_ptr{observers}, surface_local_position]
-                (auto const& size)
-            {
-                if (auto const o = observers.lock())
-                {
-                    o->frame_posted(this, geom::Rectangle{surface_local_position, size});
-                }
-            });
+        update_frame_posted_callback(state, layer);
     }
 }
 
+void mir::scene::BasicSurface::update_frame_posted_callback(State const& state, StreamInfo const& layer)
+{
+    auto const surface_local_position = geom::Point{} + state.margins.left + state.margins.top + layer.displacement;
+    layer.stream->set_frame_posted_callback(
+        [this, observers=std::weak_ptr{observers}, surface_local_position]
+            (auto const& size)
+        {
+            if (auto const o = observers.lock())
+            {
+                o->frame_posted(this, geom::Rectangle{surface_local_position, size});
+            }
+        });
+}
+
 auto mir::scene::BasicSurface::content_size(State const& state) const -> geometry::Size
 {
     return geom::Size{
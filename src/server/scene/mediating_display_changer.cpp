@@ -348,10 +348,7 @@ void ms::MediatingDisplayChanger::apply_config(
         if (configuration_has_new_outputs_enabled(*display->configuration(), *conf) ||
             !interruption_free_configuration_successful())
         {
-            ApplyNowAndRevertOnScopeExit comp{
-                [this] { compositor->stop(); },
-                [this] { compositor->start(); }};
-            display->configure(*conf);
+            compositor->configure_display(*display, *conf);
         }
         else if (configuration_changes_require_recompositing(*existing_configuration, *conf))
         {
@@ -31,6 +31,7 @@
 #include <mir/main_loop.h>
 #include <mir/report_exception.h>
 #include <mir/run_mir.h>
+#include <mir/startup_report.h>
 
 // TODO these are used to frig a stub renderer when running headless
 #include <mir/renderer/renderer.h>
@@ -404,6 +405,8 @@ void mir::Server::run()
 
         verify_accessing_allowed(self->server_config);
 
+        auto startup = std::make_shared<StartupPhase>(self->server_config->the_startup_report(), "Startup");
+
         auto const emergency_cleanup = self->server_config->the_emergency_cleanup();
         auto const composite_event_filter = self->server_config->the_composite_event_filter();
 
@@ -420,7 +423,15 @@ void mir::Server::run()
         run_mir(
             *self->server_config,
             [&](DisplayServer&)
-                { self->init_callback(); self->init_callback = []{}; },
+                {
+                    self->init_callback();
+                    self->init_callback = []{};
+
+                    // Startup is over once everything has started and the main loop is dispatching
+                    self->server_config->the_main_loop()->enqueue(
+                        this,
+                        [startup = std::move(startup)]() mutable { startup.reset(); });
+                },
             self->terminator);
 
         mir::security_log(
@@ -32,6 +32,7 @@
 
 #include <boost/throw_exception.hpp>
 #include <functional>
+#include <mutex>
 #include <optional>
 
 namespace ms = mir::scene;
@@ -137,19 +138,207 @@ msd::BasicDecoration::BufferStreams::~BufferStreams()
     session->destroy_buffer_stream(bottom_border);
 }
 
+/// Renders decoration buffers on a worker and submits them to the decoration's streams
+///
+/// Only one render runs at a time. Requests made while one is queued or running are merged into it, so a burst of
+/// window changes (such as an interactive resize) only renders the latest state.
+class msd::BasicDecoration::AsyncRenderer
+    : public std::enable_shared_from_this<AsyncRenderer>
+{
+public:
+    /// Which parts of the decoration need to be redrawn
+    struct Parts
+    {
+        bool titlebar{false};
+        bool side_borders{false};
+        bool bottom_border{false};
+    };
+
+    AsyncRenderer(
+        std::unique_ptr<RendererStrategy> strategy,
+        BufferStreams const& streams,
+        Executor& executor);
+
+    void request(
+        std::shared_ptr<WindowState const> const& window_state,
+        std::shared_ptr<InputState const> const& input_state,
+        bool state_changed,
+        Parts parts);
+
+    /// Drops any pending request; a render already in progress still completes
+    void stop();
+
+private:
+    struct Request
+    {
+        std::shared_ptr<WindowState const> window_state;
+        std::shared_ptr<InputState const> input_state;
+        bool state_changed;
+        Parts parts;
+    };
+
+    void drain();
+    void render(Request const& request);
+
+    std::unique_ptr<RendererStrategy> const strategy;
+    std::shared_ptr<mc::BufferStream> const titlebar;
+    std::shared_ptr<mc::BufferStream> const left_border;
+    std::shared_ptr<mc::BufferStream> const right_border;
+    std::shared_ptr<mc::BufferStream> const bottom_border;
+    Executor& executor;
+
+    std::mutex mutex;
+    std::optional<Request> pending;
+    bool draining{false};
+    bool stopped{false};
+};
+
+msd::BasicDecoration::AsyncRenderer::AsyncRenderer(
+    std::unique_ptr<RendererStrategy> strategy,
+    BufferStreams const& streams,
+    Executor& executor)
+    : strategy{std::move(strategy)},
+      titlebar{streams.titlebar},
+      left_border{streams.left_border},
+      right_border{streams.right_border},
+      bottom_border{streams.bottom_border},
+      executor{executor}
+{
+}
+
+void msd::BasicDecoration::AsyncRenderer::request(
+    std::shared_ptr<WindowState const> const& window_state,
+    std::shared_ptr<InputState const> const& input_state,
+    bool state_changed,
+    Parts parts)
+{
+    std::lock_guard lock{mutex};
+
+    if (stopped)
+        return;
+
+    if (pending)
+    {
+        pending->window_state = window_state;
+        pending->input_state = input_state;
+        pending->state_changed |= state_changed;
+        pending->parts.titlebar |= parts.titlebar;
+        pending->parts.side_borders |= parts.side_borders;
+        pending->parts.bottom_border |= parts.bottom_border;
+    }
+    else
+    {
+        pending = Request{window_state, input_state, state_changed, parts};
+    }
+
+    if (!draining)
+    {
+        draining = true;
+        executor.spawn([self = shared_from_this()]() { self->drain(); });
+    }
+}
+
+void msd::BasicDecoration::AsyncRenderer::stop()
+{
+    std::lock_guard lock{mutex};
+    stopped = true;
+    pending.reset();
+}
+
+void msd::BasicDecoration::AsyncRenderer::drain()
+{
+    while (true)
+    {
+        Request next;
+        {
+            std::lock_guard lock{mutex};
+            if (!pending)
+            {
+                draining = false;
+                return;
+            }
+            next = std::move(pending.value());
+            pending.reset();
+        }
+
+        render(next);
+    }
+}
+
+void msd::BasicDecoration::AsyncRenderer::render(Request const& request)
+{
+    auto const& window_state = *request.window_state;
+
+    if (request.state_changed)
+    {
+        strategy->update_state(window_state, *request.input_state);
+    }
+
+    struct NewBuffer
+    {
+        std::shared_ptr<mc::BufferStream> stream;
+        std::optional<std::shared_ptr<mg::Buffer>> buffer;
+        geom::Size size; ///< Logical size to display the buffer at
+    };
+    std::vector<NewBuffer> new_buffers;
+
+    if (request.parts.side_borders)
+    {
+        new_buffers.push_back({
+            left_border,
+            strategy->render_left_border(),
+            window_state.left_border_rect().size});
+        new_buffers.push_back({
+            right_border,
+            strategy->render_right_border(),
+            window_state.right_border_rect().size});
+    }
+
+    if (request.parts.bottom_border)
+    {
+        new_buffers.push_back({
+            bottom_border,
+            strategy->render_bottom_border(),
+            window_state.bottom_border_rect().size});
+    }
+
+    if (request.parts.titlebar)
+    {
+        new_buffers.push_back({
+            titlebar,
+            strategy->render_titlebar(),
+            window_state.titlebar_rect().size});
+    }
+
+    // Buffers are either drawn at the window's scale, or are solid colors stretched to fill their area, so submit
+    // them at the logical size of the area they decorate rather than deriving it from the buffer
+    for (auto const& new_buffer : new_buffers)
+    {
+        if (new_buffer.buffer)
+            new_buffer.stream->submit_buffer(
+                new_buffer.buffer.value(),
+                new_buffer.size,
+                {{0, 0}, geom::SizeD{new_buffer.buffer.value()->size()}});
+    }
+}
+
 msd::BasicDecoration::BasicDecoration(
     std::shared_ptr<msh::Shell> const& shell,
     std::shared_ptr<Executor> const& executor,
+    Executor& render_executor,
     std::shared_ptr<input::CursorImages> const& cursor_images,
     std::shared_ptr<ms::Surface> const& window_surface,
     std::shared_ptr<DecorationStrategy> decoration_strategy)
     : threadsafe_self{std::make_shared<ThreadsafeAccess<BasicDecoration>>(executor)},
       decoration_strategy{decoration_strategy},
-      renderer_strategy{decoration_strategy->render_strategy()},
       shell{shell},
       cursor_images{cursor_images},
       session{window_surface->session().lock()},
       buffer_streams{std::make_unique<BufferStreams>(session, decoration_strategy->buffer_format())},
+      renderer{std::make_shared<AsyncRenderer>(
+          decoration_strategy->render_strategy(),
+          *buffer_streams,
+          render_executor)},
       window_surface{window_surface},
       decoration_surface{create_surface()},
       window_state{decoration_strategy->new_window_state(window_surface, scale)},
@@ -187,6 +376,7 @@ auto msd::BasicDecoration::BufferStreams::create_buffer_stream() -> std::shared_
 msd::BasicDecoration::~BasicDecoration()
 {
     threadsafe_self->invalidate();
+    renderer->stop();
     shell->destroy_surface(session, decoration_surface);
     window_surface->set_window_margins(
         geom::DeltaY{},
@@ -356,7 +546,8 @@ void msd::BasicDecoration::update(
         shell->modify_surface(session, decoration_surface, spec);
     }
 
-    if (window_updated({
+    bool const state_changed =
+        window_updated({
             &WindowState::focused_state,
             &WindowState::window_name,
             &WindowState::titlebar_rect,
@@ -365,60 +556,33 @@ void msd::BasicDecoration::update(
             &WindowState::bottom_border_rect,
             &WindowState::scale}) ||
         input_updated({
-            &InputState::buttons}))
-    {
-        renderer_strategy->update_state(*window_state, *input_state);
-    }
+            &InputState::buttons});
 
-    std::vector<std::pair<
-        std::shared_ptr<mc::BufferStream>,
-        std::optional<std::shared_ptr<mg::Buffer>>>> new_buffers;
+    AsyncRenderer::Parts parts;
 
-    if (window_updated({
-            &WindowState::focused_state,
-            &WindowState::side_border_width,
-            &WindowState::side_border_height,
-            &WindowState::scale}))
-    {
-        new_buffers.emplace_back(
-            buffer_streams->left_border,
-            renderer_strategy->render_left_border());
-        new_buffers.emplace_back(
-            buffer_streams->right_border,
-            renderer_strategy->render_right_border());
-    }
+    parts.side_borders = window_updated({
+        &WindowState::focused_state,
+        &WindowState::side_border_width,
+        &WindowState::side_border_height,
+        &WindowState::scale});
 
-    if (window_updated({
-            &WindowState::focused_state,
-            &WindowState::bottom_border_width,
-            &WindowState::bottom_border_height,
-            &WindowState::scale}))
-    {
-        new_buffers.emplace_back(
-            buffer_streams->bottom_border,
-            renderer_strategy->render_bottom_border());
-    }
+    parts.bottom_border = window_updated({
+        &WindowState::focused_state,
+        &WindowState::bottom_border_width,
+        &WindowState::bottom_border_height,
+        &WindowState::scale});
 
-    if (window_updated({
+    parts.titlebar =
+        window_updated({
             &WindowState::focused_state,
             &WindowState::window_name,
             &WindowState::titlebar_rect,
             &WindowState::scale}) ||
         input_updated({
-            &InputState::buttons}))
-    {
-        new_buffers.emplace_back(
-            buffer_streams->titlebar,
-            renderer_strategy->render_titlebar());
-    }
+            &InputState::buttons});
 
-    float inv_scale = 1.0f / window_state->scale();
-    for (auto const& pair : new_buffers)
+    if (state_changed || parts.side_borders || parts.bottom_border || parts.titlebar)
     {
-        if (pair.second)
-            pair.first->submit_buffer(
-                pair.second.value(),
-                pair.second.value()->size() * inv_scale,
-                {{0, 0}, geom::SizeD{pair.second.value()->size()}});
+        renderer->request(window_state, input_state, state_changed, parts);
     }
 }
@@ -70,6 +70,7 @@ public:
     BasicDecoration(
         std::shared_ptr<shell::Shell> const& shell,
         std::shared_ptr<Executor> const& executor,
+        Executor& render_executor,
         std::shared_ptr<input::CursorImages> const& cursor_images,
         std::shared_ptr<scene::Surface> const& window_surface,
         std::shared_ptr<DecorationStrategy> decoration_strategy);
@@ -91,7 +92,7 @@ protected:
     /// Returns paramaters to create the decoration surface
     auto create_surface() const -> std::shared_ptr<scene::Surface>;
 
-    /// Draw the decoration buffers and submit them to the surface
+    /// Update the decoration surface, and request the decoration buffers be drawn and submitted to it
     /// Current states are stored int window_state and input_state members
     /// Previous state pointers may be equal to current window_state/input_state to trigger no change
     /// If previous states are nullopt, a full refresh is performed
@@ -101,7 +102,6 @@ protected:
 
     std::shared_ptr<ThreadsafeAccess<BasicDecoration>> const threadsafe_self;
     std::shared_ptr<DecorationStrategy> const decoration_strategy;
-    std::unique_ptr<RendererStrategy> const renderer_strategy;
 
     std::shared_ptr<shell::Shell> const shell;
     std::shared_ptr<input::CursorImages> const cursor_images;
@@ -112,13 +112,17 @@ protected:
     class BufferStreams;
     std::unique_ptr<BufferStreams> const buffer_streams;
 
+    /// Draws the decoration buffers off the thread that delivers updates
+    class AsyncRenderer;
+    std::shared_ptr<AsyncRenderer> const renderer;
+
     std::shared_ptr<scene::Surface> const window_surface;
     std::shared_ptr<scene::Surface> const decoration_surface;
-    std::unique_ptr<WindowState const> window_state;
+    std::shared_ptr<WindowState const> window_state;
 
     std::unique_ptr<WindowSurfaceObserverManager> const window_surface_observer_manager;
     std::unique_ptr<InputManager> const input_manager;
-    std::unique_ptr<InputState const> input_state;
+    std::shared_ptr<InputState const> input_state;
 };
 }
 }
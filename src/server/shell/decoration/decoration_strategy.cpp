@@ -23,6 +23,7 @@
 #include <mir/log.h>
 #include <mir/default_font.h>
 #include <mir/renderer/sw/pixel_source.h>
+#include <mir/graphics/solid_color_buffer.h>
 
 #include <boost/throw_exception.hpp>
 #include <ft2build.h>
@@ -30,11 +31,18 @@
 #include FT_FREETYPE_H
 #include <endian.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
 #include <locale>
 #include <codecvt>
 #include <filesystem>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace ms = mir::scene;
 namespace geom = mir::geometry;
@@ -99,18 +107,35 @@ constexpr auto unpack_pixel(uint32_t c, unsigned char &r, unsigned char &g, unsi
 #endif
 }
 
-constexpr auto blend_pixel(uint32_t c, unsigned char r, unsigned char g, unsigned char b, unsigned char a) -> uint32_t
+/// Blends a solid color into a row of pixels through a coverage mask, keeping the pixels' own alpha. Written without
+/// branches or divisions so the compiler can vectorize it.
+void blend_row(
+    uint32_t* row,
+    unsigned char const* coverage,
+    int width,
+    unsigned char r, unsigned char g, unsigned char b, unsigned char a)
 {
-    unsigned char src_r = 0, src_g = 0, src_b = 0, src_a = 0;
-    unpack_pixel(c, src_r, src_g, src_b, src_a);
-    unsigned char out_r = (static_cast<int>(src_r) * (255 - a)) / 255 +
-        (static_cast<int>(r) * a) / 255;
-    unsigned char out_g = (static_cast<int>(src_g) * (255 - a)) / 255 +
-        (static_cast<int>(g) * a) / 255;
-    unsigned char out_b = (static_cast<int>(src_b) * (255 - a)) / 255 +
-        (static_cast<int>(b) * a) / 255;
-    unsigned char out_a = src_a;
-    return pack_pixel(out_r, out_g, out_b, out_a);
+    // Exactly x / 255 for x in [0, 255 * 255]
+    auto const div_255 = [](uint32_t x) { return (x + 1 + (x >> 8)) >> 8; };
+
+    int constexpr red_shift = std::countr_zero(pack_pixel(0xFF, 0, 0, 0));
+    int constexpr green_shift = std::countr_zero(pack_pixel(0, 0xFF, 0, 0));
+    int constexpr blue_shift = std::countr_zero(pack_pixel(0, 0, 0xFF, 0));
+    uint32_t constexpr alpha_mask = pack_pixel(0, 0, 0, 0xFF);
+
+    for (int i = 0; i < width; i++)
+    {
+        uint32_t const src = row[i];
+        uint32_t const alpha = div_255(uint32_t{coverage[i]} * a);
+        uint32_t const inv_alpha = 255 - alpha;
+
+        auto const channel = [&](int shift, uint32_t color)
+            {
+                return (div_255(((src >> shift) & 0xFF) * inv_alpha) + div_255(color * alpha)) << shift;
+            };
+
+        row[i] = (src & alpha_mask) | channel(red_shift, r) | channel(green_shift, g) | channel(blue_shift, b);
+    }
 }
 
 uint32_t constexpr default_focused_background   = pack_pixel(0x32, 0x32, 0x32);
@@ -276,21 +301,21 @@ private:
     geom::Size right_border_size;
     geom::Size bottom_border_size;
 
-    bool needs_solid_color_redraw{true};
-
-    size_t solid_color_pixels_length{0};
-    size_t scaled_solid_color_pixels_length{0};
-    std::unique_ptr<Pixel[]> solid_color_pixels; // can be nullptr
+    /// The borders are all the background color of the current theme, so share one buffer
+    std::shared_ptr<mir::graphics::SolidColorBuffer> border_buffer; // can be nullptr
 
     geom::Size titlebar_size{};
     std::unique_ptr<Pixel[]> titlebar_pixels; // can be nullptr
+    /// Titlebar buffers are reused once the compositor has released them. Two are enough for one to be on screen
+    /// while the other is drawn into.
+    std::array<std::shared_ptr<mir::graphics::Buffer>, 2> titlebar_buffers;
 
     bool needs_titlebar_redraw{true};
     bool needs_titlebar_buttons_redraw{true};
 
     std::vector<msd::Button> buttons;
 
-    void update_solid_color_pixels();
+    auto solid_color_border() -> std::shared_ptr<mir::graphics::Buffer>;
 
     void set_focus_state(MirWindowFocusState focus_state);
 
@@ -301,6 +326,8 @@ private:
     static auto alloc_pixels(geom::Size size) -> std::unique_ptr<Pixel[]>;
     auto make_buffer(MirPixelFormat, mir::geometry::Size, Pixel const* pixels) const
         -> std::optional<std::shared_ptr<mir::graphics::Buffer>>;
+    auto reuse_or_make_titlebar_buffer(mir::geometry::Size size)
+        -> std::optional<std::shared_ptr<mir::graphics::Buffer>>;
     std::shared_ptr<mir::graphics::GraphicBufferAllocator> const allocator;
 };
 
@@ -440,16 +467,33 @@ public:
         Pixel color) override;
 
 private:
+    /// A rasterized glyph, kept so titles that are redrawn often don't need rasterizing each time
+    struct Glyph
+    {
+        geom::Displacement offset;              ///< From the pen position to the top left of the coverage mask
+        geom::Displacement advance;             ///< How far to move the pen after drawing
+        geom::Size size;                        ///< Size of the coverage mask
+        std::vector<unsigned char> coverage;    ///< Tightly packed rows of 8-bit coverage
+    };
+
+    /// Bounds the memory held by the cache, which is simply dropped when full
+    static size_t constexpr max_cached_glyphs{4096};
+
     std::mutex mutex;
     FT_Library library;
     FT_Face face;
+    /// The size face is set to, so it is only set again when it changes
+    std::optional<geom::Height> char_size;
+    /// Keyed by pixel height and codepoint (there is only one face)
+    std::unordered_map<uint64_t, Glyph> glyph_cache;
 
     void set_char_size(geom::Height height);
+    auto glyph_for(char32_t codepoint, geom::Height height) -> Glyph const&;
     void rasterize_glyph(char32_t glyph);
     void render_glyph(
         Pixel* buf,
         geom::Size buf_size,
-        FT_Bitmap const* glyph,
+        Glyph const& glyph,
         geom::Point top_left,
         Pixel color);
 
@@ -545,34 +589,15 @@ void RendererStrategy::Text::Impl::render(
         return;
     }
 
-    try
-    {
-        set_char_size(height_pixels);
-    }
-    catch (std::runtime_error const& error)
-    {
-        mir::log_warning("%s", error.what());
-        return;
-    }
-
     auto const utf32 = utf8_to_utf32(text);
 
     for (char32_t const glyph : utf32)
     {
         try
         {
-            rasterize_glyph(glyph);
-
-            geom::Point glyph_top_left =
-                top_left +
-                geom::Displacement{
-                    face->glyph->bitmap_left,
-                    height_pixels.as_int() - face->glyph->bitmap_top};
-            render_glyph(buf, buf_size, &face->glyph->bitmap, glyph_top_left, color);
-
-            top_left += geom::Displacement{
-                face->glyph->advance.x / 64,
-                face->glyph->advance.y / 64};
+            auto const& cached = glyph_for(glyph, height_pixels);
+            render_glyph(buf, buf_size, cached, top_left + cached.offset, color);
+            top_left += cached.advance;
         }
         catch (std::runtime_error const& error)
         {
@@ -583,9 +608,14 @@ void RendererStrategy::Text::Impl::render(
 
 void RendererStrategy::Text::Impl::set_char_size(geom::Height height)
 {
+    if (char_size == height)
+        return;
+
+    char_size.reset();
     if (auto const error = FT_Set_Pixel_Sizes(face, 0, height.as_int()))
         BOOST_THROW_EXCEPTION(std::runtime_error(
             "Setting char size failed with error " + std::to_string(error)));
+    char_size = height;
 }
 
 namespace
@@ -602,6 +632,37 @@ auto freetype_error_to_string(FT_Error error) -> char const*
 }
 }
 
+auto RendererStrategy::Text::Impl::glyph_for(char32_t codepoint, geom::Height height) -> Glyph const&
+{
+    auto const key = (static_cast<uint64_t>(height.as_uint32_t()) << 32) | codepoint;
+    if (auto const cached = glyph_cache.find(key); cached != glyph_cache.end())
+    {
+        return cached->second;
+    }
+
+    set_char_size(height);
+    rasterize_glyph(codepoint);
+
+    auto const& slot = *face->glyph;
+    auto const& bitmap = slot.bitmap;
+    Glyph glyph{
+        {slot.bitmap_left, height.as_int() - slot.bitmap_top},
+        {slot.advance.x / 64, slot.advance.y / 64},
+        {bitmap.width, bitmap.rows},
+        std::vector<unsigned char>(static_cast<size_t>(bitmap.width) * bitmap.rows)};
+    for (unsigned row = 0; row < bitmap.rows; row++)
+    {
+        std::copy_n(bitmap.buffer + static_cast<ptrdiff_t>(row) * bitmap.pitch, bitmap.width,
+                    glyph.coverage.data() + static_cast<size_t>(row) * bitmap.width);
+    }
+
+    if (glyph_cache.size() >= max_cached_glyphs)
+    {
+        glyph_cache.clear();
+    }
+    return glyph_cache.emplace(key, std::move(glyph)).first->second;
+}
+
 void RendererStrategy::Text::Impl::rasterize_glyph(char32_t glyph)
 {
     auto const glyph_index = FT_Get_Char_Index(face, glyph);
@@ -624,34 +685,35 @@ void RendererStrategy::Text::Impl::rasterize_glyph(char32_t glyph)
 void RendererStrategy::Text::Impl::render_glyph(
     Pixel* buf,
     geom::Size buf_size,
-    FT_Bitmap const* glyph,
+    Glyph const& glyph,
     geom::Point top_left,
     Pixel color)
 {
     geom::X const buffer_left = std::max(top_left.x, geom::X{});
-    geom::X const buffer_right = std::min(top_left.x + geom::DeltaX{glyph->width}, as_x(buf_size.width));
+    geom::X const buffer_right = std::min(top_left.x + as_delta(glyph.size.width), as_x(buf_size.width));
 
     geom::Y const buffer_top = std::max(top_left.y, geom::Y{});
-    geom::Y const buffer_bottom = std::min(top_left.y + geom::DeltaY{glyph->rows}, as_y(buf_size.height));
+    geom::Y const buffer_bottom = std::min(top_left.y + as_delta(glyph.size.height), as_y(buf_size.height));
+
+    if (buffer_left >= buffer_right)
+        return;
 
     geom::Displacement const glyph_offset = as_displacement(top_left);
 
     unsigned char color_red = 0, color_green = 0, color_blue = 0, color_alpha = 0;
     unpack_pixel(color, color_red, color_green, color_blue, color_alpha);
 
+    auto const width = (buffer_right - buffer_left).as_int();
+    auto const glyph_left = (buffer_left - glyph_offset.dx).as_int();
+
     for (geom::Y buffer_y = buffer_top; buffer_y < buffer_bottom; buffer_y += geom::DeltaY{1})
     {
         geom::Y const glyph_y = buffer_y - glyph_offset.dy;
-        unsigned char* const glyph_row = glyph->buffer + glyph_y.as_int() * glyph->pitch;
-        Pixel* const buffer_row = buf + buffer_y.as_int() * buf_size.width.as_int();
+        unsigned char const* const glyph_row =
+            glyph.coverage.data() + glyph_y.as_int() * glyph.size.width.as_int() + glyph_left;
+        Pixel* const buffer_row = buf + buffer_y.as_int() * buf_size.width.as_int() + buffer_left.as_int();
 
-        for (geom::X buffer_x = buffer_left; buffer_x < buffer_right; buffer_x += geom::DeltaX{1})
-        {
-            geom::X const glyph_x = buffer_x - glyph_offset.dx;
-            unsigned char const glyph_alpha = (static_cast<int>(glyph_row[glyph_x.as_int()]) * color_alpha) / 255;
-            buffer_row[buffer_x.as_int()] =
-                blend_pixel(buffer_row[buffer_x.as_int()], color_red, color_green, color_blue, glyph_alpha);
-        }
+        blend_row(buffer_row, glyph_row, width, color_red, color_green, color_blue, color_alpha);
     }
 }
 
@@ -729,9 +791,6 @@ void RendererStrategy::update_state(WindowState const& window_state, InputState
     {
         scale = new_scale;
 
-        needs_solid_color_redraw = true;
-        solid_color_pixels.reset(); // force a reallocation next time it's needed
-
         needs_titlebar_redraw = true;
         titlebar_pixels.reset(); // force a reallocation next time it's needed
 
@@ -742,20 +801,6 @@ void RendererStrategy::update_state(WindowState const& window_state, InputState
     right_border_size = window_state.right_border_rect().size;
     bottom_border_size = window_state.bottom_border_rect().size;
 
-    size_t length{0};
-    length = std::max(length, area(left_border_size));
-    length = std::max(length, area(right_border_size));
-    length = std::max(length, area(bottom_border_size));
-
-    if (auto const scaled_length{static_cast<size_t>(length * scale * scale)};
-        length != solid_color_pixels_length ||
-        scaled_length != scaled_solid_color_pixels_length)
-    {
-        solid_color_pixels_length = length;
-        scaled_solid_color_pixels_length = scaled_length;
-        solid_color_pixels.reset(); // force a reallocation next time it's needed
-    }
-
     if (window_state.titlebar_rect().size != titlebar_size)
     {
         titlebar_size = window_state.titlebar_rect().size;
@@ -820,53 +865,42 @@ auto RendererStrategy::render_titlebar() -> std::optional<std::shared_ptr<mir::g
     needs_titlebar_redraw = false;
     needs_titlebar_buttons_redraw = false;
 
-    return make_buffer(static_geometry->buffer_format, scaled_titlebar_size, titlebar_pixels.get());
+    return reuse_or_make_titlebar_buffer(scaled_titlebar_size);
 }
 
 auto RendererStrategy::render_left_border() -> std::optional<std::shared_ptr<mir::graphics::Buffer>>
 {
-    auto const scaled_left_border_size{left_border_size * scale};
-    if (!area(scaled_left_border_size))
+    if (!area(left_border_size))
         return std::nullopt;
-    update_solid_color_pixels();
-    return make_buffer(static_geometry->buffer_format, scaled_left_border_size, solid_color_pixels.get());
+    return solid_color_border();
 }
 
 auto RendererStrategy::render_right_border() -> std::optional<std::shared_ptr<mir::graphics::Buffer>>
 {
-    auto const scaled_right_border_size{right_border_size * scale};
-    if (!area(scaled_right_border_size))
+    if (!area(right_border_size))
         return std::nullopt;
-    update_solid_color_pixels();
-    return make_buffer(static_geometry->buffer_format, scaled_right_border_size, solid_color_pixels.get());
+    return solid_color_border();
 }
 
 auto RendererStrategy::render_bottom_border() -> std::optional<std::shared_ptr<mir::graphics::Buffer>>
 {
-    auto const scaled_bottom_border_size{bottom_border_size * scale};
-    if (!area(scaled_bottom_border_size))
+    if (!area(bottom_border_size))
         return std::nullopt;
-    update_solid_color_pixels();
-    return make_buffer(static_geometry->buffer_format, scaled_bottom_border_size, solid_color_pixels.get());
+    return solid_color_border();
 }
 
-void RendererStrategy::update_solid_color_pixels()
+auto RendererStrategy::solid_color_border() -> std::shared_ptr<mir::graphics::Buffer>
 {
-    if (!solid_color_pixels)
+    if (!border_buffer)
     {
-        solid_color_pixels = alloc_pixels(geom::Size{scaled_solid_color_pixels_length, 1});
-        needs_solid_color_redraw = true;
+        unsigned char r = 0, g = 0, b = 0, a = 0;
+        unpack_pixel(current_theme->background_color, r, g, b, a);
+        float const alpha = a / 255.0f;
+        border_buffer = std::make_shared<mir::graphics::SolidColorBuffer>(
+            glm::vec4{alpha * r / 255.0f, alpha * g / 255.0f, alpha * b / 255.0f, alpha});
     }
 
-    if (needs_solid_color_redraw)
-    {
-        render_row(
-            solid_color_pixels.get(), geom::Size{scaled_solid_color_pixels_length, 1},
-            geom::Point{}, geom::Width{scaled_solid_color_pixels_length},
-            current_theme->background_color);
-    }
-
-    needs_solid_color_redraw = false;
+    return border_buffer;
 }
 
 void RendererStrategy::redraw_titlebar_background(geom::Size const scaled_titlebar_size)
@@ -945,7 +979,7 @@ void RendererStrategy::set_focus_state(MirWindowFocusState focus_state)
     {
         current_theme = new_theme;
         needs_titlebar_redraw = true;
-        needs_solid_color_redraw = true;
+        border_buffer.reset(); // force a new color next time it's needed
     }
 }
 
@@ -981,6 +1015,55 @@ auto RendererStrategy::make_buffer(MirPixelFormat format, mir::geometry::Size si
     }
 }
 
+auto RendererStrategy::reuse_or_make_titlebar_buffer(geom::Size size)
+    -> std::optional<std::shared_ptr<mir::graphics::Buffer>>
+{
+    // Nothing but us holds a buffer once the compositor (and the stream) are finished with it
+    auto const released = [](auto const& buffer) { return !buffer || buffer.use_count() == 1; };
+
+    for (auto const& buffer : titlebar_buffers)
+    {
+        if (buffer && released(buffer) && buffer->size() == size)
+        {
+            try
+            {
+                auto const mapping = mir::renderer::software::as_write_mappable(buffer)->map_writeable();
+                auto const src_stride = size.width.as_uint32_t() * sizeof(Pixel);
+                auto const dest_stride = mapping->stride().as_uint32_t();
+                for (auto y = 0u; y < size.height.as_uint32_t(); ++y)
+                {
+                    std::memcpy(
+                        mapping->data() + dest_stride * y,
+                        reinterpret_cast<unsigned char const*>(titlebar_pixels.get()) + src_stride * y,
+                        src_stride);
+                }
+                return buffer;
+            }
+            catch (std::runtime_error const&)
+            {
+                // Fall back to allocating a new buffer
+            }
+        }
+    }
+
+    auto const buffer = make_buffer(static_geometry->buffer_format, size, titlebar_pixels.get());
+    if (buffer)
+    {
+        // Replace a released slot if there is one, otherwise the buffer least recently allocated
+        auto const slot = std::ranges::find_if(titlebar_buffers, released);
+        if (slot != titlebar_buffers.end())
+        {
+            *slot = buffer.value();
+        }
+        else
+        {
+            titlebar_buffers[0] = std::move(titlebar_buffers[1]);
+            titlebar_buffers[1] = buffer.value();
+        }
+    }
+    return buffer;
+}
+
 DecorationStrategy::DecorationStrategy(std::shared_ptr<mir::graphics::GraphicBufferAllocator> const& allocator)
     : allocator{allocator}
 {
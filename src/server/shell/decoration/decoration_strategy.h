@@ -127,6 +127,9 @@ public:
     virtual ~RendererStrategy() = default;
 
     virtual void update_state(WindowState const& window_state, InputState const& input_state) = 0;
+
+    /// Each buffer is shown stretched over the logical area of its part of the decoration, so may be drawn at the
+    /// window's scale or be a single mir::graphics::SolidColorBuffer
     virtual auto render_titlebar() -> std::optional<std::shared_ptr<graphics::Buffer>> = 0;
     virtual auto render_left_border() -> std::optional<std::shared_ptr<graphics::Buffer>> = 0;
     virtual auto render_right_border() -> std::optional<std::shared_ptr<graphics::Buffer>> = 0;
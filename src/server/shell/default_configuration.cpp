@@ -29,6 +29,7 @@
 #include "basic_sticky_keys_transformer.h"
 
 #include <mir/abnormal_exit.h>
+#include <mir/executor.h>
 #include <mir/input/composite_event_filter.h>
 #include <mir/main_loop.h>
 #include <mir/options/configuration.h>
@@ -89,6 +90,7 @@ auto mir::DefaultServerConfiguration::the_decoration_manager() -> std::shared_pt
                     return std::make_unique<msd::BasicDecoration>(
                         shell,
                         executor,
+                        mir::thread_pool_executor,
                         cursor_images,
                         surface,
                         decoration_strategy);
@@ -15,6 +15,7 @@
  */
 
 #include "shm_backing.h"
+#include <mir/memory_accounting.h>
 #include <mir/raii.h>
 #include <mir/synchronised.h>
 
@@ -252,7 +253,7 @@ mir::Synchronised<std::vector<std::weak_ptr<ShmBufferSIGBUSHandler::AccessProtec
 class ShmBacking
 {
 public:
-    ShmBacking(mir::Fd backing_store, size_t claimed_size, int prot);
+    ShmBacking(mir::Fd backing_store, size_t claimed_size, int prot, mir::memory::ClientId client);
 
     template<typename Mapping, typename Parent>
     auto get_range(size_t start, size_t len, std::shared_ptr<Parent> parent)
@@ -265,15 +266,24 @@ public:
         -> std::unique_ptr<mir::shm::Mapping<T>>;
 
 private:
-    std::shared_ptr<ShmBufferSIGBUSHandler> const sigbus_handler;
+    /**
+     * Ensure the SIGBUS handler is alive for as long as this backing is
+     *
+     * Pools whose size is guaranteed by file seals never need the handler, so
+     * we only acquire it the first time an unprotected mapping is requested.
+     */
+    void ensure_sigbus_handler();
+
+    std::atomic<std::shared_ptr<ShmBufferSIGBUSHandler>> sigbus_handler;
 
     class CurrentMapping
     {
     public:
-        CurrentMapping(void* addr, size_t size, bool size_is_trustworthy)
+        CurrentMapping(void* addr, size_t size, bool size_is_trustworthy, mir::memory::ClientId client)
             : mapped_address{addr},
               size{size},
-              size_is_trustworthy{size_is_trustworthy}
+              size_is_trustworthy{size_is_trustworthy},
+              accounted{mir::memory::Category::shm_pool, client, size}
         {
         }
         ~CurrentMapping()
@@ -290,6 +300,7 @@ private:
         void* const mapped_address;
         size_t size;
         bool size_is_trustworthy;
+        mir::memory::Allocation const accounted;
     };
 
     template<typename T>
@@ -336,6 +347,7 @@ private:
     std::atomic<std::shared_ptr<CurrentMapping const>> current_mapping;
     mir::Fd const backing_store;
     int const prot;
+    mir::memory::ClientId const client;
 };
 
 auto backing_size_is_guaranteed_at_least(mir::Fd const& backing_store, size_t size) -> bool
@@ -362,10 +374,30 @@ auto backing_size_is_guaranteed_at_least(mir::Fd const& backing_store, size_t si
     return false;
 }
 
-ShmBacking::ShmBacking(mir::Fd backing_store, size_t claimed_size, int prot)
-    : sigbus_handler{ShmBufferSIGBUSHandler::get_sigbus_handler()},
-      backing_store{std::move(backing_store)},
-      prot{prot}
+/* Pools at least this large are likely to be backed by transparent huge pages,
+ * if the kernel has been configured to allow them for shmem.
+ */
+constexpr size_t const huge_page_hint_threshold{2 * 1024 * 1024};
+
+void advise_huge_pages(void* mapped_address, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+    if (size >= huge_page_hint_threshold)
+    {
+        // This is only a hint; the kernel is free to reject it (for example, if THP is
+        // disabled for shmem) and that's fine.
+        madvise(mapped_address, size, MADV_HUGEPAGE);
+    }
+#else
+    (void)mapped_address;
+    (void)size;
+#endif
+}
+
+ShmBacking::ShmBacking(mir::Fd backing_store, size_t claimed_size, int prot, mir::memory::ClientId client)
+    : backing_store{std::move(backing_store)},
+      prot{prot},
+      client{client}
 {
     if (auto result = resize(claimed_size); !result)
     {
@@ -380,6 +412,11 @@ ShmBacking::ShmBacking(mir::Fd backing_store, size_t claimed_size, int prot)
                 std::runtime_error{
                     std::format("Invalid size {} for ShmBacking", claimed_size)}
             ));
+        case mir::shm::ResizeError::over_budget:
+            BOOST_THROW_EXCEPTION((
+                mir::shm::OverBudgetError{
+                    std::format("Mapping {} bytes would exceed the client's memory budget", claimed_size)}
+            ));
         }
     }
 }
@@ -407,12 +444,33 @@ auto ShmBacking::lock_range(size_t start, size_t len)
     auto mapping = current_mapping.load();
 
     auto start_addr = static_cast<char*>(mapping->mapped_address) + start;
+
+    if (mapping->size_is_trustworthy)
+    {
+        // The kernel guarantees the backing store can't shrink out from under us;
+        // no need to do the SIGBUS dance.
+        return
+            std::unique_ptr<mir::shm::Mapping<T>>{
+                new Mapping<T>{reinterpret_cast<T*>(start_addr), len, mapping, nullptr}};
+    }
+
+    ensure_sigbus_handler();
     return
         std::unique_ptr<mir::shm::Mapping<T>>{
             new Mapping<T>{
                 reinterpret_cast<T*>(start_addr), len,
                 mapping,
-                mapping->size_is_trustworthy ? nullptr : sigbus_handler->protect_access_to(start_addr, len)}};
+                ShmBufferSIGBUSHandler::protect_access_to(start_addr, len)}};
+}
+
+void ShmBacking::ensure_sigbus_handler()
+{
+    if (!sigbus_handler.load())
+    {
+        // get_sigbus_handler() returns the same live instance to all callers, so
+        // racing stores here are harmless.
+        sigbus_handler.store(ShmBufferSIGBUSHandler::get_sigbus_handler());
+    }
 }
 
 auto ShmBacking::resize(size_t new_size) -> std::expected<void, mir::shm::ResizeError>
@@ -425,6 +483,12 @@ auto ShmBacking::resize(size_t new_size) -> std::expected<void, mir::shm::Resize
         return std::unexpected{mir::shm::ResizeError::invalid_size};
     }
 
+    if (auto const growth = new_size - (mapping ? mapping->size : 0);
+        growth && !mir::memory::ledger().admit(client, growth))
+    {
+        return std::unexpected{mir::shm::ResizeError::over_budget};
+    }
+
     void* mapped_address = mmap(nullptr, new_size, prot, MAP_SHARED, backing_store, 0);
     if (mapped_address == MAP_FAILED)
     {
@@ -433,11 +497,13 @@ auto ShmBacking::resize(size_t new_size) -> std::expected<void, mir::shm::Resize
             std::system_category(),
             "Failed to map client-provided SHM pool"}));
     }
+    advise_huge_pages(mapped_address, new_size);
 
     current_mapping.store(std::make_shared<CurrentMapping>(
         mapped_address,
         new_size,
-        backing_size_is_guaranteed_at_least(this->backing_store, new_size)));
+        backing_size_is_guaranteed_at_least(this->backing_store, new_size),
+        client));
     return {};
 }
 
@@ -525,8 +591,8 @@ private:
 class RWShmBackedPool : public mir::shm::ReadWritePool, public std::enable_shared_from_this<RWShmBackedPool>
 {
 public:
-    RWShmBackedPool(mir::Fd backing, size_t claimed_size)
-        : backing_store{std::move(backing), claimed_size, PROT_READ | PROT_WRITE}
+    RWShmBackedPool(mir::Fd backing, size_t claimed_size, mir::memory::ClientId client)
+        : backing_store{std::move(backing), claimed_size, PROT_READ | PROT_WRITE, client}
     {
     }
 
@@ -554,7 +620,8 @@ private:
 };
 }
 
-auto mir::shm::rw_pool_from_fd(mir::Fd backing, size_t claimed_size) -> std::shared_ptr<ReadWritePool>
+auto mir::shm::rw_pool_from_fd(mir::Fd backing, size_t claimed_size, memory::ClientId client)
+    -> std::shared_ptr<ReadWritePool>
 {
-    return std::make_shared<RWShmBackedPool>(std::move(backing), claimed_size);
+    return std::make_shared<RWShmBackedPool>(std::move(backing), claimed_size, client);
 }
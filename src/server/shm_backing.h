@@ -15,6 +15,7 @@
  */
 
 #include <mir/fd.h>
+#include <mir/memory_accounting.h>
 #include <mir/renderer/sw/pixel_source.h>
 
 #include <cstddef>
@@ -109,6 +110,7 @@ public:
 enum class ResizeError
 {
     invalid_size,
+    over_budget,    ///< Refused by mir::memory::ledger() for the pool's client
 };
 
 /// Thrown when the client-provided backing file descriptor cannot be mmap()ed
@@ -118,6 +120,13 @@ public:
     using std::system_error::system_error;
 };
 
+/// Thrown when mapping the pool would take its client over its budget in mir::memory::ledger()
+class OverBudgetError : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
 class ReadMappableRange
 {
 public:
@@ -172,6 +181,14 @@ public:
     auto resize(size_t new_size) -> std::expected<void, ResizeError> override = 0;
 };
 
-auto rw_pool_from_fd(mir::Fd backing, size_t claimed_size) -> std::shared_ptr<ReadWritePool>;
+/**
+ * Map a client's shm pool
+ *
+ * \param client   The client the mapping is accounted to in mir::memory::ledger(); mapping the pool,
+ *                 or growing it, is subject to the client's budget
+ * \throws         OverBudgetError if the ledger refuses the mapping
+ */
+auto rw_pool_from_fd(mir::Fd backing, size_t claimed_size, memory::ClientId client = memory::no_client)
+    -> std::shared_ptr<ReadWritePool>;
 }
 }
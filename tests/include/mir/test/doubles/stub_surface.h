@@ -41,6 +41,10 @@ struct StubSurface : scene::Surface
     void set_input_region(std::vector<geometry::Rectangle> const&) override {}
     std::vector<geometry::Rectangle> get_input_region() const override { return {}; }
     virtual void set_opaque_region(geometry::Rectangles const& ) override {}
+    auto tearing_allowed() const -> bool override { return false; }
+    void set_tearing_allowed(bool) override {}
+    auto content_type() const -> MirContentType override { return mir_content_type_none; }
+    void set_content_type(MirContentType) override {}
     void resize(geometry::Size const&) override {}
     geometry::Point top_left() const override { return {}; }
     geometry::Rectangle input_bounds() const override { return {}; }
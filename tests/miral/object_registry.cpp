@@ -0,0 +1,152 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "object_registry.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+
+using namespace testing;
+
+namespace
+{
+struct Thing
+{
+    int id;
+};
+
+struct ObjectRegistry : Test
+{
+    miral::ObjectRegistry<Thing, std::string> registry;
+
+    std::shared_ptr<Thing> const a = std::make_shared<Thing>(1);
+    std::shared_ptr<Thing> const b = std::make_shared<Thing>(2);
+};
+}
+
+TEST_F(ObjectRegistry, finds_the_value_inserted_for_an_object)
+{
+    registry.insert(a, "a");
+    registry.insert(b, "b");
+
+    EXPECT_THAT(registry.at(a), Eq("a"));
+    EXPECT_THAT(registry.at(b), Eq("b"));
+    EXPECT_THAT(registry.size(), Eq(2u));
+}
+
+TEST_F(ObjectRegistry, finds_nothing_for_an_unknown_object)
+{
+    registry.insert(a, "a");
+
+    EXPECT_THAT(registry.find(b), IsNull());
+    EXPECT_THROW(registry.at(b), std::out_of_range);
+    EXPECT_THAT(registry.find(std::weak_ptr<Thing>{}), IsNull());
+}
+
+TEST_F(ObjectRegistry, insert_replaces_an_existing_value)
+{
+    registry.insert(a, "old");
+    registry.insert(a, "new");
+
+    EXPECT_THAT(registry.at(a), Eq("new"));
+    EXPECT_THAT(registry.size(), Eq(1u));
+}
+
+TEST_F(ObjectRegistry, erased_values_are_not_found)
+{
+    registry.insert(a, "a");
+    registry.insert(b, "b");
+
+    registry.erase(a);
+
+    EXPECT_THAT(registry.find(a), IsNull());
+    EXPECT_THAT(registry.at(b), Eq("b"));
+    EXPECT_THAT(registry.size(), Eq(1u));
+}
+
+TEST_F(ObjectRegistry, values_of_expired_objects_can_be_found_and_erased)
+{
+    auto c = std::make_shared<Thing>(3);
+    std::weak_ptr<Thing> const weak_c{c};
+    registry.insert(c, "c");
+    c.reset();
+
+    EXPECT_THAT(registry.find(weak_c), Pointee(Eq("c")));
+
+    registry.erase(weak_c);
+
+    EXPECT_THAT(registry.find(weak_c), IsNull());
+    EXPECT_THAT(registry.size(), Eq(0u));
+}
+
+TEST_F(ObjectRegistry, a_new_object_at_a_reused_address_is_not_confused_with_an_expired_one)
+{
+    Thing storage{4};
+    auto old_owner = std::make_shared<int>();
+    auto const new_owner = std::make_shared<int>();
+    std::shared_ptr<Thing> old_thing{old_owner, &storage};
+    std::shared_ptr<Thing> const new_thing{new_owner, &storage};
+    std::weak_ptr<Thing> const weak_old_thing{old_thing};
+
+    registry.insert(old_thing, "old");
+    old_thing.reset();
+    old_owner.reset();
+
+    EXPECT_THAT(registry.find(new_thing), IsNull());
+
+    registry.insert(new_thing, "new");
+    EXPECT_THAT(registry.at(new_thing), Eq("new"));
+
+    registry.erase(weak_old_thing);
+    EXPECT_THAT(registry.at(new_thing), Eq("new"));
+}
+
+TEST_F(ObjectRegistry, references_remain_valid_as_the_registry_grows)
+{
+    auto& value = registry.insert(a, "a");
+
+    std::vector<std::shared_ptr<Thing>> others;
+    for (auto i = 0; i != 1000; ++i)
+    {
+        others.push_back(std::make_shared<Thing>(i));
+        registry.insert(others.back(), std::to_string(i));
+    }
+
+    EXPECT_THAT(&registry.at(a), Eq(&value));
+}
+
+TEST_F(ObjectRegistry, erased_slots_are_reused)
+{
+    registry.insert(a, "a");
+    auto const* const slot = &registry.at(a);
+    registry.erase(a);
+
+    EXPECT_THAT(&registry.insert(b, "b"), Eq(slot));
+}
+
+TEST_F(ObjectRegistry, for_each_visits_every_value)
+{
+    registry.insert(a, "a");
+    registry.insert(b, "b");
+
+    std::vector<std::string> visited;
+    registry.for_each([&](std::string const& value) { visited.push_back(value); });
+
+    EXPECT_THAT(visited, UnorderedElementsAre("a", "b"));
+    EXPECT_THAT(registry.find_if([](std::string const& value) { return value == "b"; }), Pointee(Eq("b")));
+}
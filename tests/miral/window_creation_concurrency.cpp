@@ -0,0 +1,128 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_window_manager_tools.h"
+#include <mir/events/event_builders.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace miral;
+using namespace testing;
+namespace mt = mir::test;
+
+namespace
+{
+Rectangle const display_area{{0, 0}, {640, 480}};
+
+struct WindowCreationConcurrency : mt::TestWindowManagerTools
+{
+    mir::EventUPtr const event{
+        mir::events::make_pointer_event({}, std::chrono::nanoseconds{100}, {}, {}, {}, {}, {}, {}, {}, {}, {})};
+    MirPointerEvent const* const pointer_event = mir_input_event_get_pointer_event(mir_event_get_input_event(event.get()));
+
+    void SetUp() override
+    {
+        notify_configuration_applied(create_fake_display_configuration({display_area}));
+        basic_window_manager.add_session(session);
+
+        creation_parameters.type = mir_window_type_normal;
+        creation_parameters.set_size({200, 200});
+    }
+
+    mir::shell::SurfaceSpecification creation_parameters;
+};
+
+struct SessionWithMockDestroy : mt::StubStubSession
+{
+    MOCK_METHOD(void, destroy_surface, (std::shared_ptr<mir::scene::Surface> const&), (override));
+};
+}
+
+TEST_F(WindowCreationConcurrency, pointer_events_are_handled_while_a_surface_is_being_built)
+{
+    // Declared outside the build function so that, if the event is blocked, it is only waited for once the surface
+    // has been added and the test can fail rather than hang
+    std::future<void> handled;
+    bool handled_during_build{false};
+
+    basic_window_manager.add_surface(session, creation_parameters,
+        [&](std::shared_ptr<mir::scene::Session> const& session, mir::shell::SurfaceSpecification const& params)
+        {
+            handled = std::async(std::launch::async, [&]{ basic_window_manager.handle_pointer_event(pointer_event); });
+            handled_during_build = handled.wait_for(std::chrono::seconds{10}) == std::future_status::ready;
+            return create_surface(session, params);
+        });
+
+    EXPECT_TRUE(handled_during_build);
+}
+
+TEST_F(WindowCreationConcurrency, window_is_known_once_added)
+{
+    Window window;
+    EXPECT_CALL(*window_manager_policy, advise_new_window(_))
+        .WillOnce([&window](WindowInfo const& window_info) { window = window_info.window(); });
+
+    basic_window_manager.add_surface(session, creation_parameters, &create_surface);
+
+    ASSERT_TRUE(window);
+    EXPECT_THAT(basic_window_manager.info_for(window).window(), Eq(window));
+    EXPECT_THAT(basic_window_manager.info_for(session).windows(), ElementsAre(window));
+}
+
+TEST_F(WindowCreationConcurrency, surface_is_destroyed_if_its_session_is_removed_while_it_is_being_built)
+{
+    auto const removed_session = std::make_shared<SessionWithMockDestroy>();
+    basic_window_manager.add_session(removed_session);
+
+    std::shared_ptr<mir::scene::Surface> built;
+    EXPECT_CALL(*removed_session, destroy_surface(_))
+        .WillOnce([&built](std::shared_ptr<mir::scene::Surface> const& surface) { EXPECT_THAT(surface, Eq(built)); });
+    EXPECT_CALL(*window_manager_policy, advise_new_window(_)).Times(0);
+
+    EXPECT_THROW(
+        basic_window_manager.add_surface(removed_session, creation_parameters,
+            [&](std::shared_ptr<mir::scene::Session> const& session, mir::shell::SurfaceSpecification const& params)
+            {
+                basic_window_manager.remove_session(session);
+                built = create_surface(session, params);
+                return built;
+            }),
+        std::runtime_error);
+}
+
+TEST_F(WindowCreationConcurrency, surfaces_are_built_one_at_a_time)
+{
+    std::atomic<int> building{0};
+    std::atomic<bool> overlapped{false};
+
+    auto const build = [&](std::shared_ptr<mir::scene::Session> const& session, mir::shell::SurfaceSpecification const& params)
+        {
+            if (++building > 1)
+                overlapped = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            --building;
+            return create_surface(session, params);
+        };
+
+    auto other = std::async(std::launch::async,
+        [&]{ basic_window_manager.add_surface(session, creation_parameters, build); });
+    basic_window_manager.add_surface(session, creation_parameters, build);
+    other.get();
+
+    EXPECT_FALSE(overlapped);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "workspace_membership.h"
+#include "test_window_manager_tools.h"
+
+#include <mir/test/doubles/stub_surface.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace testing;
+namespace mt = mir::test;
+
+namespace
+{
+struct WorkspaceMembership : mt::TestWindowManagerTools
+{
+    miral::WorkspaceMembership membership;
+
+    auto make_window() -> miral::Window
+    {
+        surfaces.push_back(std::make_shared<mir::test::doubles::StubSurface>());
+        return miral::Window{session, surfaces.back()};
+    }
+
+    std::vector<std::shared_ptr<mir::scene::Surface>> surfaces;
+    std::shared_ptr<miral::Workspace> const one = basic_window_manager.create_workspace();
+    std::shared_ptr<miral::Workspace> const two = basic_window_manager.create_workspace();
+};
+}
+
+TEST_F(WorkspaceMembership, windows_are_listed_in_the_order_added)
+{
+    auto const a = make_window();
+    auto const b = make_window();
+
+    EXPECT_TRUE(membership.add(one, b));
+    EXPECT_TRUE(membership.add(one, a));
+
+    EXPECT_THAT(membership.windows_in(one), ElementsAre(b, a));
+    EXPECT_THAT(membership.windows_in(two), IsEmpty());
+}
+
+TEST_F(WorkspaceMembership, adding_a_window_twice_is_reported)
+{
+    auto const a = make_window();
+
+    EXPECT_TRUE(membership.add(one, a));
+    EXPECT_FALSE(membership.add(one, a));
+
+    EXPECT_THAT(membership.windows_in(one), ElementsAre(a));
+}
+
+TEST_F(WorkspaceMembership, knows_which_workspaces_contain_a_window)
+{
+    auto const a = make_window();
+    auto const b = make_window();
+    membership.add(two, a);
+    membership.add(one, a);
+    membership.add(one, b);
+
+    EXPECT_THAT(membership.workspaces_containing(a), ElementsAre(two, one));
+    EXPECT_THAT(membership.workspaces_containing(b), ElementsAre(one));
+    EXPECT_TRUE(membership.in_any_of(b, {two, one}));
+    EXPECT_FALSE(membership.in_any_of(b, {two}));
+}
+
+TEST_F(WorkspaceMembership, removing_a_window_from_a_workspace_leaves_its_other_workspaces)
+{
+    auto const a = make_window();
+    membership.add(one, a);
+    membership.add(two, a);
+
+    EXPECT_TRUE(membership.remove(one, a));
+    EXPECT_FALSE(membership.remove(one, a));
+
+    EXPECT_THAT(membership.windows_in(one), IsEmpty());
+    EXPECT_THAT(membership.workspaces_containing(a), ElementsAre(two));
+}
+
+TEST_F(WorkspaceMembership, removing_a_window_removes_it_from_every_workspace)
+{
+    auto const a = make_window();
+    auto const b = make_window();
+    membership.add(one, a);
+    membership.add(two, a);
+    membership.add(two, b);
+
+    membership.remove(a);
+
+    EXPECT_THAT(membership.windows_in(one), IsEmpty());
+    EXPECT_THAT(membership.windows_in(two), ElementsAre(b));
+    EXPECT_THAT(membership.workspaces_containing(a), IsEmpty());
+}
+
+TEST_F(WorkspaceMembership, take_all_empties_a_workspace)
+{
+    auto const a = make_window();
+    auto const b = make_window();
+    membership.add(one, a);
+    membership.add(one, b);
+    membership.add(two, b);
+
+    EXPECT_THAT(membership.take_all(one), ElementsAre(a, b));
+
+    EXPECT_THAT(membership.windows_in(one), IsEmpty());
+    EXPECT_THAT(membership.workspaces_containing(b), ElementsAre(two));
+}
+
+TEST_F(WorkspaceMembership, a_destroyed_workspace_can_be_forgotten)
+{
+    auto const a = make_window();
+    auto three = basic_window_manager.create_workspace();
+    std::weak_ptr<miral::Workspace> const weak_three{three};
+    membership.add(three, a);
+    membership.add(one, a);
+    three.reset();
+
+    membership.forget(weak_three);
+
+    EXPECT_THAT(membership.workspaces_containing(a), ElementsAre(one));
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_TEST_MICRO_BENCHMARK_H_
+#define MIR_TEST_MICRO_BENCHMARK_H_
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <string>
+
+namespace mir { namespace test {
+
+/**
+ * Run \a operation \a iterations times and return the mean wall-clock time per iteration
+ *
+ * One untimed warm-up iteration is run first, so that first-use costs (page faults,
+ * lazy initialisation, and so on) don't dominate short runs.
+ */
+template<typename Operation>
+auto mean_time_per_iteration(int iterations, Operation&& operation) -> std::chrono::nanoseconds
+{
+    operation();
+
+    auto const start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        operation();
+    }
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) / iterations;
+}
+
+/**
+ * Record a benchmark result both in the gtest XML output and on stderr
+ */
+inline void record_benchmark_result(std::string const& name, std::chrono::nanoseconds per_iteration)
+{
+    testing::Test::RecordProperty(name, std::to_string(per_iteration.count()));
+    std::cerr << std::format("{}: {} ns/iteration", name, per_iteration.count()) << std::endl;
+}
+
+} } // namespace mir::test
+
+#endif // MIR_TEST_MICRO_BENCHMARK_H_
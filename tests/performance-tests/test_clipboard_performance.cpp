@@ -0,0 +1,106 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "micro_benchmark.h"
+
+#include "src/server/frontend_xwayland/clipboard_chunk_queue.h"
+#include <mir/fd.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <system_error>
+#include <thread>
+
+namespace mf = mir::frontend;
+namespace mt = mir::test;
+
+namespace
+{
+size_t const paste_size = 100 * 1024 * 1024;
+// The property chunk size an X server with BIG-REQUESTS lets us use
+size_t const chunk_size = 1024 * 1024;
+int const iterations = 5;
+
+/// Measures ClipboardChunkQueue alone: the X11 side is simulated by pushing chunks straight into the queue, so
+/// neither an X server nor XWaylandClipboardSource's property handling is part of the cost.
+struct ClipboardChunkQueuePerformance : testing::Test
+{
+    /// Queues paste_size bytes in chunk_size pieces, as X11 properties would deliver them, and writes them to a pipe
+    void paste_through_queue()
+    {
+        int fds[2];
+        if (pipe2(fds, O_CLOEXEC | O_NONBLOCK) != 0)
+        {
+            throw std::system_error{errno, std::system_category(), "Failed to create pipe"};
+        }
+        mir::Fd const read_end{fds[0]};
+        mir::Fd const write_end{fds[1]};
+
+        std::atomic<bool> receiver_failed{false};
+        std::thread receiver{[&]()
+            {
+                std::vector<uint8_t> buffer(64 * 1024);
+                size_t received = 0;
+                while (received < paste_size)
+                {
+                    pollfd pfd{read_end, POLLIN, 0};
+                    poll(&pfd, 1, -1);
+                    auto const len = read(read_end, buffer.data(), buffer.size());
+                    if (len <= 0)
+                    {
+                        receiver_failed = true;
+                        break;
+                    }
+                    received += len;
+                }
+            }};
+
+        mf::ClipboardChunkQueue queue;
+        size_t delivered = 0;
+        while ((delivered < paste_size || !queue.empty()) && !receiver_failed)
+        {
+            // Like XWaylandClipboardSource, accept the next chunk only once the backlog has drained below a bound
+            if (delivered < paste_size && queue.pending_bytes() < 4 * chunk_size)
+            {
+                queue.push(std::vector<uint8_t>(chunk_size, 0x5a));
+                delivered += chunk_size;
+                continue;
+            }
+
+            // Time out now and then, so a receiver that has given up can't leave us waiting on a full pipe
+            pollfd pfd{write_end, POLLOUT, 0};
+            if (poll(&pfd, 1, 100) > 0 && queue.write_to(write_end) < 0 && errno != EAGAIN)
+            {
+                break;
+            }
+        }
+
+        receiver.join();
+        EXPECT_FALSE(receiver_failed);
+    }
+};
+}
+
+TEST_F(ClipboardChunkQueuePerformance, queue_100MB_paste)
+{
+    auto const cost = mt::mean_time_per_iteration(iterations, [&] { paste_through_queue(); });
+
+    mt::record_benchmark_result("chunk_queue_100MB_ns", cost);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "micro_benchmark.h"
+
+#include <mir/log.h>
+#include <mir/logging/async_logger.h>
+#include <mir/logging/logger.h>
+
+#include <format>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ml = mir::logging;
+namespace mt = mir::test;
+
+namespace
+{
+/// Mir logs in bursts (a client connecting, an output being configured) rather than continuously
+int const burst_length = 64;
+int const bursts = 200;
+
+/// Formats and writes messages just as DumbConsoleLogger does, but to somewhere that won't fill the test output
+class NullDeviceLogger : public ml::Logger
+{
+public:
+    void log(ml::Severity severity, std::string const& message, std::string const& component) override
+    {
+        ml::format_message(out, severity, message, component);
+    }
+
+private:
+    std::ofstream out{"/dev/null"};
+};
+
+struct LoggingPerformance : testing::TestWithParam<int>
+{
+    /// The mean time a call to ml::log() takes, with GetParam() threads logging bursts of messages at once
+    ///
+    /// \param between_bursts  Called, untimed, after each burst
+    template<typename F>
+    auto cost_of_logging(F const& between_bursts) -> std::chrono::nanoseconds
+    {
+        std::vector<std::chrono::nanoseconds> results(GetParam(), std::chrono::nanoseconds{0});
+        std::vector<std::thread> threads;
+        for (auto& result : results)
+        {
+            threads.emplace_back([&result, &between_bursts]
+                {
+                    for (auto i = 0; i != bursts; ++i)
+                    {
+                        result += mt::mean_time_per_iteration(burst_length, []
+                            {
+                                ml::log(ml::Severity::informational, "A message of a typical length, with a number: 42", "perf");
+                            });
+                        between_bursts();
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::chrono::nanoseconds total{0};
+        for (auto const result : results)
+        {
+            total += result;
+        }
+        return total / (GetParam() * bursts);
+    }
+
+    void TearDown() override
+    {
+        ml::set_logger(std::make_shared<NullDeviceLogger>());
+    }
+};
+}
+
+TEST_P(LoggingPerformance, synchronous_logging)
+{
+    ml::set_logger(std::make_shared<NullDeviceLogger>());
+
+    mt::record_benchmark_result(
+        std::format("synchronous_log_ns_{}_threads", GetParam()),
+        cost_of_logging([] {}));
+}
+
+TEST_P(LoggingPerformance, asynchronous_logging)
+{
+    auto const logger = std::make_shared<ml::AsyncLogger>(std::make_shared<NullDeviceLogger>());
+    ml::set_logger(logger);
+
+    mt::record_benchmark_result(
+        std::format("asynchronous_log_ns_{}_threads", GetParam()),
+        cost_of_logging([&] { EXPECT_TRUE(logger->flush(std::chrono::seconds{10})); }));
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, LoggingPerformance, testing::Values(1, 4));
+
+namespace
+{
+int const iterations = 100'000;
+
+/// A debug message like those on hot paths such as XWaylandWM::handle_property_notify()
+void log_property_notify(ml::Tag const& tag)
+{
+    mir::log_debug(
+        {tag},
+        "XCB_PROPERTY_NOTIFY ({}).{}: {}",
+        "0x1a00003 (Firefox, 800x600)",
+        "_NET_WM_USER_TIME",
+        "CARDINAL: 12345678");
+}
+
+ml::Tag const& benchmark_tag = ml::create_tag(ml::base(), "tagged-logging-performance");
+ml::Tag const& other_tag = ml::create_tag(ml::base(), "tagged-logging-performance-other");
+
+struct TaggedLoggingPerformance : testing::Test
+{
+    TaggedLoggingPerformance()
+    {
+        ml::set_logger(std::make_shared<NullDeviceLogger>());
+    }
+
+    ~TaggedLoggingPerformance()
+    {
+        ml::tag::set_severity("base/tagged-logging-performance", ml::Severity::warning);
+        ml::tag::set_severity("base/tagged-logging-performance-other", ml::Severity::warning);
+    }
+};
+}
+
+TEST_F(TaggedLoggingPerformance, disabled_debug_message)
+{
+    ASSERT_FALSE(ml::logging_enabled_for({benchmark_tag}, ml::Severity::debug));
+
+    mt::record_benchmark_result(
+        "disabled_tagged_log_ns",
+        mt::mean_time_per_iteration(iterations, [] { log_property_notify(benchmark_tag); }));
+}
+
+TEST_F(TaggedLoggingPerformance, disabled_debug_message_with_another_tag_enabled)
+{
+    ml::tag::set_severity("base/tagged-logging-performance-other", ml::Severity::debug);
+    ASSERT_FALSE(ml::logging_enabled_for({benchmark_tag}, ml::Severity::debug));
+    ASSERT_TRUE(ml::logging_enabled_for({other_tag}, ml::Severity::debug));
+
+    mt::record_benchmark_result(
+        "disabled_tagged_log_other_enabled_ns",
+        mt::mean_time_per_iteration(iterations, [] { log_property_notify(benchmark_tag); }));
+}
+
+TEST_F(TaggedLoggingPerformance, enabled_debug_message)
+{
+    ml::tag::set_severity("base/tagged-logging-performance", ml::Severity::debug);
+
+    mt::record_benchmark_result(
+        "enabled_tagged_log_ns",
+        mt::mean_time_per_iteration(iterations / 10, [] { log_property_notify(benchmark_tag); }));
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "micro_benchmark.h"
+
+#include <mir/observer_multiplexer.h>
+#include <mir/executor.h>
+
+#include <format>
+#include <memory>
+#include <vector>
+
+namespace mt = mir::test;
+
+namespace
+{
+int const iterations = 100'000;
+
+struct MoveObserver
+{
+    virtual ~MoveObserver() = default;
+    virtual void moved_to(int x, int y, std::shared_ptr<int> const& surface) = 0;
+};
+
+struct CountingObserver : MoveObserver
+{
+    void moved_to(int x, int y, std::shared_ptr<int> const&) override
+    {
+        total += x + y;
+    }
+
+    long total{0};
+};
+
+/// Runs work inline, but is not the immediate_executor, so observations are packaged for it
+struct InlineExecutor : mir::Executor
+{
+    void spawn(std::function<void()>&& work) override
+    {
+        work();
+    }
+};
+
+struct MoveMultiplexer : mir::ObserverMultiplexer<MoveObserver>
+{
+    MoveMultiplexer()
+        : ObserverMultiplexer{mir::immediate_executor}
+    {
+    }
+
+    void moved_to(int x, int y, std::shared_ptr<int> const& surface) override
+    {
+        for_each_observer(&MoveObserver::moved_to, x, y, surface);
+    }
+};
+
+struct ObserverMultiplexerPerformance : testing::TestWithParam<int>
+{
+    auto notification_cost(mir::Executor& executor) -> std::chrono::nanoseconds
+    {
+        std::vector<std::shared_ptr<CountingObserver>> observers;
+        for (auto i = 0; i != GetParam(); ++i)
+        {
+            observers.push_back(std::make_shared<CountingObserver>());
+            multiplexer.register_interest(observers.back(), executor);
+        }
+
+        auto const surface = std::make_shared<int>(0);
+        auto x = 0;
+        return mt::mean_time_per_iteration(iterations, [&] { multiplexer.moved_to(++x, 0, surface); });
+    }
+
+    MoveMultiplexer multiplexer;
+};
+}
+
+TEST_P(ObserverMultiplexerPerformance, notify_immediate_observers)
+{
+    auto const cost = notification_cost(mir::immediate_executor);
+
+    mt::record_benchmark_result(std::format("notify_{}_immediate_observers_ns", GetParam()), cost);
+}
+
+TEST_P(ObserverMultiplexerPerformance, notify_observers_with_own_executor)
+{
+    InlineExecutor executor;
+    auto const cost = notification_cost(executor);
+
+    mt::record_benchmark_result(std::format("notify_{}_executor_observers_ns", GetParam()), cost);
+}
+
+INSTANTIATE_TEST_SUITE_P(ObserverCount, ObserverMultiplexerPerformance, testing::Values(1, 4, 16, 64));
@@ -0,0 +1,225 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "micro_benchmark.h"
+
+#include "src/server/compositor/basic_screen_shooter.h"
+#include <mir/executor.h>
+#include <mir/graphics/display_sink.h>
+#include <mir/renderer/gl/gl_surface.h>
+#include <mir/time/steady_clock.h>
+
+#include <mir/test/doubles/fake_alarm_factory.h>
+#include <mir/test/doubles/stub_buffer.h>
+#include <mir/test/doubles/stub_buffer_allocator.h>
+#include <mir/test/doubles/stub_cursor.h>
+#include <mir/test/doubles/stub_gl_config.h>
+#include <mir/test/doubles/stub_gl_rendering_provider.h>
+#include <mir/test/doubles/stub_output_filter.h>
+#include <mir/test/doubles/stub_renderer.h>
+#include <mir/test/doubles/stub_scene.h>
+
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+namespace mc = mir::compositor;
+namespace mg = mir::graphics;
+namespace mr = mir::renderer;
+namespace mt = mir::test;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+int const frames = 300;
+// A streaming client cycling through a small ring of buffers
+int const buffers_in_flight = 3;
+
+/* Stands in for the GL readback: writes every pixel of the capture target,
+ * which is the dominant per-frame cost of a CPU capture.
+ */
+class ReadbackOutputSurface : public mg::gl::OutputSurface
+{
+public:
+    explicit ReadbackOutputSurface(mg::CPUAddressableDisplayAllocator& allocator)
+        : allocator{allocator},
+          format{allocator.supported_formats().front()}
+    {
+    }
+
+    void bind() override {}
+    void make_current() override {}
+    void release_current() override {}
+
+    auto commit() -> std::unique_ptr<mg::Framebuffer> override
+    {
+        auto fb = allocator.alloc_fb(format);
+        auto const mapping = fb->map_writeable();
+        std::memset(mapping->data(), 0x7f, mapping->len());
+        return fb;
+    }
+
+    auto size() const -> geom::Size override { return allocator.output_size(); }
+    auto layout() const -> Layout override { return Layout::TopRowFirst; }
+
+private:
+    mg::CPUAddressableDisplayAllocator& allocator;
+    mg::DRMFormat const format;
+};
+
+class ReadbackRenderingProvider : public mtd::StubGlRenderingProvider
+{
+public:
+    auto surface_for_sink(mg::DisplaySink& sink, mg::GLConfig const&)
+        -> std::unique_ptr<mg::gl::OutputSurface> override
+    {
+        if (auto const allocator = sink.acquire_compatible_allocator<mg::CPUAddressableDisplayAllocator>())
+        {
+            return std::make_unique<ReadbackOutputSurface>(*allocator);
+        }
+        BOOST_THROW_EXCEPTION((std::runtime_error{"Benchmark only supports CPU-addressable targets"}));
+    }
+};
+
+class CommittingRenderer : public mtd::StubRenderer
+{
+public:
+    explicit CommittingRenderer(std::unique_ptr<mg::gl::OutputSurface> surface)
+        : surface{std::move(surface)}
+    {
+    }
+
+    auto render(mg::RenderableList const&) const -> std::unique_ptr<mg::Framebuffer> override
+    {
+        return surface->commit();
+    }
+
+private:
+    std::unique_ptr<mg::gl::OutputSurface> const surface;
+};
+
+class CommittingRendererFactory : public mr::RendererFactory
+{
+public:
+    auto create_renderer_for(
+        std::unique_ptr<mg::gl::OutputSurface> output_surface,
+        std::shared_ptr<mg::GLRenderingProvider>) const -> std::unique_ptr<mr::Renderer> override
+    {
+        return std::make_unique<CommittingRenderer>(std::move(output_surface));
+    }
+};
+
+/// A micro-benchmark of how BasicScreenShooter queues and completes a stream of capture requests
+///
+/// Rendering is stubbed out, and the GL readback is replaced by a memset of the capture target, so this measures
+/// the shooter's queueing and the cost of touching every pixel once, not the cost of a real capture.
+struct ScreenShooterQueueingPerformance : testing::Test
+{
+    struct Result
+    {
+        std::chrono::nanoseconds frame_time;
+        std::chrono::nanoseconds latency;
+    };
+
+    /// Stream [frames] captures of [size], keeping [buffers_in_flight] requested at a time
+    auto stream_captures(geom::Size size) -> Result
+    {
+        std::vector<std::shared_ptr<mtd::StubBuffer>> buffers;
+        for (auto i = 0; i != buffers_in_flight; ++i)
+        {
+            buffers.push_back(std::make_shared<mtd::StubBuffer>(size));
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        int completed{0};
+        std::chrono::nanoseconds total_latency{0};
+
+        auto const request = [&](int frame)
+            {
+                auto const requested = std::chrono::steady_clock::now();
+                shooter.capture(
+                    buffers[frame % buffers_in_flight],
+                    geom::Rectangle{{0, 0}, size},
+                    glm::mat2{1},
+                    false,
+                    [&, requested](auto)
+                    {
+                        std::lock_guard lock{mutex};
+                        total_latency += std::chrono::steady_clock::now() - requested;
+                        ++completed;
+                        cv.notify_all();
+                    });
+            };
+
+        auto const start = std::chrono::steady_clock::now();
+        for (auto frame = 0; frame != frames; ++frame)
+        {
+            {
+                // Like a real client, only reuse a buffer once its previous capture is done
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [&]() { return frame - completed < buffers_in_flight; });
+            }
+            request(frame);
+        }
+        {
+            std::unique_lock lock{mutex};
+            cv.wait(lock, [&]() { return completed == frames; });
+        }
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        return {
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) / frames,
+            total_latency / frames};
+    }
+
+    void record(std::string const& name, Result const& result)
+    {
+        mt::record_benchmark_result(name + "_frame_ns", result.frame_time);
+        mt::record_benchmark_result(name + "_latency_ns", result.latency);
+        std::cerr << std::format("{}: {:.1f} fps sustained", name, 1s / std::chrono::duration<double>{result.frame_time})
+                  << std::endl;
+    }
+
+    std::vector<std::shared_ptr<mg::GLRenderingProvider>> providers{std::make_shared<ReadbackRenderingProvider>()};
+    // Never advanced, so the renderer is never released as idle part way through a benchmark
+    mtd::FakeAlarmFactory alarm_factory;
+    mc::BasicScreenShooter shooter{
+        std::make_shared<mtd::StubScene>(),
+        std::make_shared<mir::time::SteadyClock>(),
+        mir::thread_pool_executor,
+        alarm_factory,
+        providers,
+        std::make_shared<CommittingRendererFactory>(),
+        std::shared_ptr<mtd::StubBufferAllocator>{},
+        std::make_shared<mtd::StubGLConfig>(),
+        std::make_shared<mtd::StubOutputFilter>(),
+        std::make_shared<mtd::StubCursor>()};
+};
+}
+
+TEST_F(ScreenShooterQueueingPerformance, queueing_streamed_captures_at_1080p)
+{
+    record("capture_queueing_1080p", stream_captures({1920, 1080}));
+}
+
+TEST_F(ScreenShooterQueueingPerformance, queueing_streamed_captures_at_4k)
+{
+    record("capture_queueing_4k", stream_captures({3840, 2160}));
+}
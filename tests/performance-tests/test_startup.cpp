@@ -0,0 +1,103 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "system_performance_test.h"
+
+#include <gmock/gmock.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace std::literals::chrono_literals;
+using namespace mir::test;
+
+namespace
+{
+struct StartupPerformance : SystemPerformanceTest
+{
+    void SetUp() override
+    {
+        SystemPerformanceTest::set_up_with("--startup-report=log");
+    }
+
+    void read_startup_report()
+    {
+        char line[256];
+
+        while (fgets(line, sizeof(line), server_output))
+        {
+            float ms;
+            if (char const* first = std::strstr(line, "First frame after "))
+            {
+                if (1 == sscanf(first, "First frame after %fms", &ms))
+                {
+                    first_frame_ms = ms;
+                }
+            }
+            else if (char const* client = std::strstr(line, "First client frame after "))
+            {
+                if (1 == sscanf(client, "First client frame after %fms", &ms))
+                {
+                    first_client_frame_ms = ms;
+                }
+            }
+            else if (char const* phase = std::strstr(line, "startup: "))
+            {
+                record_phase(phase + std::strlen("startup: "));
+            }
+        }
+    }
+
+    /// Record "<phase> took <n>ms ..." as the "<phase>_ms" property, e.g. "wayland_connector_ms"
+    void record_phase(char const* report)
+    {
+        report += std::strspn(report, " ");    // Nested phases are indented
+        char const* const took = std::strstr(report, " took ");
+        float ms;
+        if (!took || 1 != sscanf(took, " took %fms", &ms))
+        {
+            return;
+        }
+
+        std::string key;
+        for (char const* c = report; c != took; ++c)
+        {
+            auto const ch = static_cast<unsigned char>(*c);
+            key += std::isalnum(ch) ? static_cast<char>(std::tolower(ch)) : '_';
+        }
+        RecordProperty(key + "_ms", std::to_string(ms));
+    }
+
+    float first_frame_ms = -1.0f;
+    float first_client_frame_ms = -1.0f;
+};
+} // anonymous namespace
+
+TEST_F(StartupPerformance, time_to_first_frame)
+{
+    spawn_clients({"mir_demo_client_wayland"});
+    run_server_for(10s);
+
+    read_startup_report();
+    RecordProperty("first_frame_ms", std::to_string(first_frame_ms));
+    RecordProperty("first_client_frame_ms", std::to_string(first_client_frame_ms));
+
+    // Generous budgets: these catch startup regressing by an order of magnitude, not noise
+    EXPECT_THAT(first_frame_ms, testing::AllOf(testing::Ge(0.0f), testing::Le(5000.0f)));
+    EXPECT_THAT(first_client_frame_ms, testing::AllOf(testing::Ge(0.0f), testing::Le(10000.0f)));
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "micro_benchmark.h"
+
+#include <mir/scene/basic_surface.h>
+#include <mir/scene/null_surface_observer.h>
+#include <mir/executor.h>
+#include "src/server/report/null_report_factory.h"
+
+#include <mir/test/doubles/stub_buffer_stream.h>
+#include <mir/test/doubles/stub_observer_registrar.h>
+
+#include <list>
+#include <vector>
+
+namespace ms = mir::scene;
+namespace mg = mir::graphics;
+namespace mr = mir::report;
+namespace mt = mir::test;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+namespace
+{
+// A browser or video player with a deep compositing-layer tree
+int const subsurface_count = 50;
+int const iterations = 10000;
+
+// Unlike StubBufferStream, retains the callback, so registration has its real cost
+struct CallbackRetainingStream : mtd::StubBufferStream
+{
+    void set_frame_posted_callback(std::function<void(geom::Size const&)> const& callback) override
+    {
+        frame_posted_callback = callback;
+    }
+
+    std::function<void(geom::Size const&)> frame_posted_callback;
+};
+
+struct SubsurfacePerformance : testing::Test
+{
+    SubsurfacePerformance()
+    {
+        for (auto i = 0; i != subsurface_count + 1; ++i)
+        {
+            streams.push_back(std::make_shared<CallbackRetainingStream>());
+        }
+        surface.register_interest(observer, mir::immediate_executor);
+    }
+
+    auto layers_with_offset_of(int index, geom::Displacement offset) const -> std::list<ms::StreamInfo>
+    {
+        std::list<ms::StreamInfo> result;
+        for (auto i = 0u; i != streams.size(); ++i)
+        {
+            result.push_back({streams[i], i == static_cast<unsigned>(index) ? offset : geom::Displacement{}});
+        }
+        return result;
+    }
+
+    std::vector<std::shared_ptr<CallbackRetainingStream>> streams;
+    std::shared_ptr<ms::SurfaceObserver> const observer = std::make_shared<ms::NullSurfaceObserver>();
+    ms::BasicSurface surface{
+        "subsurface benchmark",
+        geom::Rectangle{{0, 0}, {1920, 1080}},
+        mir_pointer_unconfined,
+        {},
+        {},
+        mr::null_scene_report(),
+        std::make_shared<mtd::StubObserverRegistrar<mg::DisplayConfigurationObserver>>()};
+};
+}
+
+TEST_F(SubsurfacePerformance, commit_without_tree_change)
+{
+    auto const layers = layers_with_offset_of(0, {});
+    surface.set_streams(layers);
+
+    auto const cost = mt::mean_time_per_iteration(iterations, [&] { surface.set_streams(layers); });
+
+    mt::record_benchmark_result("unchanged_tree_ns", cost);
+}
+
+TEST_F(SubsurfacePerformance, commit_repositioning_one_subsurface)
+{
+    std::list<ms::StreamInfo> const positions[] = {
+        layers_with_offset_of(subsurface_count / 2, {10, 10}),
+        layers_with_offset_of(subsurface_count / 2, {20, 20})};
+
+    auto frame = 0;
+    auto const cost = mt::mean_time_per_iteration(
+        iterations,
+        [&] { surface.set_streams(positions[++frame % 2]); });
+
+    mt::record_benchmark_result("reposition_one_subsurface_ns", cost);
+}
+
+TEST_F(SubsurfacePerformance, commit_replacing_every_subsurface)
+{
+    // The worst case: every stream is new (for example, a client recreating its whole tree)
+    std::vector<std::shared_ptr<CallbackRetainingStream>> other_streams;
+    for (auto i = 0; i != subsurface_count + 1; ++i)
+    {
+        other_streams.push_back(std::make_shared<CallbackRetainingStream>());
+    }
+    std::list<ms::StreamInfo> trees[2];
+    for (auto i = 0; i != subsurface_count + 1; ++i)
+    {
+        trees[0].push_back({streams[i], {}});
+        trees[1].push_back({other_streams[i], {}});
+    }
+
+    auto frame = 0;
+    auto const cost = mt::mean_time_per_iteration(
+        iterations,
+        [&] { surface.set_streams(trees[++frame % 2]); });
+
+    mt::record_benchmark_result("replace_every_subsurface_ns", cost);
+}
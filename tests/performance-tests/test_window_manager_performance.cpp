@@ -0,0 +1,191 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "micro_benchmark.h"
+
+#include "tests/miral/test_window_manager_tools.h"
+#include <mir/events/event_builders.h>
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <thread>
+#include <vector>
+
+using namespace miral;
+using namespace std::chrono_literals;
+namespace mt = mir::test;
+
+namespace
+{
+auto const pointer_interval = 1ms;  // A 1000 Hz mouse
+int const bursts = 20;
+int const windows_per_burst = 25;
+auto const burst_interval = 50ms;
+/// Stands in for the cost of allocating a real surface and adding it to the scene
+auto const surface_build_time = 200us;
+
+void spin_for(std::chrono::steady_clock::duration duration)
+{
+    auto const until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until)
+    {
+    }
+}
+
+int const applications = 50;
+int const windows_per_application = 20;
+int const workspaces = 20;
+int const iterations = 10'000;
+
+struct WindowManagerPerformance : mt::TestWindowManagerTools
+{
+    void SetUp() override
+    {
+        notify_configuration_applied(create_fake_display_configuration({Rectangle{{0, 0}, {1920, 1080}}}));
+        basic_window_manager.add_session(session);
+    }
+
+    /// Populates the window manager with applications x windows_per_application windows, spread over workspaces
+    /// in the way a tiling window manager's user might
+    void populate_workspaces()
+    {
+        for (auto i = 0; i != workspaces; ++i)
+        {
+            workspace.push_back(basic_window_manager.create_workspace());
+        }
+
+        mir::shell::SurfaceSpecification creation_parameters;
+        creation_parameters.type = mir_window_type_normal;
+        creation_parameters.set_size({200, 200});
+
+        for (auto a = 0; a != applications; ++a)
+        {
+            auto const app = std::make_shared<mt::StubStubSession>();
+            basic_window_manager.add_session(app);
+
+            for (auto w = 0; w != windows_per_application; ++w)
+            {
+                auto const surface = basic_window_manager.add_surface(app, creation_parameters, &create_surface);
+                auto const window = basic_window_manager.info_for(surface).window();
+                basic_window_manager.add_tree_to_workspace(window, workspace[(a + w) % workspaces]);
+                windows.push_back(window);
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<miral::Workspace>> workspace;
+    std::vector<Window> windows;
+};
+}
+
+TEST_F(WindowManagerPerformance, pointer_event_latency_during_window_creation_bursts)
+{
+    std::atomic<bool> done{false};
+    std::vector<std::chrono::nanoseconds> latencies;
+
+    std::thread pointer_thread{[&]
+        {
+            auto next = std::chrono::steady_clock::now();
+            for (float x = 0; !done; x = x < 1000 ? x + 1 : 0)
+            {
+                auto const event = mir::events::make_pointer_event(
+                    {}, std::chrono::steady_clock::now().time_since_epoch(), {},
+                    mir_pointer_action_motion, {}, x, x, 0, 0, 1, 1);
+                auto const pointer_event = mir_input_event_get_pointer_event(mir_event_get_input_event(event.get()));
+
+                auto const start = std::chrono::steady_clock::now();
+                basic_window_manager.handle_pointer_event(pointer_event);
+                latencies.push_back(std::chrono::steady_clock::now() - start);
+
+                std::this_thread::sleep_until(next += pointer_interval);
+            }
+        }};
+
+    mir::shell::SurfaceSpecification creation_parameters;
+    creation_parameters.type = mir_window_type_normal;
+    creation_parameters.set_size({200, 200});
+
+    auto const build = [](std::shared_ptr<mir::scene::Session> const& session, mir::shell::SurfaceSpecification const& params)
+        {
+            spin_for(surface_build_time);
+            return create_surface(session, params);
+        };
+
+    auto const creation = mt::mean_time_per_iteration(bursts, [&]
+        {
+            for (auto i = 0; i != windows_per_burst; ++i)
+            {
+                basic_window_manager.add_surface(session, creation_parameters, build);
+            }
+            std::this_thread::sleep_for(burst_interval);
+        });
+
+    done = true;
+    pointer_thread.join();
+
+    ASSERT_FALSE(latencies.empty());
+    std::sort(latencies.begin(), latencies.end());
+    std::chrono::nanoseconds total{0};
+    for (auto const latency : latencies)
+    {
+        total += latency;
+    }
+
+    mt::record_benchmark_result("window_burst_ns", creation - burst_interval);
+    mt::record_benchmark_result("pointer_event_mean_ns", total / latencies.size());
+    mt::record_benchmark_result("pointer_event_p99_ns", latencies[latencies.size() * 99 / 100]);
+    mt::record_benchmark_result("pointer_event_max_ns", latencies.back());
+}
+
+TEST_F(WindowManagerPerformance, focus_cycling_within_an_application)
+{
+    populate_workspaces();
+    basic_window_manager.select_active_window(windows.front());
+
+    auto const per_focus_change = mt::mean_time_per_iteration(iterations, [&]
+        {
+            basic_window_manager.focus_next_within_application();
+        });
+
+    mt::record_benchmark_result(
+        std::format("focus_next_within_application_{}_windows_ns", windows.size()),
+        per_focus_change);
+}
+
+TEST_F(WindowManagerPerformance, workspace_switching)
+{
+    populate_workspaces();
+
+    // What a tiling window manager does on switching: visit each window on the workspace being shown, check which
+    // other workspaces it is also on, and look up its details to lay it out
+    auto current = 0;
+    int tiled = 0;
+    auto const per_switch = mt::mean_time_per_iteration(iterations / 10, [&]
+        {
+            current = (current + 1) % workspaces;
+            basic_window_manager.for_each_window_in_workspace(workspace[current], [&](Window const& window)
+                {
+                    basic_window_manager.for_each_workspace_containing(window, [&](auto const&) { ++tiled; });
+                    tiled += basic_window_manager.info_for(window).children().size();
+                });
+        });
+
+    EXPECT_THAT(tiled, testing::Gt(0));
+    mt::record_benchmark_result(
+        std::format("workspace_switch_{}_windows_{}_workspaces_ns", windows.size(), workspaces),
+        per_switch);
+}
@@ -15,6 +15,8 @@
  */
 
 #include <mir/executor.h>
+#include <mir/graphics/dmabuf_buffer.h>
+#include <mir/graphics/drm_formats.h>
 #include <mir/graphics/platform.h>
 #include <mir/graphics/display_sink.h>
 #include <mir/renderer/gl/gl_surface.h>
@@ -28,6 +30,7 @@
 #include <mir/test/doubles/mock_renderer_factory.h>
 #include <mir/test/doubles/advanceable_clock.h>
 #include <mir/test/doubles/explicit_executor.h>
+#include <mir/test/doubles/fake_alarm_factory.h>
 #include <mir/test/doubles/stub_buffer.h>
 #include <mir/test/doubles/stub_scene_element.h>
 #include <mir/test/doubles/stub_renderable.h>
@@ -37,6 +40,10 @@
 
 #include <gtest/gtest.h>
 
+#include <drm_fourcc.h>
+
+#include <cstring>
+
 namespace mc = mir::compositor;
 namespace mr = mir::renderer;
 namespace mg = mir::graphics;
@@ -48,6 +55,25 @@ using namespace std::chrono_literals;
 
 namespace
 {
+class StubDMABufBuffer : public mg::DMABufBuffer
+{
+public:
+    explicit StubDMABufBuffer(geom::Size size)
+        : size_{size}
+    {
+    }
+
+    auto format() const -> mg::DRMFormat override { return mg::DRMFormat{DRM_FORMAT_ARGB8888}; }
+    auto modifier() const -> std::optional<uint64_t> override { return DRM_FORMAT_MOD_LINEAR; }
+    auto planes() const -> std::vector<PlaneDescriptor> const& override { return planes_; }
+    auto layout() const -> mg::gl::Texture::Layout override { return mg::gl::Texture::Layout::TopRowFirst; }
+    auto size() const -> geom::Size override { return size_; }
+
+private:
+    geom::Size const size_;
+    std::vector<PlaneDescriptor> const planes_;
+};
+
 struct BasicScreenShooter : Test
 {
     BasicScreenShooter()
@@ -76,20 +102,48 @@ struct BasicScreenShooter : Test
                         auto surface = std::make_unique<testing::NiceMock<mtd::MockOutputSurface>>();
                         auto format = cpu_provider->supported_formats().front();
                         ON_CALL(*surface, commit())
-                            .WillByDefault([cpu_provider, format]() { return cpu_provider->alloc_fb(format); });
+                            .WillByDefault(
+                                [cpu_provider, format]()
+                                {
+                                    // Mark every pixel we "render" so tests can see where output lands
+                                    auto fb = cpu_provider->alloc_fb(format);
+                                    auto const mapping = fb->map_writeable();
+                                    std::memset(mapping->data(), 0xff, mapping->len());
+                                    return fb;
+                                });
                         ON_CALL(*surface, size())
                             .WillByDefault([cpu_provider]() { return cpu_provider->output_size(); });
                         return surface;
                     }
+                    if (auto dma_buf_provider = sink.acquire_compatible_allocator<mg::DmaBufTargetDisplayAllocator>())
+                    {
+                        auto surface = std::make_unique<testing::NiceMock<mtd::MockOutputSurface>>();
+                        ON_CALL(*surface, commit())
+                            .WillByDefault(
+                                [this, dma_buf_provider]() -> std::unique_ptr<mg::Framebuffer>
+                                {
+                                    rendered_dma_bufs.push_back(dma_buf_provider->current_target());
+                                    return nullptr;
+                                });
+                        ON_CALL(*surface, size())
+                            .WillByDefault([dma_buf_provider]() { return dma_buf_provider->output_size(); });
+                        return surface;
+                    }
                     BOOST_THROW_EXCEPTION((std::runtime_error{"CPU output support not available?!"}));
                 });
         ON_CALL(*gl_provider, suitability_for_allocator(_)).WillByDefault(Return(mg::probe::supported));
         ON_CALL(*gl_provider, suitability_for_display(_)).WillByDefault(Return(mg::probe::supported));
 
+        create_shooter();
+    }
+
+    void create_shooter()
+    {
         shooter = std::make_unique<mc::BasicScreenShooter>(
             scene,
             clock,
             executor,
+            alarm_factory,
             gl_providers,
             renderer_factory,
             buffer_allocator,
@@ -125,6 +179,7 @@ struct BasicScreenShooter : Test
     }
 
     int renderers_created{0};
+    std::vector<std::shared_ptr<mg::DMABufBuffer>> rendered_dma_bufs;
     std::vector<geom::Size> sink_sizes;
     mg::DisplaySink* captured_sink{nullptr};
     mg::CPUAddressableDisplayAllocator* captured_allocator{nullptr};
@@ -159,6 +214,7 @@ struct BasicScreenShooter : Test
     std::shared_ptr<mtd::AdvanceableClock> clock{std::make_shared<mtd::AdvanceableClock>()};
     std::shared_ptr<mtd::MockCursor> cursor{std::make_shared<mtd::MockCursor>()};
     mtd::ExplicitExecutor executor;
+    mtd::FakeAlarmFactory alarm_factory;
     std::unique_ptr<mc::BasicScreenShooter> shooter;
     std::shared_ptr<mtd::StubBuffer> buffer{std::make_shared<mtd::StubBuffer>(geom::Size{800, 600})};
     geom::Rectangle const viewport_rect{{20, 30}, {40, 50}};
@@ -259,6 +315,7 @@ TEST_F(BasicScreenShooter, ensures_renderer_is_current_on_only_one_thread)
         scene,
         clock,
         mir::thread_pool_executor,
+        alarm_factory,
         gl_providers,
         renderer_factory,
         buffer_allocator,
@@ -381,3 +438,234 @@ TEST_F(BasicScreenShooter, recovers_from_a_failure_in_render)
     EXPECT_CALL(callback, Call(std::make_optional(clock->now())));
     capture_and_run(buffer);
 }
+
+TEST_F(BasicScreenShooter, keeps_the_renderer_current_across_queued_captures)
+{
+    auto const capture_count = 3;
+    for (auto i = 0; i < capture_count; ++i)
+    {
+        shooter->capture(buffer, viewport_rect, viewport_transform, false, [&](auto time) { callback.Call(time); });
+    }
+
+    EXPECT_CALL(*next_renderer, render(_)).Times(capture_count);
+    EXPECT_CALL(*next_renderer, suspend()).Times(1);
+    EXPECT_CALL(callback, Call(std::make_optional(clock->now()))).Times(capture_count);
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, keeps_the_renderer_between_captures_in_quick_succession)
+{
+    supply_unlimited_renderers();
+
+    EXPECT_CALL(callback, Call(_)).Times(2);
+    capture_and_run(buffer);
+    alarm_factory.advance_by(mc::BasicScreenShooter::idle_timeout / 2);
+    capture_and_run(buffer);
+    alarm_factory.advance_by(mc::BasicScreenShooter::idle_timeout / 2);
+
+    EXPECT_THAT(renderers_created, Eq(1));
+}
+
+TEST_F(BasicScreenShooter, rebuilds_the_renderer_for_a_capture_after_being_idle)
+{
+    supply_unlimited_renderers();
+
+    EXPECT_CALL(callback, Call(std::make_optional(clock->now()))).Times(2);
+    capture_and_run(buffer);
+    alarm_factory.advance_by(mc::BasicScreenShooter::idle_timeout);
+    capture_and_run(buffer);
+
+    EXPECT_THAT(renderers_created, Eq(2));
+}
+
+TEST_F(BasicScreenShooter, does_not_release_the_renderer_while_capturing)
+{
+    supply_unlimited_renderers();
+
+    EXPECT_CALL(callback, Call(_)).Times(2);
+    capture_and_run(buffer);
+    shooter->capture(buffer, viewport_rect, viewport_transform, false, [&](auto time) { callback.Call(time); });
+    alarm_factory.advance_by(mc::BasicScreenShooter::idle_timeout);
+    executor.execute();
+
+    EXPECT_THAT(renderers_created, Eq(1));
+}
+
+TEST_F(BasicScreenShooter, fails_captures_beyond_the_pending_limit)
+{
+    auto const excess_captures = 2;
+    for (auto i = 0u; i < mc::BasicScreenShooter::max_pending_captures + excess_captures; ++i)
+    {
+        shooter->capture(buffer, viewport_rect, viewport_transform, false, [&](auto time) { callback.Call(time); });
+    }
+
+    EXPECT_CALL(callback, Call(std::make_optional(clock->now()))).Times(mc::BasicScreenShooter::max_pending_captures);
+    EXPECT_CALL(callback, Call(nullopt_time)).Times(excess_captures);
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, fails_pending_captures_when_destroyed)
+{
+    shooter->capture(buffer, viewport_rect, viewport_transform, false, [&](auto time) { callback.Call(time); });
+
+    EXPECT_CALL(callback, Call(nullopt_time));
+    shooter.reset();
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, supports_dma_buf_targets_if_the_provider_can_render_to_them)
+{
+    EXPECT_TRUE(shooter->supports_dma_buf_targets());
+}
+
+TEST_F(BasicScreenShooter, does_not_support_dma_buf_targets_if_the_provider_cannot_render_to_them)
+{
+    ON_CALL(*gl_provider, suitability_for_display(_))
+        .WillByDefault(
+            [](mg::DisplaySink& sink)
+            {
+                return sink.acquire_compatible_allocator<mg::DmaBufTargetDisplayAllocator>()
+                    ? mg::probe::unsupported
+                    : mg::probe::supported;
+            });
+    create_shooter();
+
+    EXPECT_FALSE(shooter->supports_dma_buf_targets());
+
+    auto const dma_buf = std::make_shared<StubDMABufBuffer>(geom::Size{800, 600});
+    EXPECT_CALL(callback, Call(nullopt_time));
+    shooter->capture(dma_buf, viewport_rect, viewport_transform, false, [&](auto time) { callback.Call(time); });
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, renders_scene_elements_directly_into_dma_buf_target)
+{
+    auto const dma_buf = std::make_shared<StubDMABufBuffer>(geom::Size{800, 600});
+    shooter->capture(dma_buf, viewport_rect, viewport_transform, false, [&](auto time) { callback.Call(time); });
+
+    EXPECT_CALL(*next_renderer, render(Eq(renderables)));
+    EXPECT_CALL(callback, Call(std::make_optional(clock->now())));
+    executor.execute();
+
+    EXPECT_THAT(rendered_dma_bufs, ElementsAre(dma_buf));
+}
+
+TEST_F(BasicScreenShooter, does_not_retain_dma_buf_target_after_capture)
+{
+    auto dma_buf = std::make_shared<StubDMABufBuffer>(geom::Size{800, 600});
+    std::weak_ptr<mg::DMABufBuffer> const weak_dma_buf = dma_buf;
+
+    EXPECT_CALL(callback, Call(std::make_optional(clock->now())));
+    shooter->capture(dma_buf, viewport_rect, viewport_transform, false, [&](auto time) { callback.Call(time); });
+    dma_buf.reset();
+    executor.execute();
+    rendered_dma_bufs.clear();
+
+    EXPECT_TRUE(weak_dma_buf.expired());
+}
+
+namespace
+{
+auto pixel_at(mtd::StubBuffer const& buffer, geom::Point point) -> uint32_t
+{
+    uint32_t pixel;
+    std::memcpy(
+        &pixel,
+        buffer.written_pixels.data() + point.y.as_int() * buffer.buf_stride.as_int() + point.x.as_int() * 4,
+        sizeof(pixel));
+    return pixel;
+}
+}
+
+TEST_F(BasicScreenShooter, region_capture_only_writes_the_requested_region)
+{
+    auto const target = std::make_shared<mtd::StubBuffer>(geom::Size{8, 6});
+    geom::Rectangle const region{{2, 1}, {3, 2}};
+
+    EXPECT_CALL(*next_renderer, set_viewport(geom::Rectangle{{2, 1}, {3, 2}}));
+    StrictMock<MockFunction<void(std::optional<mir::time::Timestamp>, geom::Rectangle const&)>> region_callback;
+    EXPECT_CALL(region_callback, Call(std::make_optional(clock->now()), region));
+
+    shooter->capture(
+        target, {{0, 0}, {8, 6}}, region, viewport_transform, false,
+        [&](auto time, auto const& updated) { region_callback.Call(time, updated); });
+    executor.execute();
+
+    for (int y = 0; y < 6; ++y)
+    {
+        for (int x = 0; x < 8; ++x)
+        {
+            geom::Point const point{x, y};
+            EXPECT_THAT(pixel_at(*target, point), Eq(region.contains(point) ? 0xffffffffu : 0u))
+                << "at " << x << ", " << y;
+        }
+    }
+}
+
+TEST_F(BasicScreenShooter, region_capture_renders_the_matching_part_of_a_scaled_area)
+{
+    auto const target = std::make_shared<mtd::StubBuffer>(geom::Size{8, 6});
+
+    EXPECT_CALL(*next_renderer, set_viewport(geom::Rectangle{{24, 32}, {6, 4}}));
+    EXPECT_CALL(callback, Call(std::make_optional(clock->now())));
+
+    shooter->capture(
+        target, {{20, 30}, {16, 12}}, {{2, 1}, {3, 2}}, viewport_transform, false,
+        [&](auto time, auto const&) { callback.Call(time); });
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, region_capture_of_an_upscaled_area_snaps_the_region_to_whole_area_pixels)
+{
+    // A 2x buffer: buffer pixel 1 is the right half of area pixel 0
+    auto const target = std::make_shared<mtd::StubBuffer>(geom::Size{8, 6});
+    geom::Rectangle const snapped_region{{0, 0}, {4, 2}};
+
+    EXPECT_CALL(*next_renderer, set_viewport(geom::Rectangle{{0, 0}, {2, 1}}));
+    StrictMock<MockFunction<void(std::optional<mir::time::Timestamp>, geom::Rectangle const&)>> region_callback;
+    EXPECT_CALL(region_callback, Call(std::make_optional(clock->now()), snapped_region));
+
+    shooter->capture(
+        target, {{0, 0}, {4, 3}}, {{1, 1}, {3, 1}}, viewport_transform, false,
+        [&](auto time, auto const& updated) { region_callback.Call(time, updated); });
+    executor.execute();
+
+    for (int y = 0; y < 6; ++y)
+    {
+        for (int x = 0; x < 8; ++x)
+        {
+            geom::Point const point{x, y};
+            EXPECT_THAT(pixel_at(*target, point), Eq(snapped_region.contains(point) ? 0xffffffffu : 0u))
+                << "at " << x << ", " << y;
+        }
+    }
+}
+
+TEST_F(BasicScreenShooter, region_capture_of_a_fractionally_scaled_area_snaps_the_region_to_shared_pixel_edges)
+{
+    // A 1.5x buffer: buffer and area pixel edges only coincide every 3 buffer pixels
+    auto const target = std::make_shared<mtd::StubBuffer>(geom::Size{12, 6});
+
+    EXPECT_CALL(*next_renderer, set_viewport(geom::Rectangle{{12, 10}, {2, 2}}));
+    StrictMock<MockFunction<void(std::optional<mir::time::Timestamp>, geom::Rectangle const&)>> region_callback;
+    EXPECT_CALL(region_callback, Call(std::make_optional(clock->now()), geom::Rectangle{{3, 0}, {3, 3}}));
+
+    shooter->capture(
+        target, {{10, 10}, {8, 4}}, {{4, 1}, {1, 1}}, viewport_transform, false,
+        [&](auto time, auto const& updated) { region_callback.Call(time, updated); });
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, region_capture_of_a_rotated_area_updates_the_whole_buffer)
+{
+    auto const target = std::make_shared<mtd::StubBuffer>(geom::Size{8, 6});
+    glm::mat2 const rotated{0, 1, -1, 0};
+
+    StrictMock<MockFunction<void(std::optional<mir::time::Timestamp>, geom::Rectangle const&)>> region_callback;
+    EXPECT_CALL(region_callback, Call(std::make_optional(clock->now()), geom::Rectangle{{0, 0}, {8, 6}}));
+
+    shooter->capture(
+        target, {{0, 0}, {6, 8}}, {{2, 1}, {3, 2}}, rotated, false,
+        [&](auto time, auto const& updated) { region_callback.Call(time, updated); });
+    executor.execute();
+}
@@ -26,6 +26,7 @@
 #include <mir/test/doubles/mock_renderer_factory.h>
 #include <mir/test/doubles/advanceable_clock.h>
 #include <mir/test/doubles/explicit_executor.h>
+#include <mir/test/doubles/fake_alarm_factory.h>
 #include <mir/test/doubles/stub_buffer.h>
 #include <mir/test/doubles/stub_output_filter.h>
 #include <mir/test/doubles/stub_gl_config.h>
@@ -54,6 +55,7 @@ public:
         factory = std::make_unique<mc::BasicScreenShooterFactory>(
             scene,
             clock,
+            alarm_factory,
             gl_providers,
             renderer_factory,
             buffer_allocator,
@@ -64,6 +66,7 @@ public:
 
     std::shared_ptr<mtd::MockScene> scene{std::make_shared<NiceMock<mtd::MockScene>>()};
     std::shared_ptr<mtd::AdvanceableClock> clock{std::make_shared<mtd::AdvanceableClock>()};
+    std::shared_ptr<mtd::FakeAlarmFactory> alarm_factory{std::make_shared<mtd::FakeAlarmFactory>()};
     mtd::ExplicitExecutor executor;
     std::shared_ptr<mtd::MockGlRenderingProvider> gl_provider{std::make_shared<NiceMock<mtd::MockGlRenderingProvider>>()};
     std::vector<std::shared_ptr<mg::GLRenderingProvider>> gl_providers{gl_provider};
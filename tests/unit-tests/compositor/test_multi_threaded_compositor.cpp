@@ -34,6 +34,9 @@
 #include <mir/test/doubles/stub_scene.h>
 #include <mir/test/doubles/stub_display.h>
 #include <mir/test/doubles/stub_renderable.h>
+#include <mir/test/doubles/stub_scene_element.h>
+#include <mir/test/doubles/stub_surface.h>
+#include <mir/test/doubles/stub_display_sink.h>
 #include <mir/test/doubles/null_display_buffer_compositor_factory.h>
 #include <mir/test/doubles/stub_cursor.h>
 
@@ -41,6 +44,8 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <atomic>
+#include <list>
 #include <thread>
 #include <mutex>
 #include <chrono>
@@ -93,6 +98,124 @@ private:
     std::vector<StubDisplaySyncGroup> buffers;
 };
 
+/// A display that, when reconfigured, replaces its first group and leaves the rest alone
+class IncrementallyReconfiguringDisplay : public mtd::NullDisplay
+{
+public:
+    IncrementallyReconfiguringDisplay(unsigned int ngroups) : groups(ngroups) {}
+
+    void for_each_display_sync_group(std::function<void(mg::DisplaySyncGroup&)> const& f) override
+    {
+        std::lock_guard lock{mutex};
+        for (auto& group : groups)
+            f(group);
+    }
+
+    void configure_incrementally(
+        mg::DisplayConfiguration const&,
+        std::function<void(mg::DisplaySyncGroup&)> const& removing) override
+    {
+        removing(groups.front());
+
+        if (fail_configuration)
+            BOOST_THROW_EXCEPTION(std::runtime_error("Configuration rejected"));
+
+        std::lock_guard lock{mutex};
+        groups.pop_front();
+        groups.emplace_back();
+    }
+
+    MOCK_METHOD(void, configure, (mg::DisplayConfiguration const&), (override));
+
+    /// Reconfiguring stops the first group, then fails without replacing it
+    std::atomic<bool> fail_configuration{false};
+
+private:
+    std::mutex mutex;
+    std::list<mtd::NullDisplaySyncGroup> groups;
+};
+
+/// A display whose groups each show one output, side by side, and take post_time to post a frame
+class PacedDisplay : public mtd::NullDisplay
+{
+public:
+    PacedDisplay(unsigned int ngroups, std::chrono::milliseconds recommended_sleep, std::chrono::milliseconds post_time)
+    {
+        for (auto i = 0u; i != ngroups; ++i)
+            groups.push_back(std::make_unique<PacedDisplaySyncGroup>(area_of(i), recommended_sleep, post_time));
+    }
+
+    void for_each_display_sync_group(std::function<void(mg::DisplaySyncGroup&)> const& f) override
+    {
+        for (auto& group : groups)
+            f(*group);
+    }
+
+    static auto area_of(unsigned int group) -> geom::Rectangle
+    {
+        return {{100 * group, 0}, {100, 100}};
+    }
+
+private:
+    struct PacedDisplaySyncGroup : mg::DisplaySyncGroup
+    {
+        PacedDisplaySyncGroup(
+            geom::Rectangle const& area,
+            std::chrono::milliseconds recommended_sleep,
+            std::chrono::milliseconds post_time)
+            : sink{area},
+              recommended_sleep_{recommended_sleep},
+              post_time{post_time}
+        {
+        }
+
+        void for_each_display_sink(std::function<void(mg::DisplaySink&)> const& f) override
+        {
+            f(sink);
+        }
+        void post() override
+        {
+            std::this_thread::sleep_for(post_time);
+        }
+        std::chrono::milliseconds recommended_sleep() const override
+        {
+            return recommended_sleep_;
+        }
+
+        mtd::StubDisplaySink sink;
+        std::chrono::milliseconds const recommended_sleep_;
+        std::chrono::milliseconds const post_time;
+    };
+
+    std::vector<std::unique_ptr<PacedDisplaySyncGroup>> groups;
+};
+
+/// A renderable of a surface that has told us what type of content it shows
+class ContentRenderable : public mtd::StubRenderable
+{
+public:
+    ContentRenderable(geom::Rectangle const& area, MirContentType content_type)
+        : StubRenderable{area},
+          surface{content_type}
+    {
+    }
+
+    auto surface_if_any() const -> std::optional<ms::Surface const*> override
+    {
+        return &surface;
+    }
+
+private:
+    struct ContentSurface : mtd::StubSurface
+    {
+        explicit ContentSurface(MirContentType content_type) : content_type_{content_type} {}
+        auto content_type() const -> MirContentType override { return content_type_; }
+        MirContentType const content_type_;
+    };
+
+    ContentSurface const surface;
+};
+
 class StubScene : public mtd::StubScene
 {
 public:
@@ -136,10 +259,25 @@ public:
         throw_on_add_observer_ = flag;
     }
 
+    /// Adds a surface showing content_type in area
+    void show(geom::Rectangle const& area, MirContentType content_type)
+    {
+        std::lock_guard lock{elements_mutex};
+        elements.push_back(std::make_shared<mtd::StubSceneElement>(std::make_shared<ContentRenderable>(area, content_type)));
+    }
+
+    mc::SceneElementSequence scene_elements_for(mc::CompositorID) override
+    {
+        std::lock_guard lock{elements_mutex};
+        return elements;
+    }
+
     private:
     std::mutex observer_mutex;
     std::shared_ptr<ms::Observer> observer;
     bool throw_on_add_observer_;
+    std::mutex elements_mutex;
+    mc::SceneElementSequence elements;
 };
 
 class RecordingDisplayBufferCompositor : public mc::DisplayBufferCompositor
@@ -583,6 +721,124 @@ TEST(MultiThreadedCompositor, recommended_sleep_throttles_compositor_loop)
     compositor.stop();
 }
 
+namespace
+{
+/// Composites nframes frames on each of nbuffers outputs, each once the last has been composited everywhere
+auto time_to_composite(StubScene& scene, RecordingDisplayBufferCompositorFactory& factory, unsigned int nbuffers, int nframes)
+    -> std::chrono::milliseconds
+{
+    using namespace std::chrono;
+
+    int const max_retries = 1000;
+    auto const start = steady_clock::now();
+
+    for (int frame = 1; frame <= nframes; ++frame)
+    {
+        scene.emit_change_event();
+
+        int retry = 0;
+        while (retry < max_retries &&
+               !factory.check_record_count_for_each_buffer(nbuffers, frame))
+        {
+            std::this_thread::sleep_for(milliseconds(1));
+            ++retry;
+        }
+        EXPECT_LT(retry, max_retries);
+    }
+
+    return duration_cast<milliseconds>(steady_clock::now() - start);
+}
+
+int const nframes = 10;
+}
+
+TEST(MultiThreadedCompositor, game_content_is_not_made_to_wait_out_the_recommended_sleep)
+{
+    using namespace testing;
+
+    std::chrono::milliseconds const recommendation{200};
+
+    auto display = std::make_shared<PacedDisplay>(1, recommendation, 0ms);
+    auto scene = std::make_shared<StubScene>();
+    scene->show(PacedDisplay::area_of(0), mir_content_type_game);
+    auto factory = std::make_shared<RecordingDisplayBufferCompositorFactory>();
+    mc::MultiThreadedCompositor compositor{display, factory, scene,
+                                           null_display_listener, null_report, stub_cursor,
+                                           default_delay, false};
+
+    compositor.start();
+
+    // Minus 2, as in recommended_sleep_throttles_compositor_loop: that is what sleeping would at least take
+    EXPECT_THAT(time_to_composite(*scene, *factory, 1, nframes), Lt(recommendation * (nframes - 2)));
+
+    compositor.stop();
+}
+
+TEST(MultiThreadedCompositor, game_content_waits_out_a_fixed_composite_delay)
+{
+    using namespace testing;
+
+    std::chrono::milliseconds const fixed_delay{10};
+
+    auto display = std::make_shared<PacedDisplay>(1, 0ms, 0ms);
+    auto scene = std::make_shared<StubScene>();
+    scene->show(PacedDisplay::area_of(0), mir_content_type_game);
+    auto factory = std::make_shared<RecordingDisplayBufferCompositorFactory>();
+    mc::MultiThreadedCompositor compositor{display, factory, scene,
+                                           null_display_listener, null_report, stub_cursor,
+                                           fixed_delay, false};
+
+    compositor.start();
+
+    EXPECT_THAT(time_to_composite(*scene, *factory, 1, nframes), Ge(fixed_delay * (nframes - 2)));
+
+    compositor.stop();
+}
+
+TEST(MultiThreadedCompositor, video_content_waits_out_the_recommended_sleep)
+{
+    using namespace testing;
+
+    std::chrono::milliseconds const recommendation{10};
+
+    auto display = std::make_shared<PacedDisplay>(1, recommendation, 0ms);
+    auto scene = std::make_shared<StubScene>();
+    scene->show(PacedDisplay::area_of(0), mir_content_type_video);
+    auto factory = std::make_shared<RecordingDisplayBufferCompositorFactory>();
+    mc::MultiThreadedCompositor compositor{display, factory, scene,
+                                           null_display_listener, null_report, stub_cursor,
+                                           default_delay, false};
+
+    compositor.start();
+
+    EXPECT_THAT(time_to_composite(*scene, *factory, 1, nframes), Ge(recommendation * (nframes - 2)));
+
+    compositor.stop();
+}
+
+TEST(MultiThreadedCompositor, photo_content_idles_for_a_frame_between_frames_while_video_is_shown_elsewhere)
+{
+    using namespace testing;
+
+    std::chrono::milliseconds const post_time{10};
+
+    auto display = std::make_shared<PacedDisplay>(2, 0ms, post_time);
+    auto scene = std::make_shared<StubScene>();
+    scene->show(PacedDisplay::area_of(0), mir_content_type_video);
+    scene->show(PacedDisplay::area_of(1), mir_content_type_photo);
+    auto factory = std::make_shared<RecordingDisplayBufferCompositorFactory>();
+    mc::MultiThreadedCompositor compositor{display, factory, scene,
+                                           null_display_listener, null_report, stub_cursor,
+                                           default_delay, false};
+
+    compositor.start();
+
+    // The photo output sleeps for as long as each frame took to post, as well as posting it
+    EXPECT_THAT(time_to_composite(*scene, *factory, 2, nframes), Ge(2 * post_time * (nframes - 2)));
+
+    compositor.stop();
+}
+
 TEST(MultiThreadedCompositor, when_no_initial_composite_is_needed_there_is_none)
 {
     using namespace testing;
@@ -934,3 +1190,74 @@ TEST(MultiThreadedCompositor, gets_renderable_if_cursor_needs_compositing)
 
     compositor.stop();
 }
+
+TEST(MultiThreadedCompositor, reconfiguring_the_display_restarts_compositing_only_for_the_groups_replaced)
+{
+    using namespace testing;
+    unsigned int const ngroups{3};
+    auto display = std::make_shared<IncrementallyReconfiguringDisplay>(ngroups);
+    auto mock_scene = std::make_shared<NiceMock<mtd::MockScene>>();
+    auto db_compositor_factory = std::make_shared<mtd::NullDisplayBufferCompositorFactory>();
+    auto mock_report = std::make_shared<NiceMock<mtd::MockCompositorReport>>();
+
+    mc::MultiThreadedCompositor compositor{
+        display, db_compositor_factory, mock_scene, null_display_listener, mock_report, stub_cursor, default_delay, true};
+
+    compositor.start();
+
+    EXPECT_CALL(*display, configure(_)).Times(0);
+    EXPECT_CALL(*mock_scene, unregister_compositor(_)).Times(1);
+    EXPECT_CALL(*mock_scene, register_compositor(_)).Times(1);
+
+    compositor.configure_display(*display, mtd::NullDisplayConfiguration{});
+
+    Mock::VerifyAndClearExpectations(mock_scene.get());
+
+    EXPECT_CALL(*mock_scene, unregister_compositor(_)).Times(ngroups);
+
+    compositor.stop();
+}
+
+TEST(MultiThreadedCompositor, failing_to_reconfigure_the_display_restarts_compositing_for_the_groups_stopped)
+{
+    using namespace testing;
+    unsigned int const ngroups{3};
+    auto display = std::make_shared<IncrementallyReconfiguringDisplay>(ngroups);
+    auto mock_scene = std::make_shared<NiceMock<mtd::MockScene>>();
+    auto db_compositor_factory = std::make_shared<mtd::NullDisplayBufferCompositorFactory>();
+    auto mock_report = std::make_shared<NiceMock<mtd::MockCompositorReport>>();
+
+    mc::MultiThreadedCompositor compositor{
+        display, db_compositor_factory, mock_scene, null_display_listener, mock_report, stub_cursor, default_delay, true};
+
+    compositor.start();
+
+    display->fail_configuration = true;
+    EXPECT_CALL(*mock_scene, unregister_compositor(_)).Times(1);
+    EXPECT_CALL(*mock_scene, register_compositor(_)).Times(1);
+
+    EXPECT_THROW(
+        compositor.configure_display(*display, mtd::NullDisplayConfiguration{}),
+        std::runtime_error);
+
+    Mock::VerifyAndClearExpectations(mock_scene.get());
+
+    EXPECT_CALL(*mock_scene, unregister_compositor(_)).Times(ngroups);
+
+    compositor.stop();
+}
+
+TEST(MultiThreadedCompositor, reconfiguring_the_display_while_stopped_configures_it_all)
+{
+    using namespace testing;
+    auto display = std::make_shared<IncrementallyReconfiguringDisplay>(3);
+    auto scene = std::make_shared<StubScene>();
+    auto db_compositor_factory = std::make_shared<mtd::NullDisplayBufferCompositorFactory>();
+
+    mc::MultiThreadedCompositor compositor{
+        display, db_compositor_factory, scene, null_display_listener, null_report, stub_cursor, default_delay, true};
+
+    EXPECT_CALL(*display, configure(_)).Times(1);
+
+    compositor.configure_display(*display, mtd::NullDisplayConfiguration{});
+}
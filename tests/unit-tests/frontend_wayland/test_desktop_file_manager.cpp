@@ -264,3 +264,25 @@ TEST_F(DesktopFileManager, app_id_will_not_resolve_from_flatpak_info_when_name_i
     EXPECT_EQ(found_app_id, APPLICATION_ID);
     ::unlink(tmp_file_name);
 }
+
+TEST(LazyDesktopFileCache, does_not_build_the_cache_until_it_is_used)
+{
+    auto builds = 0;
+    mf::LazyDesktopFileCache lazy{[&builds]() { ++builds; return std::make_shared<InMemoryDesktopFileCache>(); }};
+
+    EXPECT_THAT(builds, Eq(0));
+}
+
+TEST(LazyDesktopFileCache, builds_the_cache_once_and_forwards_lookups_to_it)
+{
+    auto builds = 0;
+    auto const cache = std::make_shared<InMemoryDesktopFileCache>();
+    auto const file = std::make_shared<mf::DesktopFile>("app_id", "wm_class", "exec");
+    cache->files.push_back(file);
+    mf::LazyDesktopFileCache lazy{[&builds, cache]() { ++builds; return cache; }};
+
+    EXPECT_THAT(lazy.lookup_by_app_id("app_id"), Eq(file));
+    EXPECT_THAT(lazy.lookup_by_wm_class("wm_class"), Eq(file));
+    EXPECT_THAT(lazy.lookup_by_exec_string("exec"), Eq(file));
+    EXPECT_THAT(builds, Eq(1));
+}
@@ -0,0 +1,368 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/single_pixel_buffer_v1.h"
+#include "src/server/frontend_wayland/wl_client.h"
+#include "src/server/frontend_wayland/wl_region.h"
+#include "src/server/frontend_wayland/wl_surface.h"
+
+#include <mir/fd.h>
+#include <mir/graphics/solid_color_buffer.h>
+#include <mir/test/doubles/explicit_executor.h>
+#include <mir/test/doubles/mock_buffer_stream.h>
+#include <mir/test/doubles/mock_scene_session.h>
+#include <mir/test/doubles/stub_buffer_allocator.h>
+#include <mir/test/doubles/stub_session_authorizer.h>
+#include <mir/test/doubles/stub_shell.h>
+
+#include <boost/throw_exception.hpp>
+#include <wayland-client.h>
+#include <sys/socket.h>
+
+#include <cstring>
+#include <limits>
+#include <system_error>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace ms = mir::scene;
+namespace mw = mir::wayland;
+namespace geom = mir::geometry;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+
+namespace mir::wayland
+{
+extern struct wl_interface const wp_single_pixel_buffer_manager_v1_interface_data;
+}
+
+namespace
+{
+/// Request opcodes, from the single-pixel-buffer-v1 protocol definition
+enum : uint32_t
+{
+    wp_single_pixel_buffer_manager_v1_destroy = 0,
+    wp_single_pixel_buffer_manager_v1_create_u32_rgba_buffer = 1,
+};
+
+auto constexpr max = std::numeric_limits<uint32_t>::max();
+
+/// Creates plain WlSurfaces, as the connector's wl_compositor does
+class TestCompositor : public mw::Compositor::Global
+{
+public:
+    TestCompositor(
+        wl_display* display,
+        std::shared_ptr<mir::Executor> const& executor,
+        std::shared_ptr<mg::GraphicBufferAllocator> const& allocator)
+        : Global{display, Version<6>()},
+          executor{executor},
+          allocator{allocator}
+    {
+    }
+
+private:
+    std::shared_ptr<mir::Executor> const executor;
+    std::shared_ptr<mg::GraphicBufferAllocator> const allocator;
+
+    class Instance : mw::Compositor
+    {
+    public:
+        Instance(wl_resource* new_resource, TestCompositor* compositor)
+            : mw::Compositor{new_resource, Version<6>()},
+              compositor{compositor}
+        {
+        }
+
+    private:
+        void create_surface(wl_resource* new_surface) override
+        {
+            new mf::WlSurface{new_surface, compositor->executor, compositor->executor, compositor->allocator};
+        }
+
+        void create_region(wl_resource* new_region) override
+        {
+            new mf::WlRegion{new_region};
+        }
+
+        TestCompositor* const compositor;
+    };
+
+    void bind(wl_resource* new_resource) override
+    {
+        new Instance{new_resource, this};
+    }
+};
+
+/// Gives every client the same session
+struct SingleSessionShell : mtd::StubShell
+{
+    explicit SingleSessionShell(std::shared_ptr<ms::Session> const& session)
+        : session{session}
+    {
+    }
+
+    auto open_session(pid_t, mir::Fd, std::string const&) -> std::shared_ptr<ms::Session> override
+    {
+        return session;
+    }
+
+    std::shared_ptr<ms::Session> const session;
+};
+
+struct SinglePixelBufferV1 : Test
+{
+    SinglePixelBufferV1()
+    {
+        ON_CALL(*session, create_buffer_stream(_))
+            .WillByDefault(Return(stream));
+        ON_CALL(*stream, submit_buffer(_, _, _))
+            .WillByDefault(SaveArg<0>(&submitted));
+
+        mf::WlClient::setup_new_client_handler(
+            server_display,
+            std::make_shared<SingleSessionShell>(session),
+            std::make_shared<mtd::StubSessionAuthorizer>(),
+            [](auto&) {});
+
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+        {
+            BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create socket pair"}));
+        }
+        wl_client_create(server_display, fds[0]);
+        client_display = wl_display_connect_to_fd(fds[1]);
+
+        auto const registry = wl_display_get_registry(client_display);
+        wl_registry_add_listener(registry, &registry_listener, this);
+        exchange_messages();
+        wl_registry_destroy(registry);
+    }
+
+    ~SinglePixelBufferV1()
+    {
+        wl_display_destroy_clients(server_display);
+        submitted.reset();
+        // Lets anything the destroyed buffers queued see that they are gone
+        executor->execute();
+        compositor.reset();
+        single_pixel_buffer_manager.reset();
+        wl_display_destroy(server_display);
+        wl_display_disconnect(client_display);
+    }
+
+    /// Delivers everything the client and server have sent each other, as both run on the test thread
+    void exchange_messages()
+    {
+        for (auto round = 0; round != 2 && !wl_display_get_error(client_display); ++round)
+        {
+            wl_display_flush(client_display);
+            wl_event_loop_dispatch(wl_display_get_event_loop(server_display), 0);
+            executor->execute();
+            wl_display_flush_clients(server_display);
+
+            while (wl_display_prepare_read(client_display) != 0)
+            {
+                if (wl_display_dispatch_pending(client_display) < 0)
+                    return;
+            }
+            wl_display_read_events(client_display);
+            wl_display_dispatch_pending(client_display);
+        }
+    }
+
+    auto create_buffer(uint32_t r, uint32_t g, uint32_t b, uint32_t a) -> wl_buffer*
+    {
+        return reinterpret_cast<wl_buffer*>(wl_proxy_marshal_constructor(
+            manager,
+            wp_single_pixel_buffer_manager_v1_create_u32_rgba_buffer,
+            &wl_buffer_interface,
+            nullptr,
+            r, g, b, a));
+    }
+
+    /// Commits a buffer of the given colour to a new surface, and returns the colour the compositor was given
+    auto committed_color(uint32_t r, uint32_t g, uint32_t b, uint32_t a) -> std::optional<glm::vec4>
+    {
+        auto const surface = wl_compositor_create_surface(client_compositor);
+        wl_surface_attach(surface, create_buffer(r, g, b, a), 0, 0);
+        wl_surface_commit(surface);
+        exchange_messages();
+
+        if (auto const solid_color = std::dynamic_pointer_cast<mg::SolidColorBuffer>(submitted))
+            return solid_color->color();
+        return std::nullopt;
+    }
+
+    static void handle_global(void* data, wl_registry* registry, uint32_t name, char const* interface, uint32_t)
+    {
+        auto const self = static_cast<SinglePixelBufferV1*>(data);
+
+        if (std::strcmp(interface, wl_compositor_interface.name) == 0)
+        {
+            self->client_compositor = static_cast<wl_compositor*>(
+                wl_registry_bind(registry, name, &wl_compositor_interface, 6));
+        }
+        else if (std::strcmp(interface, mw::wp_single_pixel_buffer_manager_v1_interface_data.name) == 0)
+        {
+            self->manager = static_cast<wl_proxy*>(
+                wl_registry_bind(registry, name, &mw::wp_single_pixel_buffer_manager_v1_interface_data, 1));
+        }
+    }
+
+    static void handle_global_remove(void*, wl_registry*, uint32_t) {}
+
+    static wl_registry_listener constexpr registry_listener{&handle_global, &handle_global_remove};
+
+    static wl_callback_listener constexpr callback_listener{
+        [](void* done, wl_callback*, uint32_t) { *static_cast<bool*>(done) = true; }};
+
+    static wl_buffer_listener constexpr buffer_listener{
+        [](void* released, wl_buffer*) { *static_cast<bool*>(released) = true; }};
+
+    std::shared_ptr<NiceMock<mtd::MockBufferStream>> const stream{std::make_shared<NiceMock<mtd::MockBufferStream>>()};
+    std::shared_ptr<NiceMock<mtd::MockSceneSession>> const session{std::make_shared<NiceMock<mtd::MockSceneSession>>()};
+    std::shared_ptr<mtd::ExplicitExecutor> const executor{std::make_shared<mtd::ExplicitExecutor>()};
+    /// Can't import anything, so every buffer that reaches the stream came from the single-pixel buffer path
+    std::shared_ptr<mtd::StubBufferAllocator> const allocator{std::make_shared<mtd::StubBufferAllocator>()};
+
+    wl_display* const server_display{wl_display_create()};
+    std::unique_ptr<TestCompositor> compositor{std::make_unique<TestCompositor>(server_display, executor, allocator)};
+    std::shared_ptr<mw::SinglePixelBufferManagerV1::Global> single_pixel_buffer_manager{
+        mf::create_single_pixel_buffer_manager_v1(server_display)};
+
+    wl_display* client_display{nullptr};
+    wl_compositor* client_compositor{nullptr};
+    wl_proxy* manager{nullptr};
+
+    std::shared_ptr<mg::Buffer> submitted;
+};
+}
+
+TEST_F(SinglePixelBufferV1, the_manager_is_advertised)
+{
+    EXPECT_THAT(client_compositor, NotNull());
+    EXPECT_THAT(manager, NotNull());
+}
+
+TEST_F(SinglePixelBufferV1, a_committed_buffer_is_submitted_as_a_single_solid_color_pixel)
+{
+    EXPECT_CALL(*stream, submit_buffer(_, geom::Size{1, 1}, geom::RectangleD{{0, 0}, {1, 1}}));
+
+    EXPECT_THAT(committed_color(0, 0, 0, max), Optional(_));
+    EXPECT_THAT(submitted->size(), Eq(geom::Size{1, 1}));
+}
+
+TEST_F(SinglePixelBufferV1, full_range_components_are_one)
+{
+    EXPECT_THAT(committed_color(max, max, max, max), Optional(Eq(glm::vec4{1, 1, 1, 1})));
+}
+
+TEST_F(SinglePixelBufferV1, zero_components_are_zero)
+{
+    EXPECT_THAT(committed_color(0, 0, 0, 0), Optional(Eq(glm::vec4{0, 0, 0, 0})));
+}
+
+TEST_F(SinglePixelBufferV1, components_are_scaled_to_the_unit_range)
+{
+    auto const color = committed_color(max / 2, max / 4, 0, max);
+
+    ASSERT_THAT(color, Optional(_));
+    EXPECT_THAT(color->r, FloatNear(0.5f, 1e-6f));
+    EXPECT_THAT(color->g, FloatNear(0.25f, 1e-6f));
+    EXPECT_THAT(color->b, FloatEq(0));
+    EXPECT_THAT(color->a, FloatEq(1));
+}
+
+TEST_F(SinglePixelBufferV1, translucent_colors_are_passed_on_premultiplied_as_given)
+{
+    auto const color = committed_color(max / 4, 0, max / 4, max / 2);
+
+    ASSERT_THAT(color, Optional(_));
+    EXPECT_THAT(color->r, FloatNear(0.25f, 1e-6f));
+    EXPECT_THAT(color->g, FloatEq(0));
+    EXPECT_THAT(color->b, FloatNear(0.25f, 1e-6f));
+    EXPECT_THAT(color->a, FloatNear(0.5f, 1e-6f));
+}
+
+TEST_F(SinglePixelBufferV1, a_buffer_is_released_once_another_replaces_it)
+{
+    auto const surface = wl_compositor_create_surface(client_compositor);
+    auto const first = create_buffer(max, 0, 0, max);
+    bool released{false};
+    wl_buffer_add_listener(first, &buffer_listener, &released);
+
+    wl_surface_attach(surface, first, 0, 0);
+    wl_surface_commit(surface);
+    exchange_messages();
+    EXPECT_FALSE(released);
+
+    wl_surface_attach(surface, create_buffer(0, max, 0, max), 0, 0);
+    wl_surface_commit(surface);
+    exchange_messages();
+    EXPECT_TRUE(released);
+}
+
+TEST_F(SinglePixelBufferV1, frame_callbacks_are_done_once_the_buffer_is_drawn)
+{
+    auto const surface = wl_compositor_create_surface(client_compositor);
+    bool done{false};
+    wl_callback_add_listener(wl_surface_frame(surface), &callback_listener, &done);
+
+    wl_surface_attach(surface, create_buffer(0, 0, max, max), 0, 0);
+    wl_surface_commit(surface);
+    exchange_messages();
+    ASSERT_THAT(submitted, NotNull());
+    EXPECT_FALSE(done);
+
+    submitted->map_readable();
+    exchange_messages();
+    EXPECT_TRUE(done);
+}
+
+TEST_F(SinglePixelBufferV1, buffers_outlive_the_manager_that_created_them)
+{
+    auto const surface = wl_compositor_create_surface(client_compositor);
+    auto const buffer = create_buffer(max, max, max, max);
+    wl_proxy_marshal(manager, wp_single_pixel_buffer_manager_v1_destroy);
+    wl_proxy_destroy(manager);
+    manager = nullptr;
+
+    wl_surface_attach(surface, buffer, 0, 0);
+    wl_surface_commit(surface);
+    exchange_messages();
+
+    EXPECT_THAT(wl_display_get_error(client_display), Eq(0));
+    EXPECT_THAT(std::dynamic_pointer_cast<mg::SolidColorBuffer>(submitted), NotNull());
+}
+
+TEST_F(SinglePixelBufferV1, attaching_a_buffer_at_an_offset_is_a_protocol_error)
+{
+    auto const surface = wl_compositor_create_surface(client_compositor);
+
+    wl_surface_attach(surface, create_buffer(max, max, max, max), 1, 1);
+    wl_surface_commit(surface);
+    exchange_messages();
+
+    wl_interface const* interface{nullptr};
+    EXPECT_THAT(wl_display_get_protocol_error(client_display, &interface, nullptr), Eq(WL_SURFACE_ERROR_INVALID_OFFSET));
+    ASSERT_THAT(interface, NotNull());
+    EXPECT_THAT(interface->name, StrEq("wl_surface"));
+}
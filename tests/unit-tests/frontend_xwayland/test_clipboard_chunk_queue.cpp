@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_xwayland/clipboard_chunk_queue.h"
+#include <mir/fd.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <numeric>
+#include <system_error>
+
+namespace mf = mir::frontend;
+
+using namespace testing;
+
+namespace
+{
+struct ClipboardChunkQueueTest : Test
+{
+    ClipboardChunkQueueTest()
+    {
+        int fds[2];
+        if (pipe2(fds, O_CLOEXEC | O_NONBLOCK) != 0)
+        {
+            throw std::system_error{errno, std::system_category(), "Failed to create pipe"};
+        }
+        read_end = mir::Fd{fds[0]};
+        write_end = mir::Fd{fds[1]};
+    }
+
+    auto read_all() -> std::vector<uint8_t>
+    {
+        std::vector<uint8_t> result;
+        uint8_t buffer[4096];
+        ssize_t len;
+        while ((len = read(read_end, buffer, sizeof(buffer))) > 0)
+        {
+            result.insert(result.end(), buffer, buffer + len);
+        }
+        return result;
+    }
+
+    static auto sequence(size_t size, uint8_t start) -> std::vector<uint8_t>
+    {
+        std::vector<uint8_t> result(size);
+        std::iota(result.begin(), result.end(), start);
+        return result;
+    }
+
+    mir::Fd read_end;
+    mir::Fd write_end;
+    mf::ClipboardChunkQueue queue;
+};
+}
+
+TEST_F(ClipboardChunkQueueTest, is_initially_empty)
+{
+    EXPECT_TRUE(queue.empty());
+    EXPECT_THAT(queue.pending_bytes(), Eq(0u));
+    EXPECT_THAT(queue.write_to(write_end), Eq(0));
+}
+
+TEST_F(ClipboardChunkQueueTest, writes_chunks_in_order)
+{
+    auto const first = sequence(100, 0);
+    auto const second = sequence(50, 100);
+    queue.push(std::vector<uint8_t>(first));
+    queue.push(std::vector<uint8_t>(second));
+    EXPECT_THAT(queue.pending_bytes(), Eq(150u));
+
+    EXPECT_THAT(queue.write_to(write_end), Eq(150));
+
+    auto expected = first;
+    expected.insert(expected.end(), second.begin(), second.end());
+    EXPECT_THAT(read_all(), Eq(expected));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(ClipboardChunkQueueTest, resumes_a_partial_write_where_it_left_off)
+{
+    auto const pipe_size = fcntl(write_end, F_SETPIPE_SZ, 4096);
+    ASSERT_THAT(pipe_size, Gt(0));
+
+    std::vector<uint8_t> expected;
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto chunk = sequence(pipe_size * 3 / 4, static_cast<uint8_t>(i * 7));
+        expected.insert(expected.end(), chunk.begin(), chunk.end());
+        queue.push(std::move(chunk));
+    }
+
+    std::vector<uint8_t> received;
+    while (!queue.empty())
+    {
+        ASSERT_THAT(queue.write_to(write_end), Gt(0));
+        auto const more = read_all();
+        received.insert(received.end(), more.begin(), more.end());
+    }
+
+    EXPECT_THAT(received, Eq(expected));
+}
+
+TEST_F(ClipboardChunkQueueTest, ignores_empty_chunks)
+{
+    queue.push({});
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_xwayland/xcb_connection.h"
+#include "src/server/frontend_xwayland/xcb_event_batch.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mf = mir::frontend;
+
+using namespace testing;
+
+namespace
+{
+/// Stands in for an XWaylandSurface that property replies are applied to
+struct Surface
+{
+    std::vector<std::string> applied;
+    std::vector<std::string> errors;
+
+    auto handler() -> mf::XCBConnection::Handler<std::string>
+    {
+        return {
+            [this](std::string const& value) { applied.push_back(value); },
+            [this](std::string const& message) { errors.push_back(message); }};
+    }
+};
+
+template<typename Event>
+auto make_event(uint8_t response_type, xcb_window_t window) -> mir::UniqueCPtr<xcb_generic_event_t>
+{
+    // Events are freed with free(), as xcb_poll_for_event()'s are
+    auto const event = static_cast<Event*>(std::calloc(1, sizeof(xcb_generic_event_t)));
+    event->response_type = response_type;
+    event->window = window;
+    return mir::UniqueCPtr<xcb_generic_event_t>{reinterpret_cast<xcb_generic_event_t*>(event)};
+}
+
+auto destroy_notify(xcb_window_t window)
+{
+    return make_event<xcb_destroy_notify_event_t>(XCB_DESTROY_NOTIFY, window);
+}
+
+auto property_notify(xcb_window_t window)
+{
+    return make_event<xcb_property_notify_event_t>(XCB_PROPERTY_NOTIFY, window);
+}
+
+struct Window
+{
+};
+
+/// Tracks windows as XWaylandWM does, handing each batch to handle_event_batch()
+struct WindowManager
+{
+    void handle(std::vector<mir::UniqueCPtr<xcb_generic_event_t>> const& events)
+    {
+        mf::handle_event_batch(
+            events,
+            [this](xcb_generic_event_t* event) -> std::function<void()>
+            {
+                log.push_back("prefetch");
+                if ((event->response_type & ~0x80) != XCB_PROPERTY_NOTIFY)
+                {
+                    return {};
+                }
+
+                auto const found = windows.find(reinterpret_cast<xcb_property_notify_event_t*>(event)->window);
+                if (found == windows.end())
+                {
+                    return {};
+                }
+                std::weak_ptr<Window> const window = found->second;
+
+                // As XWaylandSurface does, the handler is bound to the window's lifetime rather than the window
+                mf::XCBConnection::Handler<std::string> const handler{
+                    [this](std::string const& value) { applied.push_back(value); },
+                    [this](std::string const& message) { applied.push_back(message); }};
+
+                // Stands in for the reply to a property read requested now, and collected when the event is handled
+                return [this, handler = handler.while_alive(window)]()
+                    {
+                        replies_collected++;
+                        handler.on_success("WM_NAME");
+                    };
+            },
+            [this]() { log.push_back("flush"); },
+            [this](xcb_generic_event_t* event, std::function<void()> const& prefetched)
+            {
+                log.push_back("handle");
+                if ((event->response_type & ~0x80) == XCB_DESTROY_NOTIFY)
+                {
+                    windows.erase(reinterpret_cast<xcb_destroy_notify_event_t*>(event)->window);
+                }
+                else if (prefetched)
+                {
+                    prefetched();
+                }
+            });
+    }
+
+    std::map<xcb_window_t, std::shared_ptr<Window>> windows;
+    std::vector<std::string> log;
+    std::vector<std::string> applied;
+    int replies_collected{0};
+};
+}
+
+TEST(XCBConnectionHandler, while_alive_handler_applies_replies_to_a_live_owner)
+{
+    auto const surface = std::make_shared<Surface>();
+    auto const handler = surface->handler().while_alive(surface);
+
+    handler.on_success("WM_NAME");
+    handler.on_error("BadWindow");
+
+    EXPECT_THAT(surface->applied, ElementsAre("WM_NAME"));
+    EXPECT_THAT(surface->errors, ElementsAre("BadWindow"));
+}
+
+TEST(XCBEventBatch, every_event_is_prefetched_and_the_requests_flushed_before_any_is_handled)
+{
+    WindowManager wm;
+    std::vector<mir::UniqueCPtr<xcb_generic_event_t>> events;
+    events.push_back(property_notify(1));
+    events.push_back(destroy_notify(1));
+
+    wm.handle(events);
+
+    EXPECT_THAT(wm.log, ElementsAre("prefetch", "prefetch", "flush", "handle", "handle"));
+}
+
+TEST(XCBEventBatch, reply_prefetched_for_a_window_destroyed_earlier_in_the_batch_is_collected_but_not_applied)
+{
+    WindowManager wm;
+    wm.windows[1] = std::make_shared<Window>();
+
+    std::vector<mir::UniqueCPtr<xcb_generic_event_t>> events;
+    events.push_back(property_notify(1));
+    events.push_back(destroy_notify(1));
+    events.push_back(property_notify(1));
+
+    wm.handle(events);
+
+    EXPECT_THAT(wm.replies_collected, Eq(2));
+    EXPECT_THAT(wm.applied, ElementsAre("WM_NAME"));
+}
+
+TEST(XCBEventBatch, an_error_handling_one_event_does_not_stop_the_rest_of_the_batch)
+{
+    std::vector<mir::UniqueCPtr<xcb_generic_event_t>> events;
+    events.push_back(property_notify(1));
+    events.push_back(property_notify(2));
+    std::vector<xcb_window_t> handled;
+
+    mf::handle_event_batch(
+        events,
+        [](xcb_generic_event_t*) -> std::function<void()> { throw std::runtime_error{"Prefetch failed"}; },
+        []() {},
+        [&handled](xcb_generic_event_t* event, std::function<void()> const&)
+        {
+            auto const window = reinterpret_cast<xcb_property_notify_event_t*>(event)->window;
+            handled.push_back(window);
+            if (window == 1)
+            {
+                throw std::runtime_error{"Handling failed"};
+            }
+        });
+
+    EXPECT_THAT(handled, ElementsAre(1u, 2u));
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_xwayland/xwayland_log.h"
+#include <mir_test_framework/temporary_environment_value.h>
+
+#include <gtest/gtest.h>
+
+namespace ml = mir::logging;
+namespace mtf = mir_test_framework;
+
+namespace
+{
+struct XWaylandLog : testing::Test
+{
+    XWaylandLog()
+    {
+        reset_log_levels();
+    }
+
+    ~XWaylandLog()
+    {
+        reset_log_levels();
+    }
+
+    /// Restores the default severities, as applying a live log_level configuration does first
+    static void reset_log_levels()
+    {
+        ml::tag::set_severity("base", ml::Severity::warning);
+    }
+};
+}
+
+TEST_F(XWaylandLog, verbose_logging_is_disabled_by_default)
+{
+    mtf::TemporaryEnvironmentValue const verbose_log{"MIR_X11_VERBOSE_LOG", nullptr};
+
+    EXPECT_FALSE(mir::verbose_xwayland_logging_enabled());
+}
+
+TEST_F(XWaylandLog, verbose_logging_follows_the_xwayland_tag)
+{
+    mtf::TemporaryEnvironmentValue const verbose_log{"MIR_X11_VERBOSE_LOG", nullptr};
+
+    ml::tag::set_severity("base/wayland/xwayland", ml::Severity::debug);
+    EXPECT_TRUE(mir::verbose_xwayland_logging_enabled());
+
+    ml::tag::set_severity("base/wayland/xwayland", ml::Severity::warning);
+    EXPECT_FALSE(mir::verbose_xwayland_logging_enabled());
+}
+
+TEST_F(XWaylandLog, verbose_logging_requested_by_the_environment_survives_resetting_log_levels)
+{
+    mtf::TemporaryEnvironmentValue const verbose_log{"MIR_X11_VERBOSE_LOG", "1"};
+
+    reset_log_levels();
+
+    EXPECT_TRUE(mir::verbose_xwayland_logging_enabled());
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_xwayland/xwayland_surface_role.h"
+#include "src/server/frontend_xwayland/xwayland_surface_role_surface.h"
+#include "src/server/frontend_wayland/wl_surface.h"
+#include "src/server/frontend_wayland/resource_lifetime_tracker.h"
+
+#include <mir/fd.h>
+#include <mir/shell/surface_specification.h>
+#include <mir/wayland/client.h>
+#include <mir/wayland/weak.h>
+#include <mir/test/doubles/explicit_executor.h>
+#include <mir/test/doubles/mock_buffer_stream.h>
+#include <mir/test/doubles/mock_scene_session.h>
+#include <mir/test/doubles/stub_buffer.h>
+#include <mir/test/doubles/stub_buffer_allocator.h>
+#include <mir/test/doubles/stub_shell.h>
+
+#include <boost/throw_exception.hpp>
+#include <wayland-server-core.h>
+#include <sys/socket.h>
+
+#include <system_error>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace ms = mir::scene;
+namespace msh = mir::shell;
+namespace mw = mir::wayland;
+namespace geom = mir::geometry;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+
+namespace mir::wayland
+{
+extern struct wl_interface const wl_surface_interface_data;
+extern struct wl_interface const wl_buffer_interface_data;
+}
+
+namespace
+{
+/// Stands in for the WlClient the Wayland connector would create for Xwayland's connection
+class StubWaylandClient : public mw::Client
+{
+public:
+    static auto register_for(wl_client* raw, std::shared_ptr<ms::Session> const& session)
+        -> std::shared_ptr<StubWaylandClient>
+    {
+        auto const client = std::make_shared<StubWaylandClient>(raw, session);
+        register_client(raw, client);
+        return client;
+    }
+
+    StubWaylandClient(wl_client* raw, std::shared_ptr<ms::Session> const& session)
+        : raw{raw},
+          session{session}
+    {
+    }
+
+    ~StubWaylandClient()
+    {
+        unregister_client(raw);
+    }
+
+    auto raw_client() const -> wl_client* override { return raw; }
+    auto is_being_destroyed() const -> bool override { return false; }
+    auto client_session() const -> std::shared_ptr<ms::Session> override { return session; }
+    auto next_serial(std::shared_ptr<MirEvent const>) -> uint32_t override { return 0; }
+    auto event_for(uint32_t) -> std::optional<std::shared_ptr<MirEvent const>> override { return std::nullopt; }
+    void set_output_geometry_scale(float) override {}
+    auto output_geometry_scale() -> float override { return 1; }
+
+private:
+    wl_client* const raw;
+    std::shared_ptr<ms::Session> const session;
+};
+
+/// Imports every Wayland buffer as a buffer of the size the test last asked for
+class SizedBufferAllocator : public mtd::StubBufferAllocator
+{
+public:
+    auto buffer_from_resource(wl_resource*, std::function<void()>&&, std::function<void()>&&)
+        -> std::shared_ptr<mg::Buffer> override
+    {
+        return std::make_shared<mtd::StubBuffer>(size);
+    }
+
+    geom::Size size;
+};
+
+struct MockXWaylandSurfaceRoleSurface : mf::XWaylandSurfaceRoleSurface
+{
+    MOCK_METHOD(void, wl_surface_destroyed, (), (override));
+    MOCK_METHOD(std::optional<std::shared_ptr<ms::Surface>>, scene_surface, (), (const, override));
+    MOCK_METHOD(void, attach_wl_surface, (mf::WlSurface*), (override));
+};
+
+struct XWaylandSurfaceRoleTest : Test
+{
+    XWaylandSurfaceRoleTest()
+    {
+        ON_CALL(*session, create_buffer_stream(_))
+            .WillByDefault(Return(stream));
+
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+        {
+            BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create socket pair"}));
+        }
+        client_end = mir::Fd{fds[1]};
+        client = wl_client_create(display, fds[0]);
+        wayland_client = StubWaylandClient::register_for(client, session);
+    }
+
+    ~XWaylandSurfaceRoleTest()
+    {
+        // Destroys the wl_surfaces, and with them their roles
+        wl_client_destroy(client);
+        wl_display_destroy(display);
+    }
+
+    /// A wl_surface as Xwayland creates it, before the window manager knows which window it belongs to
+    auto create_wl_surface() -> mf::WlSurface*
+    {
+        return new mf::WlSurface{
+            wl_resource_create(client, &mw::wl_surface_interface_data, 6, 0),
+            executor,
+            executor,
+            allocator};
+    }
+
+    /// Commits a new buffer of the given size without going through any role, as the role itself does
+    void commit_buffer(mf::WlSurface* wl_surface, geom::Size size)
+    {
+        allocator->size = size;
+        mf::WlSurfaceState state;
+        state.buffer = mw::make_weak(
+            mf::ResourceLifetimeTracker::from(wl_resource_create(client, &mw::wl_buffer_interface_data, 1, 0)));
+        wl_surface->commit(state);
+    }
+
+    float const scale{2};
+
+    std::shared_ptr<NiceMock<mtd::MockBufferStream>> const stream{std::make_shared<NiceMock<mtd::MockBufferStream>>()};
+    std::shared_ptr<NiceMock<mtd::MockSceneSession>> const session{std::make_shared<NiceMock<mtd::MockSceneSession>>()};
+    std::shared_ptr<mtd::ExplicitExecutor> const executor{std::make_shared<mtd::ExplicitExecutor>()};
+    std::shared_ptr<SizedBufferAllocator> const allocator{std::make_shared<SizedBufferAllocator>()};
+    std::shared_ptr<msh::Shell> const shell{std::make_shared<mtd::StubShell>()};
+    std::shared_ptr<NiceMock<MockXWaylandSurfaceRoleSurface>> const wm_surface{
+        std::make_shared<NiceMock<MockXWaylandSurfaceRoleSurface>>()};
+
+    wl_display* const display{wl_display_create()};
+    mir::Fd client_end;
+    wl_client* client{nullptr};
+    std::shared_ptr<StubWaylandClient> wayland_client;
+};
+}
+
+TEST_F(XWaylandSurfaceRoleTest, attaching_resubmits_a_buffer_committed_before_the_role_at_the_xwayland_scale)
+{
+    auto const wl_surface = create_wl_surface();
+    // Xwayland can commit its first buffer before the window manager learns which window the surface is for
+    commit_buffer(wl_surface, {200, 100});
+
+    InSequence seq;
+    EXPECT_CALL(*stream, submit_buffer(_, geom::Size{100, 50}, geom::RectangleD{{0, 0}, {200, 100}}));
+    EXPECT_CALL(*wm_surface, attach_wl_surface(wl_surface));
+
+    mf::XWaylandSurfaceRole::attach(shell, wm_surface, wl_surface, scale);
+}
+
+TEST_F(XWaylandSurfaceRoleTest, the_window_is_attached_to_a_surface_sized_in_logical_coordinates)
+{
+    auto const wl_surface = create_wl_surface();
+    commit_buffer(wl_surface, {200, 100});
+
+    std::vector<geom::Rectangle> input_shape_when_attached;
+    EXPECT_CALL(*wm_surface, attach_wl_surface(wl_surface))
+        .WillOnce([&](mf::WlSurface* attached)
+            {
+                msh::SurfaceSpecification spec;
+                mf::XWaylandSurfaceRole::populate_surface_data(attached, spec);
+                input_shape_when_attached = spec.input_shape.value();
+            });
+
+    mf::XWaylandSurfaceRole::attach(shell, wm_surface, wl_surface, scale);
+
+    EXPECT_THAT(input_shape_when_attached, ElementsAre(geom::Rectangle{{0, 0}, {100, 50}}));
+}
+
+TEST_F(XWaylandSurfaceRoleTest, buffers_committed_once_attached_are_sized_at_the_xwayland_scale)
+{
+    auto const wl_surface = create_wl_surface();
+    mf::XWaylandSurfaceRole::attach(shell, wm_surface, wl_surface, scale);
+
+    EXPECT_CALL(*stream, submit_buffer(_, geom::Size{150, 75}, geom::RectangleD{{0, 0}, {300, 150}}));
+
+    commit_buffer(wl_surface, {300, 150});
+}
+
+TEST_F(XWaylandSurfaceRoleTest, buffers_are_not_resized_at_unit_scale)
+{
+    auto const wl_surface = create_wl_surface();
+    mf::XWaylandSurfaceRole::attach(shell, wm_surface, wl_surface, 1);
+
+    EXPECT_CALL(*stream, submit_buffer(_, geom::Size{300, 150}, geom::RectangleD{{0, 0}, {300, 150}}));
+
+    commit_buffer(wl_surface, {300, 150});
+}
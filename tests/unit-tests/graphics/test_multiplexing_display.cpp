@@ -28,6 +28,7 @@
 #include <mir/test/doubles/null_gl_context.h>
 #include <mir/test/doubles/stub_display_configuration.h>
 #include <mir/test/doubles/null_display_configuration_policy.h>
+#include <mir/test/doubles/null_display_sync_group.h>
 
 #include <mir_toolkit/common.h>
 #include "src/server/graphics/multiplexing_display.h"
@@ -113,6 +114,15 @@ MATCHER_P(OutputConfigurationEqualIgnoringId, output, "")
         result_listener);
 }
 
+struct MockIncrementalDisplay : mtd::MockDisplay
+{
+    MOCK_METHOD(
+        void,
+        configure_incrementally,
+        (mg::DisplayConfiguration const&, std::function<void(mg::DisplaySyncGroup&)> const&),
+        (override));
+};
+
 // Make a MockDisplay that returns safe stubs
 auto make_safe_mock_display() -> std::unique_ptr<mtd::MockDisplay>
 {
@@ -332,6 +342,61 @@ MATCHER_P(IsConfigurationOfCard, cardid, "")
     return matches;
 }
 
+TEST(MultiplexingDisplay, dispatches_incremental_configuration_to_associated_platform)
+{
+    DisplayConfigurationOutputGenerator gen;
+    constexpr const mg::DisplayConfigurationCardId card1{5}, card2{42};
+
+    auto d1 = std::make_unique<NiceMock<MockIncrementalDisplay>>();
+    auto d2 = std::make_unique<NiceMock<MockIncrementalDisplay>>();
+
+    auto const d1_conf = std::make_unique<mtd::StubDisplayConfig>(
+        std::vector<mg::DisplayConfigurationOutput>{
+            gen.generate_output(card1),
+            gen.generate_output(card1)
+        });
+    ON_CALL(*d1, configuration())
+        .WillByDefault([&d1_conf]() { return d1_conf->clone(); });
+    auto const d2_conf = std::make_unique<mtd::StubDisplayConfig>(
+        std::vector<mg::DisplayConfigurationOutput>{
+            gen.generate_output(card2)
+        });
+    ON_CALL(*d2, configuration())
+        .WillByDefault([&d2_conf]() { return d2_conf->clone(); });
+
+    mtd::NullDisplaySyncGroup d1_group, d2_group;
+
+    // Each Display should get a configure_incrementally() call with only its own configuration,
+    // and report the groups it removes through the caller's functor
+    EXPECT_CALL(*d1, configure_incrementally(IsConfigurationOfCard(card1), _))
+        .WillOnce(
+            [&d1_group](auto const&, auto const& removing)
+            {
+                removing(d1_group);
+            });
+    EXPECT_CALL(*d2, configure_incrementally(IsConfigurationOfCard(card2), _))
+        .WillOnce(
+            [&d2_group](auto const&, auto const& removing)
+            {
+                removing(d2_group);
+            });
+    EXPECT_CALL(*d1, configure(_)).Times(0);
+    EXPECT_CALL(*d2, configure(_)).Times(0);
+
+    std::vector<std::unique_ptr<mg::Display>> displays;
+    displays.push_back(std::move(d1));
+    displays.push_back(std::move(d2));
+
+    mtd::NullDisplayConfigurationPolicy policy;
+    mg::MultiplexingDisplay display{std::move(displays), policy};
+    auto conf = display.configuration();
+
+    std::vector<mg::DisplaySyncGroup*> removed;
+    display.configure_incrementally(*conf, [&removed](mg::DisplaySyncGroup& group) { removed.push_back(&group); });
+
+    EXPECT_THAT(removed, ElementsAre(&d1_group, &d2_group));
+}
+
 TEST(MultiplexingDisplay, apply_if_confguration_preserves_display_buffers_succeeds_if_all_succeed)
 {
     DisplayConfigurationOutputGenerator gen;
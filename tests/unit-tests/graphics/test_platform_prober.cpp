@@ -20,8 +20,10 @@
 #include <gmock/gmock.h>
 #include <fcntl.h>
 #include <boost/throw_exception.hpp>
+#include <filesystem>
 #include <ranges>
 #include <string>
+#include <system_error>
 
 #include <mir/console_services.h>
 #include <mir/graphics/platform.h>
@@ -41,6 +43,7 @@
 #include <mir/test/doubles/stub_console_services.h>
 #include <mir_test_framework/temporary_environment_value.h>
 #include "src/server/graphics/platform_probe.h"
+#include "src/server/graphics/platform_probe_cache.h"
 #include "mir/logging/null_shared_library_prober_report.h"
 #include <mir/options/program_option.h>
 #include <mir/udev/wrapper.h>
@@ -643,6 +646,11 @@ public:
         temporary_env.emplace_back(std::make_unique<mtf::TemporaryEnvironmentValue>("MIR_SERVER_PLATFORM_DISPLAY_LIBS", value));
     }
 
+    void set_probe_cache_option(std::filesystem::path const& cache_file)
+    {
+        temporary_env.emplace_back(std::make_unique<mtf::TemporaryEnvironmentValue>("MIR_SERVER_PLATFORM_PROBE_CACHE", cache_file.c_str()));
+    }
+
     void add_virtual_option()
     {
         temporary_env.emplace_back(std::make_unique<mtf::TemporaryEnvironmentValue>("MIR_SERVER_VIRTUAL_OUTPUT", "1280x1024"));
@@ -1166,6 +1174,133 @@ TEST_F(FullProbeStack, gbm_kms_is_not_selected_for_nvidia_driver_when_quirk_is_a
     EXPECT_THAT(devices, Each(Not(GbmForNvidia)));
 }
 
+namespace
+{
+/// A directory that is removed, along with its contents, at the end of the test
+class TemporaryDirectory
+{
+public:
+    TemporaryDirectory()
+        : path{create()}
+    {
+    }
+
+    ~TemporaryDirectory()
+    {
+        std::error_code ignored;
+        std::filesystem::remove_all(path, ignored);
+    }
+
+    std::filesystem::path const path;
+
+private:
+    static auto create() -> std::filesystem::path
+    {
+        auto name = (std::filesystem::temp_directory_path() / "mir-probe-cache-XXXXXX").string();
+        if (mkdtemp(name.data()) == nullptr)
+        {
+            BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create temporary directory"}));
+        }
+        return name;
+    }
+};
+}
+
+TEST(PlatformProbeCache, remembers_modules_for_the_same_fingerprint)
+{
+    using namespace testing;
+    TemporaryDirectory dir;
+    auto const cache_file = dir.path / "cache";
+
+    mg::save_probe_cache(cache_file, "fingerprint", {"/platforms/a.so", "/platforms/b.so"});
+
+    EXPECT_THAT(mg::load_probe_cache(cache_file, "fingerprint"), Optional(ElementsAre("/platforms/a.so", "/platforms/b.so")));
+}
+
+TEST(PlatformProbeCache, forgets_modules_for_a_different_fingerprint)
+{
+    using namespace testing;
+    TemporaryDirectory dir;
+    auto const cache_file = dir.path / "cache";
+
+    mg::save_probe_cache(cache_file, "fingerprint", {"/platforms/a.so"});
+
+    EXPECT_THAT(mg::load_probe_cache(cache_file, "another fingerprint"), Eq(std::nullopt));
+}
+
+TEST(PlatformProbeCache, missing_cache_is_empty)
+{
+    using namespace testing;
+    TemporaryDirectory dir;
+
+    EXPECT_THAT(mg::load_probe_cache(dir.path / "cache", "fingerprint"), Eq(std::nullopt));
+}
+
+TEST_F(FullProbeStack, probe_fingerprint_changes_when_a_device_is_added)
+{
+    using namespace testing;
+
+    auto const platform_path = the_options().get<std::string>(mo::platform_path);
+    auto const before = mg::probe_fingerprint(platform_path, std::make_shared<mir::udev::Context>());
+
+    if (!add_kms_device())
+    {
+        GTEST_SKIP() << "No KMS platform built";
+    }
+
+    EXPECT_THAT(mg::probe_fingerprint(platform_path, std::make_shared<mir::udev::Context>()), Ne(before));
+}
+
+TEST_F(FullProbeStack, select_display_modules_with_probe_cache_selects_the_same_modules_again)
+{
+    using namespace testing;
+
+    auto const device = add_kms_device();
+    if (!device)
+    {
+        GTEST_SKIP() << "No KMS platform built";
+    }
+    enable_gbm_on_kms_device(*device);
+
+    TemporaryDirectory dir;
+    set_probe_cache_option(dir.path / "cache");
+
+    auto const cold = mg::select_display_modules(the_options_provider(), the_console_services(), *the_library_prober_report());
+    ASSERT_TRUE(std::filesystem::exists(dir.path / "cache"));
+    ASSERT_THAT(cold, SizeIs(1));
+
+    auto const cold_module = cold.front().second->load_function<mg::DescribeModule>("describe_graphics_module")()->name;
+    auto const warm = mg::select_display_modules(the_options_provider(), the_console_services(), *the_library_prober_report());
+
+    EXPECT_THAT(warm, ElementsAre(Pair(IsPlatformForDevice(device.get()), ModuleNameMatches(StrEq(cold_module)))));
+}
+
+TEST_F(FullProbeStack, select_display_modules_probes_everything_when_the_cached_modules_are_unusable)
+{
+    using namespace testing;
+
+    auto const device = add_kms_device();
+    if (!device)
+    {
+        GTEST_SKIP() << "No KMS platform built";
+    }
+    enable_gbm_on_kms_device(*device);
+
+    TemporaryDirectory dir;
+    auto const cache_file = dir.path / "cache";
+    set_probe_cache_option(cache_file);
+
+    auto const fingerprint = mg::probe_fingerprint(
+        the_options().get<std::string>(mo::platform_path),
+        std::make_shared<mir::udev::Context>());
+    mg::save_probe_cache(cache_file, fingerprint, {"/no/such/platform.so"});
+
+    auto const devices = mg::select_display_modules(the_options_provider(), the_console_services(), *the_library_prober_report());
+
+    EXPECT_THAT(devices, Contains(Pair(IsPlatformForDevice(device.get()), _)));
+    EXPECT_THAT(mg::load_probe_cache(cache_file, fingerprint), Optional(Not(Contains("/no/such/platform.so"))));
+}
+
 namespace
 {
 class MockRenderingPlatform : public mtd::NullRenderingPlatform
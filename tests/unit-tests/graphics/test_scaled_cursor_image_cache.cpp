@@ -0,0 +1,89 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mir/graphics/scaled_cursor_image_cache.h>
+#include <mir/graphics/cursor_image.h>
+#include <mir/graphics/shm_buffer.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+using namespace testing;
+
+namespace
+{
+struct StubCursorImage : mg::CursorImage
+{
+    void const* as_argb_8888() const override { return pixels.data(); }
+    geom::Size size() const override { return {4, 4}; }
+    geom::Displacement hotspot() const override { return {0, 0}; }
+
+    std::array<uint32_t, 16> pixels{};
+};
+}
+
+TEST(ScaledCursorImageCache, reuses_the_buffer_for_an_image_shown_again)
+{
+    mg::ScaledCursorImageCache cache;
+    auto const arrow = std::make_shared<StubCursorImage>();
+    auto const hand = std::make_shared<StubCursorImage>();
+
+    auto const first = cache.buffer_for(arrow, 1.0f);
+    cache.buffer_for(hand, 1.0f);
+
+    EXPECT_THAT(cache.buffer_for(arrow, 1.0f), Eq(first));
+}
+
+TEST(ScaledCursorImageCache, scales_the_image)
+{
+    mg::ScaledCursorImageCache cache;
+    auto const arrow = std::make_shared<StubCursorImage>();
+
+    EXPECT_THAT(cache.buffer_for(arrow, 2.0f)->size(), Eq(geom::Size{8, 8}));
+    EXPECT_THAT(cache.buffer_for(arrow, 1.0f)->size(), Eq(geom::Size{4, 4}));
+}
+
+TEST(ScaledCursorImageCache, evicts_the_least_recently_used_image)
+{
+    mg::ScaledCursorImageCache cache{2};
+    auto const arrow = std::make_shared<StubCursorImage>();
+    auto const hand = std::make_shared<StubCursorImage>();
+    auto const text = std::make_shared<StubCursorImage>();
+
+    auto const arrow_buffer = cache.buffer_for(arrow, 1.0f);
+    auto const hand_buffer = cache.buffer_for(hand, 1.0f);
+    cache.buffer_for(arrow, 1.0f);
+    cache.buffer_for(text, 1.0f);
+
+    EXPECT_THAT(cache.buffer_for(arrow, 1.0f), Eq(arrow_buffer));
+    EXPECT_THAT(cache.buffer_for(hand, 1.0f), Ne(hand_buffer));
+}
+
+TEST(ScaledCursorImageCache, does_not_keep_images_alive)
+{
+    mg::ScaledCursorImageCache cache;
+    auto arrow = std::make_shared<StubCursorImage>();
+    std::weak_ptr<StubCursorImage> const weak_arrow = arrow;
+
+    cache.buffer_for(arrow, 1.0f);
+    arrow.reset();
+
+    EXPECT_TRUE(weak_arrow.expired());
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mir/graphics/solid_color_buffer.h>
+#include <mir/graphics/program.h>
+#include <mir/graphics/program_factory.h>
+#include <mir/renderer/sw/pixel_source.h>
+
+#include <mir/test/doubles/mock_gl.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+namespace mg = mir::graphics;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+using namespace testing;
+
+namespace
+{
+struct MockProgramFactory : mg::gl::ProgramFactory
+{
+    MOCK_METHOD(mg::gl::Program&, compile_fragment_shader, (void const*, char const*, char const*), (override));
+};
+
+struct StubProgram : mg::gl::Program
+{
+};
+}
+
+TEST(SolidColorBuffer, is_a_single_pixel)
+{
+    mg::SolidColorBuffer const buffer{{0.5f, 0.25f, 0.0f, 1.0f}};
+
+    EXPECT_THAT(buffer.size(), Eq(geom::Size{1, 1}));
+}
+
+TEST(SolidColorBuffer, has_alpha_only_if_translucent)
+{
+    EXPECT_THAT(mg::SolidColorBuffer{{1.0f, 1.0f, 1.0f, 1.0f}}.pixel_format(), Eq(mir_pixel_format_xrgb_8888));
+    EXPECT_THAT(mg::SolidColorBuffer{{0.5f, 0.5f, 0.5f, 0.5f}}.pixel_format(), Eq(mir_pixel_format_argb_8888));
+}
+
+TEST(SolidColorBuffer, maps_to_its_color)
+{
+    mg::SolidColorBuffer const buffer{{1.0f, 0.5f, 0.0f, 1.0f}};
+
+    auto const mapping = buffer.map_readable();
+
+    ASSERT_THAT(mapping->len(), Eq(sizeof(uint32_t)));
+    EXPECT_THAT(mapping->format(), Eq(mir_pixel_format_argb_8888));
+    uint32_t pixel;
+    std::memcpy(&pixel, mapping->data(), sizeof(pixel));
+    EXPECT_THAT(pixel, Eq(0xFFFF8000u));
+}
+
+TEST(SolidColorBuffer, is_its_own_texture)
+{
+    mg::SolidColorBuffer buffer{{1.0f, 0.5f, 0.0f, 1.0f}};
+
+    EXPECT_THAT(dynamic_cast<mg::gl::Texture*>(buffer.native_buffer_base()), Eq(&buffer));
+}
+
+TEST(SolidColorBuffer, all_colors_share_a_shader)
+{
+    mg::SolidColorBuffer const red{{1.0f, 0.0f, 0.0f, 1.0f}};
+    mg::SolidColorBuffer const blue{{0.0f, 0.0f, 1.0f, 1.0f}};
+    MockProgramFactory factory;
+    StubProgram program;
+    void const* id{nullptr};
+
+    EXPECT_CALL(factory, compile_fragment_shader(_, _, HasSubstr("sample_to_rgba")))
+        .Times(2)
+        .WillRepeatedly(DoAll(SaveArg<0>(&id), ReturnRef(program)));
+    red.shader(factory);
+    auto const red_id = id;
+    blue.shader(factory);
+
+    EXPECT_THAT(id, Eq(red_id));
+}
+
+TEST(SolidColorBuffer, binding_sets_the_color_and_uploads_nothing)
+{
+    NiceMock<mtd::MockGL> mock_gl;
+    GLint const program{7}, location{3};
+    mg::SolidColorBuffer buffer{{1.0f, 0.5f, 0.0f, 1.0f}};
+
+    ON_CALL(mock_gl, glGetIntegerv(GL_CURRENT_PROGRAM, _))
+        .WillByDefault(SetArgPointee<1>(program));
+    ON_CALL(mock_gl, glGetUniformLocation(program, StrEq("solid_color")))
+        .WillByDefault(Return(location));
+
+    EXPECT_CALL(mock_gl, glUniform4fv(location, 1, _))
+        .WillOnce([](auto, auto, GLfloat const* value)
+            {
+                EXPECT_THAT(std::vector<GLfloat>(value, value + 4), ElementsAre(1.0f, 0.5f, 0.0f, 1.0f));
+            });
+    EXPECT_CALL(mock_gl, glTexImage2D(_, _, _, _, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(mock_gl, glBindTexture(_, _)).Times(0);
+
+    buffer.bind();
+}
+
+TEST(SolidColorBuffer, looks_up_the_color_uniform_once_per_program)
+{
+    NiceMock<mtd::MockGL> mock_gl;
+    GLint const opaque_program{11}, alpha_program{12};
+    GLint current_program{opaque_program};
+    mg::SolidColorBuffer red{{1.0f, 0.0f, 0.0f, 1.0f}};
+    mg::SolidColorBuffer blue{{0.0f, 0.0f, 1.0f, 1.0f}};
+
+    ON_CALL(mock_gl, glGetIntegerv(GL_CURRENT_PROGRAM, _))
+        .WillByDefault([&current_program](auto, GLint* value) { *value = current_program; });
+
+    EXPECT_CALL(mock_gl, glGetUniformLocation(opaque_program, StrEq("solid_color")))
+        .WillOnce(Return(1));
+    EXPECT_CALL(mock_gl, glGetUniformLocation(alpha_program, StrEq("solid_color")))
+        .WillOnce(Return(2));
+    EXPECT_CALL(mock_gl, glUniform4fv(1, 1, _)).Times(3);
+    EXPECT_CALL(mock_gl, glUniform4fv(2, 1, _)).Times(2);
+
+    red.bind();
+    blue.bind();
+    current_program = alpha_program;
+    red.bind();
+    blue.bind();
+    current_program = opaque_program;
+    red.bind();
+}
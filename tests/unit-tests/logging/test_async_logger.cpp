@@ -0,0 +1,170 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mir/logging/async_logger.h>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace ml = mir::logging;
+using namespace testing;
+
+namespace
+{
+class RecordingLogger : public ml::Logger
+{
+public:
+    void log(ml::Severity, std::string const& message, std::string const& component) override
+    {
+        std::lock_guard lock{mutex};
+        messages.push_back(component + ": " + message);
+        thread_ids.push_back(std::this_thread::get_id());
+    }
+
+    auto logged() -> std::vector<std::string>
+    {
+        std::lock_guard lock{mutex};
+        return messages;
+    }
+
+    auto logging_threads() -> std::vector<std::thread::id>
+    {
+        std::lock_guard lock{mutex};
+        return thread_ids;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::string> messages;
+    std::vector<std::thread::id> thread_ids;
+};
+
+struct AsyncLogger : Test
+{
+    std::shared_ptr<RecordingLogger> const target{std::make_shared<RecordingLogger>()};
+    std::shared_ptr<ml::Logger> const logger{std::make_shared<ml::AsyncLogger>(target)};
+
+    auto async_logger() -> ml::AsyncLogger&
+    {
+        return static_cast<ml::AsyncLogger&>(*logger);
+    }
+};
+}
+
+TEST_F(AsyncLogger, messages_reach_the_target_once_flushed)
+{
+    logger->log(ml::Severity::informational, "hello", "test");
+    logger->log(ml::Severity::debug, "world", "test");
+
+    ASSERT_TRUE(async_logger().flush());
+
+    EXPECT_THAT(target->logged(), ElementsAre("test: hello", "test: world"));
+}
+
+TEST_F(AsyncLogger, target_is_not_called_on_the_logging_thread)
+{
+    logger->log(ml::Severity::informational, "hello", "test");
+
+    ASSERT_TRUE(async_logger().flush());
+
+    EXPECT_THAT(target->logging_threads(), Each(Ne(std::this_thread::get_id())));
+}
+
+TEST_F(AsyncLogger, critical_messages_are_written_before_log_returns)
+{
+    logger->log(ml::Severity::informational, "before", "test");
+    logger->log(ml::Severity::critical, "critical", "test");
+
+    EXPECT_THAT(target->logged(), ElementsAre("test: before", "test: critical"));
+}
+
+TEST_F(AsyncLogger, messages_are_not_lost_when_a_thread_outpaces_the_writer)
+{
+    auto const count = 10'000;
+    for (auto i = 0; i != count; ++i)
+    {
+        logger->log(ml::Severity::informational, std::to_string(i), "test");
+    }
+
+    ASSERT_TRUE(async_logger().flush());
+
+    auto const logged = target->logged();
+    ASSERT_THAT(logged.size(), Eq(count));
+    EXPECT_THAT(logged.front(), Eq("test: 0"));
+    EXPECT_THAT(logged.back(), Eq("test: " + std::to_string(count - 1)));
+}
+
+TEST_F(AsyncLogger, each_threads_messages_are_written_in_order)
+{
+    auto const per_thread = 1'000;
+    std::vector<std::thread> threads;
+    for (auto t = 0; t != 4; ++t)
+    {
+        threads.emplace_back([&, component = std::to_string(t)]
+            {
+                for (auto i = 0; i != per_thread; ++i)
+                {
+                    logger->log(ml::Severity::informational, std::to_string(i), component);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_TRUE(async_logger().flush());
+
+    auto const logged = target->logged();
+    ASSERT_THAT(logged.size(), Eq(4 * per_thread));
+    for (auto t = 0; t != 4; ++t)
+    {
+        auto const prefix = std::to_string(t) + ": ";
+        auto next = 0;
+        for (auto const& message : logged)
+        {
+            if (message.starts_with(prefix))
+            {
+                EXPECT_THAT(message, Eq(prefix + std::to_string(next++)));
+            }
+        }
+    }
+}
+
+TEST_F(AsyncLogger, messages_logged_by_exited_threads_are_written)
+{
+    std::thread{[&] { logger->log(ml::Severity::informational, "from a thread", "test"); }}.join();
+
+    ASSERT_TRUE(async_logger().flush());
+
+    EXPECT_THAT(target->logged(), ElementsAre("test: from a thread"));
+}
+
+TEST(AsyncLoggerLifetime, queued_messages_are_written_on_destruction)
+{
+    auto const target = std::make_shared<RecordingLogger>();
+    {
+        std::shared_ptr<ml::Logger> const logger{std::make_shared<ml::AsyncLogger>(target)};
+        logger->log(ml::Severity::informational, "last words", "test");
+    }
+
+    EXPECT_THAT(target->logged(), ElementsAre("test: last words"));
+}
@@ -217,3 +217,70 @@ TEST_F(TestLog, can_set_severity_by_full_path_when_tag_name_is_the_same)
 
     EXPECT_TRUE(ml::logging_enabled_for(bypass_b, severity));
 }
+
+namespace
+{
+struct CountsFormatting
+{
+    int& count;
+};
+}
+
+template<>
+struct std::formatter<CountsFormatting> : std::formatter<std::string_view>
+{
+    auto format(CountsFormatting const& value, std::format_context& ctx) const
+    {
+        ++value.count;
+        return std::formatter<std::string_view>::format("counted", ctx);
+    }
+};
+
+TEST_F(TestLog, messages_for_disabled_tags_are_not_formatted)
+{
+    auto const& tag = ml::create_tag(ml::base(), "unformatted");
+    int formatted{0};
+
+    EXPECT_CALL(*logger, log(testing::_, testing::_, testing::_)).Times(0);
+
+    mir::log_debug({tag}, "{}", CountsFormatting{formatted});
+    mir::log(ml::Severity::informational, {tag}, "{}", CountsFormatting{formatted});
+
+    EXPECT_THAT(formatted, testing::Eq(0));
+}
+
+TEST_F(TestLog, enabling_a_tag_enables_its_children)
+{
+    auto const& parent = ml::create_tag(ml::base(), "parent");
+    auto const& child = ml::create_tag(parent, "child");
+    auto const& other = ml::create_tag(ml::base(), "other");
+
+    ASSERT_FALSE(ml::logging_enabled_for({child}, ml::Severity::debug)) << "Test would spuriously pass";
+
+    ml::tag::set_severity("base/parent", ml::Severity::debug);
+
+    EXPECT_TRUE(ml::logging_enabled_for({child}, ml::Severity::debug));
+    EXPECT_TRUE(ml::logging_enabled_for({other, child}, ml::Severity::debug));
+    EXPECT_FALSE(ml::logging_enabled_for({other}, ml::Severity::debug));
+    EXPECT_TRUE(ml::logging_enabled_for({other}, ml::Severity::warning));
+}
+
+TEST_F(TestLog, tags_sharing_a_bit_are_told_apart)
+{
+    // More tags than fit in the enabled_tags bitsets, each with a unique name
+    std::vector<std::string> names;
+    std::vector<ml::Tag const*> tags;
+    for (auto i = 0; i != 80; ++i)
+    {
+        names.push_back(std::format("shared-{}{}", char('a' + i / 26), char('a' + i % 26)));
+        tags.push_back(&ml::create_tag(ml::base(), names.back()));
+    }
+    auto const& enabled = *tags.back();
+    auto const& disabled = *tags[tags.size() - 2];
+
+    ml::tag::set_severity(names.back(), ml::Severity::debug);
+
+    EXPECT_TRUE(ml::logging_enabled_for({enabled}, ml::Severity::debug));
+    EXPECT_FALSE(ml::logging_enabled_for({disabled}, ml::Severity::debug));
+    EXPECT_TRUE(ml::logging_enabled_for({disabled, enabled}, ml::Severity::debug));
+}
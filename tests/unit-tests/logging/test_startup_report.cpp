@@ -0,0 +1,99 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/report/logging/startup_report.h"
+#include <mir/logging/logger.h>
+#include <mir/test/doubles/advanceable_clock.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace testing;
+
+namespace mtd = mir::test::doubles;
+namespace mrl = mir::report::logging;
+namespace ml = mir::logging;
+
+namespace
+{
+class Recorder : public ml::Logger
+{
+public:
+    void log(ml::Severity, std::string const& message, std::string const&) override
+    {
+        messages.push_back(message);
+    }
+
+    std::vector<std::string> messages;
+};
+
+struct LoggingStartupReport : Test
+{
+    std::shared_ptr<mtd::AdvanceableClock> const clock = std::make_shared<mtd::AdvanceableClock>();
+    std::shared_ptr<Recorder> const recorder = std::make_shared<Recorder>();
+    mrl::StartupReport report{recorder, clock};
+};
+}
+
+TEST_F(LoggingStartupReport, reports_duration_of_each_phase_as_it_ends)
+{
+    clock->advance_by(1ms);
+    report.phase_begun("Display");
+    clock->advance_by(20ms);
+    report.phase_ended("Display");
+
+    EXPECT_THAT(recorder->messages, ElementsAre("Display took 20.000ms (finished 21.000ms after start)"));
+}
+
+TEST_F(LoggingStartupReport, indents_nested_phases)
+{
+    report.phase_begun("Startup");
+    report.phase_begun("Display");
+    clock->advance_by(5ms);
+    report.phase_ended("Display");
+    report.phase_begun("Compositor");
+    clock->advance_by(3ms);
+    report.phase_ended("Compositor");
+    report.phase_ended("Startup");
+
+    EXPECT_THAT(recorder->messages, ElementsAre(
+        "  Display took 5.000ms (finished 5.000ms after start)",
+        "  Compositor took 3.000ms (finished 8.000ms after start)",
+        "Startup took 8.000ms (finished 8.000ms after start)"));
+}
+
+TEST_F(LoggingStartupReport, ignores_end_of_phase_that_never_began)
+{
+    report.phase_ended("Display");
+
+    EXPECT_THAT(recorder->messages, IsEmpty());
+}
+
+TEST_F(LoggingStartupReport, reports_time_to_first_frames)
+{
+    clock->advance_by(100ms);
+    report.first_frame();
+    clock->advance_by(150ms);
+    report.first_client_frame();
+
+    EXPECT_THAT(recorder->messages, ElementsAre(
+        "First frame after 100.000ms",
+        "First client frame after 250.000ms"));
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FAKE_ATOMIC_DRM_H_
+#define FAKE_ATOMIC_DRM_H_
+
+#include <mir/test/doubles/mock_drm.h>
+
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace mir
+{
+namespace test
+{
+
+/**
+ * Extends MockDRM with what atomic modesetting needs: every object has the
+ * properties AtomicKMSOutput sets, and a single primary plane can be used
+ * with any CRTC.
+ *
+ * Atomic commits are not mocked themselves; libdrm turns them into
+ * DRM_IOCTL_MODE_ATOMIC calls of MockDRM::drmIoctl().
+ */
+class FakeAtomicDRM
+{
+public:
+    static uint32_t constexpr plane_id{40};
+
+    explicit FakeAtomicDRM(doubles::MockDRM& mock_drm)
+    {
+        using namespace testing;
+
+        for (auto i = 0u; i != property_names.size(); ++i)
+        {
+            auto& property = properties[i];
+            property.prop_id = first_property_id + i;
+            std::strncpy(property.name, property_names[i], DRM_PROP_NAME_LEN - 1);
+            property_ids[i] = property.prop_id;
+            property_values[i] = std::strcmp(property_names[i], "type") ? 0 : DRM_PLANE_TYPE_PRIMARY;
+        }
+        object_properties.count_props = property_names.size();
+        object_properties.props = property_ids.data();
+        object_properties.prop_values = property_values.data();
+
+        plane.plane_id = plane_id;
+        plane.possible_crtcs = ~0u;
+        plane_resources.count_planes = 1;
+        plane_resources.planes = &plane.plane_id;
+
+        ON_CALL(mock_drm, drmModeObjectGetProperties(_, _, _))
+            .WillByDefault(Return(&object_properties));
+        ON_CALL(mock_drm, drmModeGetProperty(_, _))
+            .WillByDefault(
+                [this](int, uint32_t id) -> drmModePropertyPtr
+                {
+                    auto const index = id - first_property_id;
+                    return index < properties.size() ? &properties[index] : nullptr;
+                });
+        ON_CALL(mock_drm, drmModeGetPlaneResources(_))
+            .WillByDefault(Return(&plane_resources));
+        ON_CALL(mock_drm, drmModeGetPlane(_, plane_id))
+            .WillByDefault(Return(&plane));
+    }
+
+    FakeAtomicDRM(FakeAtomicDRM const&) = delete;
+    FakeAtomicDRM& operator=(FakeAtomicDRM const&) = delete;
+
+    auto property_id(char const* name) const -> uint32_t
+    {
+        auto const found = std::ranges::find_if(
+            property_names,
+            [name](char const* candidate) { return std::strcmp(candidate, name) == 0; });
+
+        if (found == property_names.end())
+            throw std::logic_error{std::string{"No such fake DRM property: "} + name};
+
+        return first_property_id + (found - property_names.begin());
+    }
+
+    /// Whether arg, the argument of a DRM_IOCTL_MODE_ATOMIC call, sets the property called name
+    auto commit_sets(void* arg, char const* name) const -> bool
+    {
+        auto const& commit = *static_cast<drm_mode_atomic const*>(arg);
+        auto const counts = reinterpret_cast<uint32_t const*>(commit.count_props_ptr);
+        auto const props = reinterpret_cast<uint32_t const*>(commit.props_ptr);
+        auto const end = props + std::accumulate(counts, counts + commit.count_objs, 0u);
+
+        return std::find(props, end, property_id(name)) != end;
+    }
+
+private:
+    static uint32_t constexpr first_property_id{100};
+    static constexpr std::array property_names{
+        "CRTC_ID", "ACTIVE", "MODE_ID", "FB_ID",
+        "SRC_X", "SRC_Y", "SRC_W", "SRC_H",
+        "CRTC_X", "CRTC_Y", "CRTC_W", "CRTC_H",
+        "GAMMA_LUT", "type"};
+
+    std::array<drmModePropertyRes, property_names.size()> properties{};
+    std::array<uint32_t, property_names.size()> property_ids{};
+    std::array<uint64_t, property_names.size()> property_values{};
+    drmModeObjectProperties object_properties{};
+
+    drmModePlane plane{};
+    drmModePlaneRes plane_resources{};
+};
+
+}
+}
+
+#endif // FAKE_ATOMIC_DRM_H_
@@ -38,6 +38,7 @@ public:
     MOCK_METHOD(bool, has_crtc_mismatch, (), (override));
     MOCK_METHOD(void, clear_crtc, (), (override));
     MOCK_METHOD(bool, page_flip, (graphics::FBHandle const&), (override));
+    MOCK_METHOD(bool, async_page_flip, (graphics::FBHandle const&), (override));
     MOCK_METHOD(void, set_cursor_image, (gbm_bo*), (override));
     MOCK_METHOD(void, move_cursor, (geometry::Point), (override));
     MOCK_METHOD(bool, clear_cursor, (), (override));
@@ -0,0 +1,173 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/platforms/atomic-kms/server/kms/atomic_kms_output.h"
+#include <mir/graphics/kms/drm_mode_resources.h>
+#include <mir/graphics/kms_framebuffer.h>
+#include <mir/test/doubles/mock_drm.h>
+#include "fake_atomic_drm.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cerrno>
+
+namespace mg = mir::graphics;
+namespace mga = mir::graphics::atomic;
+namespace mgk = mir::graphics::kms;
+namespace geom = mir::geometry;
+namespace mt = mir::test;
+namespace mtd = mt::doubles;
+
+using namespace ::testing;
+
+#ifndef DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP
+#define DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP 0x15
+#endif
+
+namespace
+{
+char const* const drm_device{"/dev/dri/card0"};
+
+class StubKMSFramebuffer : public mg::FBHandle
+{
+public:
+    explicit StubKMSFramebuffer(geom::Size size)
+        : size_{size}
+    {
+    }
+
+    operator uint32_t() const override
+    {
+        return 42;
+    }
+
+    auto size() const -> geom::Size override
+    {
+        return size_;
+    }
+
+private:
+    geom::Size const size_;
+};
+
+MATCHER(IsAsyncCommit, "")
+{
+    return static_cast<drm_mode_atomic const*>(arg)->flags & DRM_MODE_PAGE_FLIP_ASYNC;
+}
+
+struct AtomicKMSOutputTest : Test
+{
+    AtomicKMSOutputTest()
+    {
+        using fake = mtd::FakeDRMResources;
+
+        std::vector<drmModeModeInfo> modes{fake::create_mode(1920, 1080, 138500, 2080, 1111, fake::PreferredMode)};
+        std::vector<uint32_t> encoders{encoder_id};
+
+        mock_drm.reset(drm_device);
+        mock_drm.add_crtc(drm_device, crtc_id, modes[0]);
+        mock_drm.add_encoder(drm_device, encoder_id, crtc_id, 0x1);
+        mock_drm.add_connector(
+            drm_device, connector_id, DRM_MODE_CONNECTOR_DVID, DRM_MODE_CONNECTED, encoder_id,
+            modes, encoders, geom::Size{121, 144});
+        mock_drm.prepare(drm_device);
+
+        // The kernel reports the size of the mode a CRTC is showing; FakeDRMResources leaves it zeroed
+        crtc.crtc_id = crtc_id;
+        crtc.mode = modes[0];
+        crtc.mode_valid = 1;
+        crtc.width = modes[0].hdisplay;
+        crtc.height = modes[0].vdisplay;
+        ON_CALL(mock_drm, drmModeGetCrtc(_, crtc_id))
+            .WillByDefault(Return(&crtc));
+
+        ON_CALL(mock_drm, drmGetCap(_, DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP, _))
+            .WillByDefault(
+                [](auto, auto, uint64_t* value)
+                {
+                    *value = 1;
+                    return 0;
+                });
+
+        EXPECT_CALL(mock_drm, drmIoctl(_, _, _)).Times(AnyNumber());
+    }
+
+    /// An output that has already shown a frame, so that only its framebuffer changes from now on
+    auto create_flipping_output() -> std::unique_ptr<mga::AtomicKMSOutput>
+    {
+        mir::Fd const drm_fd{mir::IntOwnedFd{mock_drm.open(drm_device, 0)}};
+        auto output = std::make_unique<mga::AtomicKMSOutput>(drm_fd, mgk::get_connector(drm_fd, connector_id));
+        output->configure({0, 0}, 0);
+        EXPECT_TRUE(output->page_flip(fb));
+        return output;
+    }
+
+    static uint32_t constexpr crtc_id{10};
+    static uint32_t constexpr encoder_id{20};
+    static uint32_t constexpr connector_id{30};
+
+    NiceMock<mtd::MockDRM> mock_drm;
+    mt::FakeAtomicDRM fake_drm{mock_drm};
+    drmModeCrtc crtc{};
+    StubKMSFramebuffer const fb{{1920, 1080}};
+};
+}
+
+TEST_F(AtomicKMSOutputTest, flips_asynchronously_when_the_driver_supports_it)
+{
+    auto const output = create_flipping_output();
+
+    EXPECT_CALL(mock_drm, drmIoctl(_, DRM_IOCTL_MODE_ATOMIC, IsAsyncCommit()))
+        .WillOnce(Return(0));
+
+    EXPECT_TRUE(output->async_page_flip(fb));
+}
+
+TEST_F(AtomicKMSOutputTest, does_not_try_to_flip_asynchronously_when_the_driver_does_not_support_it)
+{
+    ON_CALL(mock_drm, drmGetCap(_, DRM_CAP_ATOMIC_ASYNC_PAGE_FLIP, _))
+        .WillByDefault(Return(-EINVAL));
+    auto const output = create_flipping_output();
+
+    EXPECT_CALL(mock_drm, drmIoctl(_, DRM_IOCTL_MODE_ATOMIC, IsAsyncCommit())).Times(0);
+
+    EXPECT_FALSE(output->async_page_flip(fb));
+}
+
+TEST_F(AtomicKMSOutputTest, a_rejected_asynchronous_flip_falls_back_to_flipping_on_vblank)
+{
+    auto const output = create_flipping_output();
+
+    EXPECT_CALL(mock_drm, drmIoctl(_, DRM_IOCTL_MODE_ATOMIC, IsAsyncCommit()))
+        .WillOnce(DoAll(Assign(&errno, EINVAL), Return(-1)));
+
+    EXPECT_FALSE(output->async_page_flip(fb));
+    EXPECT_TRUE(output->page_flip(fb));
+}
+
+TEST_F(AtomicKMSOutputTest, the_next_flip_tries_asynchronously_again_after_one_is_rejected)
+{
+    auto const output = create_flipping_output();
+
+    EXPECT_CALL(mock_drm, drmIoctl(_, DRM_IOCTL_MODE_ATOMIC, IsAsyncCommit()))
+        .WillOnce(DoAll(Assign(&errno, EINVAL), Return(-1)))
+        .WillOnce(Return(0));
+
+    EXPECT_FALSE(output->async_page_flip(fb));
+    EXPECT_TRUE(output->page_flip(fb));
+    EXPECT_TRUE(output->async_page_flip(fb));
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/platforms/atomic-kms/server/kms/display.h"
+#include <mir/graphics/display_configuration.h>
+#include <mir/graphics/display_configuration_policy.h>
+#include <mir/test/doubles/mock_display_report.h>
+#include <mir/test/doubles/mock_drm.h>
+#include <mir_test_framework/udev_environment.h>
+#include "fake_atomic_drm.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+namespace mg = mir::graphics;
+namespace mga = mir::graphics::atomic;
+namespace geom = mir::geometry;
+namespace mt = mir::test;
+namespace mtd = mt::doubles;
+namespace mtf = mir_test_framework;
+
+using namespace ::testing;
+
+namespace
+{
+char const* const drm_device{"/dev/dri/card0"};
+
+class PreferredModePolicy : public mg::DisplayConfigurationPolicy
+{
+public:
+    void apply_to(mg::DisplayConfiguration& conf) override
+    {
+        conf.for_each_output(
+            [](mg::UserDisplayConfigurationOutput& output)
+            {
+                output.used = output.connected;
+                output.current_mode_index = output.preferred_mode_index;
+                output.power_mode = mir_power_mode_on;
+            });
+    }
+
+    void confirm(mg::DisplayConfiguration const&) override
+    {
+    }
+};
+
+MATCHER_P2(IsAtomicCommitSetting, fake_drm, property, "")
+{
+    return fake_drm->commit_sets(arg, property);
+}
+
+struct AtomicKMSDisplay : Test
+{
+    AtomicKMSDisplay()
+    {
+        using fake = mtd::FakeDRMResources;
+
+        // The output is already showing its preferred mode, so the display has no need to clear it
+        std::vector<drmModeModeInfo> modes{fake::create_mode(1920, 1080, 138500, 2080, 1111, fake::PreferredMode)};
+        std::vector<uint32_t> encoders{encoder_id};
+
+        mock_drm.reset(drm_device);
+        mock_drm.add_crtc(drm_device, crtc_id, modes[0]);
+        mock_drm.add_encoder(drm_device, encoder_id, crtc_id, 0x1);
+        mock_drm.add_connector(
+            drm_device, connector_id, DRM_MODE_CONNECTOR_DVID, DRM_MODE_CONNECTED, encoder_id,
+            modes, encoders, geom::Size{121, 144});
+        mock_drm.prepare(drm_device);
+    }
+
+    auto create_display() -> std::unique_ptr<mga::Display>
+    {
+        return std::make_unique<mga::Display>(
+            mir::Fd{mir::IntOwnedFd{mock_drm.open(drm_device, 0)}},
+            nullptr,
+            mga::BypassOption::allowed,
+            std::make_shared<PreferredModePolicy>(),
+            std::make_shared<NiceMock<mtd::MockDisplayReport>>(),
+            nullptr);
+    }
+
+    static auto sync_groups_of(mg::Display& display) -> std::vector<mg::DisplaySyncGroup*>
+    {
+        std::vector<mg::DisplaySyncGroup*> groups;
+        display.for_each_display_sync_group([&groups](mg::DisplaySyncGroup& group) { groups.push_back(&group); });
+        return groups;
+    }
+
+    static auto configure_incrementally(mg::Display& display, mg::DisplayConfiguration const& conf)
+        -> std::vector<mg::DisplaySyncGroup*>
+    {
+        std::vector<mg::DisplaySyncGroup*> removed;
+        display.configure_incrementally(conf, [&removed](mg::DisplaySyncGroup& group) { removed.push_back(&group); });
+        return removed;
+    }
+
+    static uint32_t constexpr crtc_id{10};
+    static uint32_t constexpr encoder_id{20};
+    static uint32_t constexpr connector_id{30};
+
+    mtf::UdevEnvironment udev_environment;
+    NiceMock<mtd::MockDRM> mock_drm;
+    mt::FakeAtomicDRM fake_drm{mock_drm};
+    mg::GammaCurves const gamma{{0, 0x8000, 0xffff}, {0, 0x8000, 0xffff}, {0, 0x8000, 0xffff}};
+};
+}
+
+TEST_F(AtomicKMSDisplay, moving_and_rotating_an_output_keeps_its_sync_group)
+{
+    auto const display = create_display();
+    auto const groups = sync_groups_of(*display);
+    ASSERT_THAT(groups, SizeIs(1));
+
+    auto const conf = display->configuration();
+    conf->for_each_output(
+        [](mg::UserDisplayConfigurationOutput& output)
+        {
+            output.top_left = {1280, 0};
+            output.orientation = mir_orientation_left;
+        });
+
+    EXPECT_THAT(configure_incrementally(*display, *conf), IsEmpty());
+    EXPECT_THAT(sync_groups_of(*display), Eq(groups));
+}
+
+TEST_F(AtomicKMSDisplay, turning_an_output_off_removes_its_sync_group)
+{
+    auto const display = create_display();
+    auto const groups = sync_groups_of(*display);
+    ASSERT_THAT(groups, SizeIs(1));
+
+    auto const conf = display->configuration();
+    conf->for_each_output(
+        [](mg::UserDisplayConfigurationOutput& output)
+        {
+            output.power_mode = mir_power_mode_off;
+        });
+
+    EXPECT_THAT(configure_incrementally(*display, *conf), Eq(groups));
+    EXPECT_THAT(sync_groups_of(*display), IsEmpty());
+}
+
+TEST_F(AtomicKMSDisplay, changing_the_gamma_of_a_kept_output_sets_it)
+{
+    auto const display = create_display();
+    auto const groups = sync_groups_of(*display);
+
+    auto const conf = display->configuration();
+    conf->for_each_output(
+        [this](mg::UserDisplayConfigurationOutput& output)
+        {
+            output.gamma = gamma;
+        });
+
+    EXPECT_CALL(mock_drm, drmIoctl(_, _, _)).Times(AnyNumber());
+    EXPECT_CALL(mock_drm, drmIoctl(_, DRM_IOCTL_MODE_ATOMIC, IsAtomicCommitSetting(&fake_drm, "GAMMA_LUT")));
+
+    EXPECT_THAT(configure_incrementally(*display, *conf), IsEmpty());
+    EXPECT_THAT(sync_groups_of(*display), Eq(groups));
+}
+
+TEST_F(AtomicKMSDisplay, reapplying_the_gamma_of_a_kept_output_does_not_set_it_again)
+{
+    auto const display = create_display();
+
+    auto const conf = display->configuration();
+    conf->for_each_output(
+        [this](mg::UserDisplayConfigurationOutput& output)
+        {
+            output.gamma = gamma;
+        });
+
+    EXPECT_CALL(mock_drm, drmIoctl(_, _, _)).Times(AnyNumber());
+    EXPECT_CALL(mock_drm, drmIoctl(_, DRM_IOCTL_MODE_ATOMIC, IsAtomicCommitSetting(&fake_drm, "GAMMA_LUT")))
+        .Times(1);
+
+    configure_incrementally(*display, *conf);
+    configure_incrementally(*display, *conf);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/platforms/atomic-kms/server/kms/display_sink.h"
+#include <mir/test/doubles/mock_display_report.h>
+#include "mock_kms_output.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <memory>
+
+namespace mg = mir::graphics;
+namespace mga = mir::graphics::atomic;
+namespace geom = mir::geometry;
+namespace mt = mir::test;
+namespace mtd = mt::doubles;
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+class StubKMSFramebuffer : public mg::FBHandle
+{
+public:
+    explicit StubKMSFramebuffer(geom::Size size)
+        : size_{size}
+    {
+    }
+
+    operator uint32_t() const override
+    {
+        return 42;
+    }
+
+    auto size() const -> geom::Size override
+    {
+        return size_;
+    }
+
+private:
+    geom::Size const size_;
+};
+
+struct AtomicKMSDisplaySink : Test
+{
+    AtomicKMSDisplaySink()
+    {
+        ON_CALL(*output, has_crtc_mismatch()).WillByDefault(Return(false));
+        ON_CALL(*output, page_flip(_)).WillByDefault(Return(true));
+        ON_CALL(*output, set_crtc(_)).WillByDefault(Return(true));
+        // Slow enough that a vsynced frame leaves time to sleep before the next
+        ON_CALL(*output, max_refresh_rate()).WillByDefault(Return(10));
+    }
+
+    /// Presents a fullscreen frame directly, as the compositor does for a bypassed surface
+    void post_fullscreen_frame(bool allow_tearing)
+    {
+        mg::DisplayElement element{
+            area,
+            {{0, 0}, {area.size.width.as_value(), area.size.height.as_value()}},
+            framebuffer};
+        element.allow_tearing = allow_tearing;
+
+        ASSERT_TRUE(sink.overlay({element}));
+        sink.post();
+    }
+
+    geom::Rectangle const area{{0, 0}, {1920, 1080}};
+    std::shared_ptr<NiceMock<mt::MockKMSOutput>> const output{std::make_shared<NiceMock<mt::MockKMSOutput>>()};
+    std::shared_ptr<StubKMSFramebuffer> const framebuffer{std::make_shared<StubKMSFramebuffer>(area.size)};
+    mga::DisplaySink sink{
+        mir::Fd{},
+        nullptr,
+        mga::BypassOption::allowed,
+        std::make_shared<NiceMock<mtd::MockDisplayReport>>(),
+        output,
+        area,
+        glm::mat2{1},
+        nullptr};
+};
+}
+
+TEST_F(AtomicKMSDisplaySink, frame_allowing_tearing_is_flipped_asynchronously_without_sleeping)
+{
+    EXPECT_CALL(*output, async_page_flip(_)).WillOnce(Return(true));
+    EXPECT_CALL(*output, page_flip(_)).Times(0);
+
+    post_fullscreen_frame(true);
+
+    EXPECT_THAT(sink.recommended_sleep(), Eq(0ms));
+}
+
+TEST_F(AtomicKMSDisplaySink, rejected_asynchronous_flip_falls_back_to_vsynced_flip)
+{
+    EXPECT_CALL(*output, async_page_flip(_)).WillOnce(Return(false));
+    EXPECT_CALL(*output, page_flip(_)).WillOnce(Return(true));
+
+    post_fullscreen_frame(true);
+
+    EXPECT_THAT(sink.recommended_sleep(), Gt(0ms));
+}
+
+TEST_F(AtomicKMSDisplaySink, asynchronous_flip_is_tried_again_after_a_rejection)
+{
+    EXPECT_CALL(*output, async_page_flip(_))
+        .WillOnce(Return(false))
+        .WillOnce(Return(true));
+
+    post_fullscreen_frame(true);
+    post_fullscreen_frame(true);
+
+    EXPECT_THAT(sink.recommended_sleep(), Eq(0ms));
+}
+
+TEST_F(AtomicKMSDisplaySink, frame_not_allowing_tearing_waits_for_vblank)
+{
+    EXPECT_CALL(*output, async_page_flip(_)).Times(0);
+    EXPECT_CALL(*output, page_flip(_)).WillOnce(Return(true));
+
+    post_fullscreen_frame(false);
+
+    EXPECT_THAT(sink.recommended_sleep(), Gt(0ms));
+}
@@ -69,6 +69,7 @@ public:
     MOCK_METHOD(void, window_resized_to, (ms::Surface const*, geom::Size const&), (override));
     MOCK_METHOD(void, content_resized_to, (ms::Surface const*, geom::Size const&), (override));
     MOCK_METHOD(void, frame_posted, (ms::Surface const*, geom::Rectangle const&), (override));
+    MOCK_METHOD(void, moved_to, (ms::Surface const*, geom::Point const&), (override));
     MOCK_METHOD(void, hidden_set_to, (ms::Surface const*, bool), (override));
     MOCK_METHOD(void, renamed, (ms::Surface const*, std::string const&), (override));
     MOCK_METHOD(void, client_surface_close_requested, (ms::Surface const*), (override));
@@ -1118,6 +1119,30 @@ TEST_F(BasicSurfaceTest, when_surface_has_margins_an_observer_is_notified_of_fra
     buffer_stream->frame_posted_callback({20, 30});
 }
 
+TEST_F(BasicSurfaceTest, tearing_is_not_allowed_by_default)
+{
+    EXPECT_FALSE(surface.tearing_allowed());
+}
+
+TEST_F(BasicSurfaceTest, tearing_can_be_allowed)
+{
+    surface.set_tearing_allowed(true);
+    EXPECT_TRUE(surface.tearing_allowed());
+    surface.set_tearing_allowed(false);
+    EXPECT_FALSE(surface.tearing_allowed());
+}
+
+TEST_F(BasicSurfaceTest, content_type_is_none_by_default)
+{
+    EXPECT_EQ(mir_content_type_none, surface.content_type());
+}
+
+TEST_F(BasicSurfaceTest, content_type_can_be_set)
+{
+    surface.set_content_type(mir_content_type_video);
+    EXPECT_EQ(mir_content_type_video, surface.content_type());
+}
+
 TEST_F(BasicSurfaceTest, default_application_id)
 {
     EXPECT_EQ("", surface.application_id());
@@ -1445,6 +1470,53 @@ TEST_F(BasicSurfaceTest, registers_frame_callbacks_on_set_streams)
     surface.set_streams(streams);
 }
 
+TEST_F(BasicSurfaceTest, setting_unchanged_streams_does_not_notify_observers)
+{
+    using namespace testing;
+
+    surface.register_interest(mock_surface_observer, executor);
+
+    EXPECT_CALL(*mock_buffer_stream, set_frame_posted_callback(_)).Times(0);
+    EXPECT_CALL(*mock_surface_observer, moved_to(_, _)).Times(0);
+
+    surface.set_streams(streams);
+}
+
+TEST_F(BasicSurfaceTest, moving_one_stream_only_updates_frame_callback_of_that_stream)
+{
+    using namespace testing;
+
+    auto buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    geom::Displacement const moved_to{5, 6};
+
+    surface.set_streams({{mock_buffer_stream, {}}, {buffer_stream, {}}});
+    surface.register_interest(mock_surface_observer, executor);
+
+    EXPECT_CALL(*mock_buffer_stream, set_frame_posted_callback(_)).Times(0);
+    EXPECT_CALL(*buffer_stream, set_frame_posted_callback(_)).Times(AtLeast(1));
+    EXPECT_CALL(*mock_surface_observer, moved_to(_, _));
+
+    surface.set_streams({{mock_buffer_stream, {}}, {buffer_stream, moved_to}});
+    executor.execute();
+
+    EXPECT_CALL(*mock_surface_observer, frame_posted(_, mt::RectTopLeftEq(geom::Point{} + moved_to)));
+    buffer_stream->frame_posted_callback(rect.size);
+}
+
+TEST_F(BasicSurfaceTest, removed_streams_no_longer_notify_observers_of_frames)
+{
+    using namespace testing;
+
+    auto buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+
+    surface.set_streams({{mock_buffer_stream, {}}, {buffer_stream, {}}});
+    surface.register_interest(mock_surface_observer, executor);
+    surface.set_streams({{mock_buffer_stream, {}}});
+
+    EXPECT_CALL(*mock_surface_observer, frame_posted(_, _)).Times(0);
+    buffer_stream->frame_posted_callback(rect.size);
+}
+
 //TODO: per-stream alpha and swapinterval seems useful
 TEST_F(BasicSurfaceTest, changing_alpha_effects_all_streams)
 {
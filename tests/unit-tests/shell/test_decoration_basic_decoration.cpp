@@ -19,6 +19,7 @@
 #include <mir/shell/surface_specification.h>
 #include <mir/input/cursor_images.h>
 #include <mir/scene/basic_surface.h>
+#include <mir/graphics/solid_color_buffer.h>
 #include "src/server/report/null_report_factory.h"
 
 #include <mir/test/fake_shared.h>
@@ -35,12 +36,16 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <dlfcn.h>
+
 namespace ms = mir::scene;
 namespace mi = mir::input;
 namespace mc = mir::compositor;
 namespace msh = mir::shell;
 namespace geom = mir::geometry;
 namespace mev = mir::events;
+namespace mg = mir::graphics;
 namespace mf = mir::frontend;
 namespace mw = mir::wayland;
 namespace msd = mir::shell::decoration;
@@ -50,6 +55,22 @@ namespace mtd = mir::test::doubles;
 using namespace testing;
 using namespace std::chrono_literals;
 
+namespace
+{
+std::atomic<int> ft_set_pixel_sizes_calls{0};
+}
+
+// Interpose FreeType's FT_Set_Pixel_Sizes() to count how often the title renderer resizes its face.
+// Declared with FreeType's underlying types so the tests don't need its headers.
+extern "C" int FT_Set_Pixel_Sizes(void* face, unsigned int pixel_width, unsigned int pixel_height)
+{
+    static auto const real_set_pixel_sizes =
+        reinterpret_cast<int(*)(void*, unsigned int, unsigned int)>(dlsym(RTLD_NEXT, "FT_Set_Pixel_Sizes"));
+
+    ++ft_set_pixel_sizes_calls;
+    return real_set_pixel_sizes(face, pixel_width, pixel_height);
+}
+
 namespace
 {
 geom::DeltaX const button_width{28};
@@ -192,6 +213,7 @@ struct DecorationBasicDecoration
         basic_decoration = std::make_shared<msd::BasicDecoration>(
             mt::fake_shared(shell),
             mt::fake_shared(executor),
+            executor,
             mt::fake_shared(cursor_images),
             mt::fake_shared(window_surface),
             msd::DecorationStrategy::default_decoration_strategy(mt::fake_shared(buffer_allocator)));
@@ -342,6 +364,37 @@ TEST_F(DecorationBasicDecoration, redrawn_on_rename)
     Mock::VerifyAndClearExpectations(&buffer_stream);
 }
 
+TEST_F(DecorationBasicDecoration, updates_made_before_rendering_are_drawn_once)
+{
+    EXPECT_CALL(buffer_stream, submit_buffer(_, _, _))
+        .Times(1);
+    window_surface.rename("first name");
+    window_surface.rename("second name");
+    window_surface.rename("third name");
+    executor.execute();
+    Mock::VerifyAndClearExpectations(&buffer_stream);
+}
+
+TEST_F(DecorationBasicDecoration, redrawing_a_title_does_not_resize_the_font_again)
+{
+    window_surface.rename("A title");
+    executor.execute();
+    auto const calls_after_first_title = ft_set_pixel_sizes_calls.load();
+    if (calls_after_first_title == 0)
+    {
+        // Without a font face, titles are never drawn and there's nothing to count
+        GTEST_SKIP() << "No font face could be loaded";
+    }
+
+    for (auto const& title : {"A title", "Another title", "A title"})
+    {
+        window_surface.rename(title);
+        executor.execute();
+    }
+
+    EXPECT_THAT(ft_set_pixel_sizes_calls.load(), Eq(calls_after_first_title));
+}
+
 TEST_F(DecorationBasicDecoration, redrawn_on_focus_state_change)
 {
     window_surface.configure(mir_window_attrib_focus, mir_window_focus_state_focused);
@@ -370,6 +423,37 @@ TEST_F(DecorationBasicDecoration, decoration_resized_on_window_resize)
     EXPECT_THAT(spec.height.value(), Eq(new_size.height));
 }
 
+TEST_F(DecorationBasicDecoration, borders_are_solid_colors_stretched_over_their_area)
+{
+    geom::Size const new_size{203, 305};
+    std::vector<std::pair<std::shared_ptr<mg::Buffer>, geom::Size>> submitted;
+    EXPECT_CALL(buffer_stream, submit_buffer(_, _, _))
+        .WillRepeatedly([&](auto const& buffer, geom::Size dest_size, auto)
+            {
+                submitted.emplace_back(buffer, dest_size);
+            });
+    window_surface.resize(new_size);
+    executor.execute();
+
+    std::vector<geom::Size> solid_color_sizes;
+    for (auto const& [buffer, dest_size] : submitted)
+    {
+        if (std::dynamic_pointer_cast<mg::SolidColorBuffer>(buffer))
+        {
+            solid_color_sizes.push_back(dest_size);
+        }
+    }
+
+    // Left, right and bottom borders; the titlebar has content so needs a real buffer
+    ASSERT_THAT(solid_color_sizes.size(), Eq(3u));
+    EXPECT_THAT(solid_color_sizes, Contains(Field(&geom::Size::width, Eq(new_size.width))));
+    for (auto const& size : solid_color_sizes)
+    {
+        EXPECT_THAT(size.width, Gt(geom::Width{1}));
+        EXPECT_THAT(size.height, Gt(geom::Height{1}));
+    }
+}
+
 TEST_F(DecorationBasicDecoration, makes_padding_for_borders)
 {
     EXPECT_THAT(window_surface.content_size().width, Lt(window_surface.window_size().width));
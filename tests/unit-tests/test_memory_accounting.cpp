@@ -0,0 +1,173 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mir/memory_accounting.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace testing;
+
+namespace mm = mir::memory;
+
+namespace
+{
+mm::ClientId const a_client{4242};
+mm::ClientId const another_client{4343};
+
+struct MemoryAccounting : Test
+{
+    ~MemoryAccounting()
+    {
+        mm::ledger().set_client_budget(0, mm::BudgetAction::warn, {});
+        mm::ledger().end_exemption_from_refusal(a_client);
+    }
+
+    MockFunction<void(mm::ClientId, std::size_t, std::size_t, bool)> over_budget;
+};
+}
+
+TEST_F(MemoryAccounting, allocation_is_counted_until_destroyed)
+{
+    auto const before = mm::ledger().usage()[mm::Category::cursor_image];
+    {
+        mm::Allocation const allocation{mm::Category::cursor_image, mm::no_client, 4096};
+        EXPECT_THAT(mm::ledger().usage()[mm::Category::cursor_image], Eq(before + 4096));
+    }
+    EXPECT_THAT(mm::ledger().usage()[mm::Category::cursor_image], Eq(before));
+}
+
+TEST_F(MemoryAccounting, reset_changes_the_bytes_counted)
+{
+    auto const before = mm::ledger().usage()[mm::Category::shm_texture];
+    mm::Allocation allocation{mm::Category::shm_texture, mm::no_client, 0};
+
+    allocation.reset(1000);
+    EXPECT_THAT(mm::ledger().usage()[mm::Category::shm_texture], Eq(before + 1000));
+
+    allocation.reset(10);
+    EXPECT_THAT(mm::ledger().usage()[mm::Category::shm_texture], Eq(before + 10));
+}
+
+TEST_F(MemoryAccounting, moved_from_allocation_releases_nothing)
+{
+    auto const before = mm::ledger().usage()[mm::Category::software_buffer];
+    {
+        mm::Allocation moved_from{mm::Category::software_buffer, mm::no_client, 512};
+        {
+            mm::Allocation const moved_to{std::move(moved_from)};
+            EXPECT_THAT(mm::ledger().usage()[mm::Category::software_buffer], Eq(before + 512));
+        }
+        EXPECT_THAT(mm::ledger().usage()[mm::Category::software_buffer], Eq(before));
+    }
+    EXPECT_THAT(mm::ledger().usage()[mm::Category::software_buffer], Eq(before));
+}
+
+TEST_F(MemoryAccounting, client_allocations_are_attributed_to_the_client)
+{
+    mm::Allocation const first{mm::Category::shm_pool, a_client, 100};
+    mm::Allocation const second{mm::Category::shm_pool, a_client, 20};
+    mm::Allocation const other{mm::Category::shm_pool, another_client, 3};
+
+    EXPECT_THAT(mm::ledger().usage_of(a_client)[mm::Category::shm_pool], Eq(120u));
+    EXPECT_THAT(mm::ledger().usage_of(another_client)[mm::Category::shm_pool], Eq(3u));
+
+    auto const by_client = mm::ledger().usage_by_client();
+    ASSERT_THAT(by_client.count(a_client), Eq(1u));
+    EXPECT_THAT(by_client.at(a_client).total(), Eq(120u));
+}
+
+TEST_F(MemoryAccounting, client_with_nothing_allocated_is_not_listed)
+{
+    {
+        mm::Allocation const allocation{mm::Category::shm_pool, a_client, 100};
+    }
+
+    EXPECT_THAT(mm::ledger().usage_by_client().count(a_client), Eq(0u));
+    EXPECT_THAT(mm::ledger().usage_of(a_client).total(), Eq(0u));
+}
+
+TEST_F(MemoryAccounting, without_a_budget_everything_is_admitted)
+{
+    mm::Allocation const allocation{mm::Category::shm_pool, a_client, 1024 * 1024 * 1024};
+
+    EXPECT_TRUE(mm::ledger().admit(a_client, 1024 * 1024 * 1024));
+}
+
+TEST_F(MemoryAccounting, allocation_within_budget_is_admitted_silently)
+{
+    mm::ledger().set_client_budget(1000, mm::BudgetAction::refuse, over_budget.AsStdFunction());
+    mm::Allocation const allocation{mm::Category::shm_pool, a_client, 600};
+
+    EXPECT_CALL(over_budget, Call(_, _, _, _)).Times(0);
+    EXPECT_TRUE(mm::ledger().admit(a_client, 400));
+}
+
+TEST_F(MemoryAccounting, allocation_over_budget_is_reported_and_admitted_when_warning)
+{
+    mm::ledger().set_client_budget(1000, mm::BudgetAction::warn, over_budget.AsStdFunction());
+    mm::Allocation const allocation{mm::Category::shm_pool, a_client, 600};
+
+    EXPECT_CALL(over_budget, Call(a_client, 1001u, 1000u, false));
+    EXPECT_TRUE(mm::ledger().admit(a_client, 401));
+}
+
+TEST_F(MemoryAccounting, allocation_over_budget_is_reported_and_refused_when_refusing)
+{
+    mm::ledger().set_client_budget(1000, mm::BudgetAction::refuse, over_budget.AsStdFunction());
+    mm::Allocation const allocation{mm::Category::shm_pool, a_client, 600};
+
+    EXPECT_CALL(over_budget, Call(a_client, 1001u, 1000u, true));
+    EXPECT_FALSE(mm::ledger().admit(a_client, 401));
+}
+
+TEST_F(MemoryAccounting, allocation_over_budget_by_an_exempt_client_is_reported_and_admitted_when_refusing)
+{
+    mm::ledger().set_client_budget(1000, mm::BudgetAction::refuse, over_budget.AsStdFunction());
+    mm::ledger().exempt_from_refusal(a_client);
+    mm::Allocation const allocation{mm::Category::shm_pool, a_client, 600};
+
+    EXPECT_CALL(over_budget, Call(a_client, 1001u, 1000u, false));
+    EXPECT_TRUE(mm::ledger().admit(a_client, 401));
+}
+
+TEST_F(MemoryAccounting, allocation_over_budget_is_refused_once_an_exemption_ends)
+{
+    mm::ledger().set_client_budget(1000, mm::BudgetAction::refuse, over_budget.AsStdFunction());
+    mm::ledger().exempt_from_refusal(a_client);
+    mm::ledger().end_exemption_from_refusal(a_client);
+    mm::Allocation const allocation{mm::Category::shm_pool, a_client, 600};
+
+    EXPECT_CALL(over_budget, Call(a_client, 1001u, 1000u, true));
+    EXPECT_FALSE(mm::ledger().admit(a_client, 401));
+}
+
+TEST_F(MemoryAccounting, budget_is_per_client)
+{
+    mm::ledger().set_client_budget(1000, mm::BudgetAction::refuse, over_budget.AsStdFunction());
+    mm::Allocation const allocation{mm::Category::shm_pool, a_client, 1000};
+
+    EXPECT_CALL(over_budget, Call(_, _, _, _)).Times(0);
+    EXPECT_TRUE(mm::ledger().admit(another_client, 1000));
+}
+
+TEST_F(MemoryAccounting, server_allocations_are_not_budgeted)
+{
+    mm::ledger().set_client_budget(1000, mm::BudgetAction::refuse, over_budget.AsStdFunction());
+
+    EXPECT_CALL(over_budget, Call(_, _, _, _)).Times(0);
+    EXPECT_TRUE(mm::ledger().admit(mm::no_client, 1024 * 1024));
+}
@@ -16,6 +16,8 @@
 
 #include "src/server/shm_backing.h"
 
+#include <mir/memory_accounting.h>
+
 #include <mir_test_framework/mmap_wrapper.h>
 
 #include <linux/memfd.h>
@@ -105,6 +107,27 @@ auto make_shm_fd_with_seals(size_t size, int seals) -> mir::Fd
     }
     return fd;
 }
+
+/// Sets a budget on mir::memory::ledger() for the duration of a test
+struct ClientBudget
+{
+    ClientBudget(size_t budget, mir::memory::BudgetAction action)
+    {
+        mir::memory::ledger().set_client_budget(
+            budget,
+            action,
+            [this](mir::memory::ClientId, size_t, size_t, bool) { ++over_budget_count; });
+    }
+
+    ~ClientBudget()
+    {
+        mir::memory::ledger().set_client_budget(0, mir::memory::BudgetAction::warn, {});
+    }
+
+    int over_budget_count{0};
+};
+
+mir::memory::ClientId const a_client{4242};
 }
 
 TEST(ShmBacking, can_get_rw_range_covering_whole_pool)
@@ -593,3 +616,96 @@ TEST(ShmBacking, resize_doesnt_install_sigbus_handler_when_safe)
     sigaction(SIGBUS, nullptr, &new_sigbus_handler);
     EXPECT_THAT(new_sigbus_handler, SignalHandlerIsEqual(initial_sigbus_handler));
 }
+
+TEST(ShmBacking, can_access_pool_large_enough_for_huge_pages)
+{
+    using namespace testing;
+
+    // Large enough that we'll hint to the kernel to use transparent huge pages
+    size_t const shm_size = 4 * 1024 * 1024;
+
+    mir::Fd shm_fd;
+    try
+    {
+        shm_fd = make_shm_fd_with_seals(shm_size, F_SEAL_SHRINK);
+    }
+    catch (std::system_error const&)
+    {
+        GTEST_SKIP();    // We can't allocate a memfd, so we can't test F_SEAL
+    }
+
+    auto backing = mir::shm::rw_pool_from_fd(shm_fd, shm_size);
+    auto range = backing->get_rw_range(0, shm_size);
+    auto map = range->map_rw();
+
+    std::byte const expected_content{0xc3};
+    ::memset(map->data(), std::to_integer<int>(expected_content), map->len());
+
+    for (auto const& a : *map)
+    {
+        EXPECT_THAT(a, Eq(expected_content));
+    }
+    EXPECT_FALSE(map->access_fault());
+}
+
+TEST(ShmBacking, creating_pool_beyond_refused_budget_throws)
+{
+    using namespace testing;
+
+    size_t const size = sysconf(_SC_PAGE_SIZE) * 2;
+    ClientBudget budget{size / 2, mir::memory::BudgetAction::refuse};
+
+    auto shm_fd = make_shm_fd(size);
+
+    EXPECT_THROW(
+        mir::shm::rw_pool_from_fd(shm_fd, size, a_client),
+        mir::shm::OverBudgetError);
+    EXPECT_THAT(budget.over_budget_count, Eq(1));
+    EXPECT_THAT(mir::memory::ledger().usage_of(a_client).total(), Eq(0u));
+}
+
+TEST(ShmBacking, resizing_pool_beyond_refused_budget_fails)
+{
+    using namespace testing;
+
+    size_t const initial_size = sysconf(_SC_PAGE_SIZE);
+    size_t const new_size = initial_size * 4;
+    ClientBudget budget{initial_size * 2, mir::memory::BudgetAction::refuse};
+
+    auto shm_fd = make_shm_fd(initial_size);
+    auto backing = mir::shm::rw_pool_from_fd(shm_fd, initial_size, a_client);
+
+    if (ftruncate(shm_fd, new_size) == -1)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to resize shm fd"}));
+    }
+    auto const result = backing->resize(new_size);
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_THAT(result.error(), Eq(mir::shm::ResizeError::over_budget));
+    EXPECT_THAT(budget.over_budget_count, Eq(1));
+    EXPECT_THAT(mir::memory::ledger().usage_of(a_client).total(), Eq(initial_size));
+    // The existing mapping is still usable
+    EXPECT_NO_THROW(backing->get_rw_range(0, initial_size)->map_rw());
+}
+
+TEST(ShmBacking, resizing_pool_beyond_warned_budget_succeeds)
+{
+    using namespace testing;
+
+    size_t const initial_size = sysconf(_SC_PAGE_SIZE);
+    size_t const new_size = initial_size * 4;
+    ClientBudget budget{initial_size * 2, mir::memory::BudgetAction::warn};
+
+    auto shm_fd = make_shm_fd(initial_size);
+    auto backing = mir::shm::rw_pool_from_fd(shm_fd, initial_size, a_client);
+
+    if (ftruncate(shm_fd, new_size) == -1)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to resize shm fd"}));
+    }
+
+    EXPECT_TRUE(backing->resize(new_size).has_value());
+    EXPECT_THAT(budget.over_budget_count, Eq(1));
+    EXPECT_THAT(mir::memory::ledger().usage_of(a_client).total(), Eq(new_size));
+}